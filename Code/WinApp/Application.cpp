@@ -12,6 +12,10 @@
 #include "Application.h"
 #include <GL/glu.h>
 #include "resource.h"
+#include "Geometries/ConformalCoefficients.h"
+#include "EvaluatorCache.h"
+#include "ScratchEnvironment.h"
+#include "FunctionRegistry.h"
 
 //=========================================================================================
 static int AllocHook(
@@ -51,6 +55,7 @@ GAVisToolApp::GAVisToolApp( void )
 	canvasFrame = 0;
 	environment = 0;
 	calculator = 0;
+	threadPool = 0;
 
 	generateLatexOutput = true;
 	latexCommandDir = "";
@@ -90,8 +95,10 @@ bool GAVisToolApp::OnInit( void )
 
 	environment = new GAVisToolEnvironment();
 	calculator = new CalcLib::Calculator( environment );
+	threadPool = new GAVisToolThreadPool();
 
 	GeometricAlgebra::MotherVector::Setup();
+	ConformalCoefficients::Setup();
 
 	// Return true here to indicate our desire to keep processing the message loop.
 	return true;
@@ -115,12 +122,19 @@ void GAVisToolApp::BuildUserInterface( void )
 //=========================================================================================
 int GAVisToolApp::OnExit( void )
 {
+	delete threadPool;
+	threadPool = 0;
+
 	delete calculator;
 	calculator = 0;
 
 	delete config;
 	config = 0;
 
+	GAVisToolFunctionRegistry::Shutdown();
+	GAVisToolEvaluatorCache::Wipe();
+	GAVisToolScratchEnvironment::Shutdown();
+	ConformalCoefficients::Shutdown();
 	GeometricAlgebra::MotherVector::Shutdown();
 
 	return wxApp::OnExit();
@@ -15,6 +15,7 @@
 #include "ConsoleFrame.h"
 #include "CanvasFrame.h"
 #include "Environment.h"
+#include "ThreadPool.h"
 #include "Calculator/CalcLib.h"
 
 //=========================================================================================
@@ -38,6 +39,7 @@ public:
 	GAVisToolCanvasFrame* canvasFrame;
 	GAVisToolEnvironment* environment;
 	CalcLib::Calculator* calculator;
+	GAVisToolThreadPool* threadPool;
 
 	void SaveWindowLayout( wxFrame* frame, const wxString& frameName );
 	void RestoreWindowLayout( wxFrame* frame, const wxString& frameName );
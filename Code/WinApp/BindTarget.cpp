@@ -20,6 +20,8 @@ GAVisToolBindTarget::GAVisToolBindTarget( BindType bindType /*= DOESNT_MATTER*/
 	this->bindType = bindType;
 	name = 0;
 	changed = false;
+	modificationCount = 0;
+	composedModificationCount = -1;
 }
 
 //=========================================================================================
@@ -75,7 +77,7 @@ const char* GAVisToolBindTarget::GetName( void ) const
 void GAVisToolBindTarget::HasChanged( bool changed )
 {
 	this->changed = changed;
-	
+
 	// If a geometry changes, then this warrants a redraw with a primitive cache regeneration.
 	if( changed && IsTypeOf( GAVisToolGeometry::ClassName() ) )
 		wxGetApp().canvasFrame->canvas->RedrawNeeded( true );
@@ -87,4 +89,43 @@ bool GAVisToolBindTarget::HasChanged( void )
 	return changed;
 }
 
+//=========================================================================================
+void GAVisToolBindTarget::Modified( void )
+{
+	modificationCount++;
+}
+
+//=========================================================================================
+int GAVisToolBindTarget::ModificationCount( void ) const
+{
+	return modificationCount;
+}
+
+//=========================================================================================
+void GAVisToolBindTarget::CachedComposeTo( GeometricAlgebra::SumOfBlades& element ) const
+{
+	if( composedModificationCount != modificationCount )
+	{
+		ComposeTo( composedElement );
+		composedModificationCount = modificationCount;
+	}
+
+	element.AssignSumOfBlades( composedElement );
+}
+
+//=========================================================================================
+GAVisToolBindTargetValue::GAVisToolBindTargetValue( const char* name )
+{
+	int len = strlen( name ) + 1;
+	this->name = new char[ len ];
+	strcpy_s( this->name, len, name );
+	written = false;
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolBindTargetValue::~GAVisToolBindTargetValue( void )
+{
+	delete[] name;
+}
+
 // BindTarget.cpp
\ No newline at end of file
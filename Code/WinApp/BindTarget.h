@@ -54,11 +54,38 @@ public:
 	void HasChanged( bool changed );
 	bool HasChanged( void );
 
+	// Composing a target can mean running a script, and bound variables are read a lot more
+	// often than they are written, so we hang on to the last composed value until the target
+	// is modified.  Whatever changes the value of a target calls Modified(), which means every
+	// override of DecomposeFrom, and of Translate, Rotate and Scale in the geometries.
+	void Modified( void );
+	int ModificationCount( void ) const;
+	void CachedComposeTo( GeometricAlgebra::SumOfBlades& element ) const;
+
 protected:
 
 	char* name;
 	BindType bindType;
 	bool changed;
+	int modificationCount;
+
+	mutable int composedModificationCount;
+	mutable GeometricAlgebra::SumOfBlades composedElement;
+};
+
+//=========================================================================================
+// This is a named copy of the value of a bind target.  We use these wherever we need to
+// work with the values of bind targets without touching the bind targets themselves.
+class GAVisToolBindTargetValue : public Utilities::List::Item
+{
+public:
+
+	GAVisToolBindTargetValue( const char* name );
+	virtual ~GAVisToolBindTargetValue( void );
+
+	char* name;
+	GeometricAlgebra::SumOfBlades multivector;
+	bool written;
 };
 
 // BindTarget.h
\ No newline at end of file
@@ -243,7 +243,7 @@ void GAVisToolCanvas::PerformSelection( void )
 	// Did we find a closest hit?
 	if( closestName != -1 )
 	{
-		GAVisToolGeometry* geometry = wxGetApp().environment->LookupGeometryByIndex( closestName );
+		GAVisToolGeometry* geometry = wxGetApp().environment->LookupGeometryByID( closestName );
 		if( geometry )
 			strcpy_s( selectedGeometry, sizeof( selectedGeometry ), geometry->GetName() );
 	}
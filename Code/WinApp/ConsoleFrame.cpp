@@ -232,6 +232,16 @@ void GAVisToolConsoleFrame::ProcessConsoleInput( const wxString& inputText )
 		consoleOutputCtrl->AppendText( "\n\n" );
 }
 
+//=========================================================================================
+void GAVisToolConsoleFrame::PrintConsoleOutput( const wxString& outputText )
+{
+	consoleOutputCtrl->AppendText( outputText );
+	consoleOutputCtrl->AppendText( "\n" );
+
+	long caretPos = consoleOutputCtrl->GetCaretPosition();
+	consoleOutputCtrl->ScrollIntoView( caretPos, WXK_PAGEDOWN );
+}
+
 //=========================================================================================
 void GAVisToolConsoleFrame::OnKeyDown( wxKeyEvent& event )
 {
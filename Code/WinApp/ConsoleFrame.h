@@ -56,6 +56,9 @@ public:
 
 	void ProcessConsoleInput( const wxString& inputText );
 
+	// Append output that wasn't the result of any console input.
+	void PrintConsoleOutput( const wxString& outputText );
+
 	wxTextCtrl* consoleInputCtrl;
 	wxRichTextCtrl* consoleOutputCtrl;		// We will want to support LaTeX output, so we will need a rich text control.
 
@@ -14,6 +14,9 @@
 
 IMPLEMENT_CALCLIB_CLASS1( GAVisToolConstraint, GAVisToolInventoryTree::Item );
 
+//=========================================================================================
+/*static*/ bool GAVisToolConstraint::profilingEnabled = false;
+
 //=========================================================================================
 GAVisToolConstraint::GAVisToolConstraint( void )
 {
@@ -24,6 +27,76 @@ GAVisToolConstraint::GAVisToolConstraint( void )
 {
 }
 
+//=========================================================================================
+void GAVisToolConstraint::ProfiledExecute( CalcLib::Environment* environment )
+{
+	if( !profilingEnabled )
+	{
+		Execute( environment );
+		return;
+	}
+
+	wxStopWatch stopWatch;
+	Execute( environment );
+	wxLongLong microseconds = stopWatch.TimeInMicro();
+	profile.Record( microseconds.ToDouble() / 1000.0 );
+}
+
+//=========================================================================================
+/*virtual*/ void GAVisToolConstraint::Describe( char* printBuffer, int printBufferSize ) const
+{
+	sprintf_s( printBuffer, printBufferSize, "Constraint %d", id );
+}
+
+//=========================================================================================
+GAVisToolConstraint::Profile::Profile( void )
+{
+	Reset();
+}
+
+//=========================================================================================
+void GAVisToolConstraint::Profile::Reset( void )
+{
+	executionCount = 0;
+	totalTime = 0.0;
+	maxTime = 0.0;
+	lastTime = 0.0;
+}
+
+//=========================================================================================
+void GAVisToolConstraint::Profile::Record( double executionTime )
+{
+	executionCount++;
+	totalTime += executionTime;
+	if( executionTime > maxTime )
+		maxTime = executionTime;
+	lastTime = executionTime;
+}
+
+//=========================================================================================
+const GAVisToolConstraint::Profile& GAVisToolConstraint::GetProfile( void ) const
+{
+	return profile;
+}
+
+//=========================================================================================
+void GAVisToolConstraint::ResetProfile( void )
+{
+	profile.Reset();
+}
+
+//=========================================================================================
+/*static*/ void GAVisToolConstraint::EnableProfiling( bool enable )
+{
+	profilingEnabled = enable;
+}
+
+//=========================================================================================
+/*static*/ bool GAVisToolConstraint::ProfilingEnabled( void )
+{
+	return profilingEnabled;
+}
+
 //=========================================================================================
 void GAVisToolConstraint::AddInput( const char* bindTargetName )
 {
@@ -67,6 +140,24 @@ void GAVisToolConstraint::MarkAllInputsAsChanged( GAVisToolEnvironment* visToolE
 	}
 }
 
+//=========================================================================================
+// Bound variables resolve to their bind targets in whatever environment we're given.
+void GAVisToolConstraint::AppendOutputValues( CalcLib::Environment* environment, Utilities::List& valueList ) const
+{
+	Utilities::Map< bool >::Iterator outputMapIter( &outputMap );
+	while( !outputMapIter.Finished() )
+	{
+		const char* bindTargetName = 0;
+		outputMapIter.CurrentEntry( &bindTargetName );
+		GAVisToolBindTargetValue* value = new GAVisToolBindTargetValue( bindTargetName );
+		CalcLib::MultivectorNumber multivectorNumber( value->multivector );
+		if( environment->LookupVariable( bindTargetName, multivectorNumber ) )
+			multivectorNumber.AssignTo( value->multivector, *environment );
+		valueList.InsertRightOf( valueList.RightMost(), value );
+		outputMapIter.Next();
+	}
+}
+
 //=========================================================================================
 bool GAVisToolConstraint::NeedsExecution( GAVisToolEnvironment* visToolEnv )
 {
@@ -76,7 +167,7 @@ bool GAVisToolConstraint::NeedsExecution( GAVisToolEnvironment* visToolEnv )
 		const char* bindTargetName = 0;
 		inputMapIter.CurrentEntry( &bindTargetName );
 		GAVisToolBindTarget* bindTarget = visToolEnv->LookupBindTargetByName( bindTargetName );
-		if( bindTarget && bindTarget->HasChanged() )
+		if( bindTarget && visToolEnv->BindTargetChangePending( bindTarget ) )
 			return true;
 		inputMapIter.Next();
 	}
@@ -155,6 +246,47 @@ void GAVisToolConstraint::AddConstraintDependencyTreeItems( wxTreeCtrl* treeCtrl
 			treeCtrl->AppendItem( inputsItem, wxString::Format( wxT( "Unknown: %s" ), bindTargetName ) );
 		outputMapIter.Next();
 	}
+
+	profileTreeItem = wxTreeItemId();
+
+	if( profilingEnabled || profile.executionCount > 0 )
+	{
+		wxString itemTextArray[ PROFILE_TREE_ITEM_COUNT ];
+		FormatProfileTreeItems( itemTextArray );
+
+		profileTreeItem = treeCtrl->AppendItem( parentItem, wxT( "Profile" ) );
+		for( int index = 0; index < PROFILE_TREE_ITEM_COUNT; index++ )
+			treeCtrl->AppendItem( profileTreeItem, itemTextArray[ index ] );
+	}
+}
+
+//=========================================================================================
+void GAVisToolConstraint::FormatProfileTreeItems( wxString* itemTextArray ) const
+{
+	itemTextArray[0] = wxString::Format( wxT( "Executions: %d" ), profile.executionCount );
+	itemTextArray[1] = wxString::Format( wxT( "Total time: %1.3f ms" ), profile.totalTime );
+	itemTextArray[2] = wxString::Format( wxT( "Max time: %1.3f ms" ), profile.maxTime );
+	itemTextArray[3] = wxString::Format( wxT( "Last time: %1.3f ms" ), profile.lastTime );
+}
+
+//=========================================================================================
+// A constraint that had no profile items when the tree was made won't get any here.
+// The tree is regenerated whenever profiling is turned on or off, so that's fine.
+void GAVisToolConstraint::RefreshProfileTreeItems( wxTreeCtrl* treeCtrl ) const
+{
+	if( !profileTreeItem.IsOk() )
+		return;
+
+	wxString itemTextArray[ PROFILE_TREE_ITEM_COUNT ];
+	FormatProfileTreeItems( itemTextArray );
+
+	wxTreeItemIdValue cookie;
+	wxTreeItemId treeItem = treeCtrl->GetFirstChild( profileTreeItem, cookie );
+	for( int index = 0; index < PROFILE_TREE_ITEM_COUNT && treeItem.IsOk(); index++ )
+	{
+		treeCtrl->SetItemText( treeItem, itemTextArray[ index ] );
+		treeItem = treeCtrl->GetNextChild( profileTreeItem, cookie );
+	}
 }
 
 // Constraint.cpp
\ No newline at end of file
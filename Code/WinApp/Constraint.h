@@ -29,7 +29,15 @@ public:
 	GAVisToolConstraint( void );
 	virtual ~GAVisToolConstraint( void );
 
-	virtual void Execute( GAVisToolEnvironment* visToolEnv ) = 0;
+	// This may be the main environment, or the snapshot environment of the solver thread.
+	virtual void Execute( CalcLib::Environment* environment ) = 0;
+
+	// Constraints are always executed through here so that they can be profiled.
+	void ProfiledExecute( CalcLib::Environment* environment );
+
+	// Give a short, human readable description of this constraint.  It is truncated
+	// if it does not fit in the given buffer.
+	virtual void Describe( char* printBuffer, int printBufferSize ) const;
 
 	virtual Utilities::List::SortComparison SortCompare( const Utilities::List::Item* compareWithItem ) const override;
 
@@ -45,6 +53,37 @@ public:
 
 	void MarkAllInputsAsChanged( GAVisToolEnvironment* visToolEnv );
 
+	// Append a copy of the current value of each of our outputs to the given list.
+	void AppendOutputValues( CalcLib::Environment* environment, Utilities::List& valueList ) const;
+
+	//=========================================================================================
+	// Times are kept in milliseconds of wall time.  These may be updated by the solver
+	// thread while the main thread reads them, but they are only ever used for display.
+	class Profile
+	{
+	public:
+
+		Profile( void );
+
+		void Reset( void );
+		void Record( double executionTime );
+
+		int executionCount;
+		double totalTime;
+		double maxTime;
+		double lastTime;
+	};
+
+	const Profile& GetProfile( void ) const;
+	void ResetProfile( void );
+
+	// Bring the profile items of the inventory tree up to date without rebuilding the tree.
+	void RefreshProfileTreeItems( wxTreeCtrl* treeCtrl ) const;
+
+	// Profiling is off by default, in which case all it costs is a branch per execution.
+	static void EnableProfiling( bool enable );
+	static bool ProfilingEnabled( void );
+
 protected:
 
 	// We keep references to our inputs and output by string.
@@ -55,6 +94,16 @@ protected:
 	Utilities::Map< bool > outputMap;
 
 	void AddConstraintDependencyTreeItems( wxTreeCtrl* treeCtrl, wxTreeItemId parentItem ) const;
+
+	enum { PROFILE_TREE_ITEM_COUNT = 4 };
+	void FormatProfileTreeItems( wxString* itemTextArray ) const;
+
+	Profile profile;
+
+	// This is only valid until the inventory tree is next regenerated, at which point it is set again.
+	mutable wxTreeItemId profileTreeItem;
+
+	static bool profilingEnabled;
 };
 
 // Constraint.h
\ No newline at end of file
@@ -0,0 +1,384 @@
+// ConstraintSchedule.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "ConstraintSchedule.h"
+#include "Constraint.h"
+#include "Environment.h"
+#include "Geometries/ConformalCoefficients.h"
+
+//=========================================================================================
+/*static*/ double GAVisToolConstraintSchedule::relaxationTolerance = 1e-6;
+/*static*/ int GAVisToolConstraintSchedule::maxRelaxationSweeps = 50;
+
+//=========================================================================================
+GAVisToolConstraintSchedule::GAVisToolConstraintSchedule( void )
+{
+	constraintArray = 0;
+	constraintCount = 0;
+	groupSizeArray = 0;
+	groupCount = 0;
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolConstraintSchedule::~GAVisToolConstraintSchedule( void )
+{
+	Clear();
+}
+
+//=========================================================================================
+void GAVisToolConstraintSchedule::Clear( void )
+{
+	delete[] constraintArray;
+	constraintArray = 0;
+	constraintCount = 0;
+
+	delete[] groupSizeArray;
+	groupSizeArray = 0;
+	groupCount = 0;
+}
+
+//=========================================================================================
+GAVisToolConstraintSchedule::Stats::Stats( void )
+{
+	Reset();
+}
+
+//=========================================================================================
+void GAVisToolConstraintSchedule::Stats::Reset( void )
+{
+	cyclicGroupCount = 0;
+	sweepCount = 0;
+	unconvergedGroupCount = 0;
+	maxResidual = 0.0;
+}
+
+//=========================================================================================
+const GAVisToolConstraintSchedule::Stats& GAVisToolConstraintSchedule::GetStats( void ) const
+{
+	return stats;
+}
+
+//=========================================================================================
+void GAVisToolConstraintSchedule::Build( Utilities::List& executionList, Utilities::List& cannotExecuteList, GAVisToolEnvironment* visToolEnv )
+{
+	Clear();
+
+	constraintCount = executionList.Count() + cannotExecuteList.Count();
+	if( constraintCount == 0 )
+		return;
+
+	constraintArray = new GAVisToolConstraint*[ constraintCount ];
+	groupSizeArray = new int[ constraintCount ];
+
+	int index = 0;
+	GAVisToolConstraint* constraint = 0;
+	for( constraint = ( GAVisToolConstraint* )executionList.LeftMost(); constraint; constraint = ( GAVisToolConstraint* )constraint->Right() )
+		constraintArray[ index++ ] = constraint;
+
+	// This is the fast path, and by far the most common case.
+	if( cannotExecuteList.Count() == 0 )
+	{
+		for( groupCount = 0; groupCount < constraintCount; groupCount++ )
+			groupSizeArray[ groupCount ] = 1;
+		return;
+	}
+
+	for( constraint = ( GAVisToolConstraint* )cannotExecuteList.LeftMost(); constraint; constraint = ( GAVisToolConstraint* )constraint->Right() )
+		constraintArray[ index++ ] = constraint;
+
+	FindStronglyConnectedComponents();
+	OrderCyclicGroups( visToolEnv );
+}
+
+//=========================================================================================
+// This is Tarjan's algorithm.  There is an edge from one constraint to another if the
+// latter depends upon the former.  Constraints are identified by their index into the
+// array we were given, which is the order we want them executed in within a group.
+class StronglyConnectedComponentFinder
+{
+public:
+
+	StronglyConnectedComponentFinder( GAVisToolConstraint** constraintArray, int constraintCount )
+	{
+		this->constraintArray = constraintArray;
+		this->constraintCount = constraintCount;
+
+		indexArray = new int[ constraintCount ];
+		lowLinkArray = new int[ constraintCount ];
+		onStackArray = new bool[ constraintCount ];
+		stackArray = new int[ constraintCount ];
+		componentArray = new int[ constraintCount ];
+		componentSizeArray = new int[ constraintCount ];
+
+		for( int vertex = 0; vertex < constraintCount; vertex++ )
+		{
+			indexArray[ vertex ] = -1;
+			onStackArray[ vertex ] = false;
+		}
+
+		stackSize = 0;
+		nextIndex = 0;
+		componentWriteIndex = constraintCount;
+		componentCount = 0;
+	}
+
+	~StronglyConnectedComponentFinder( void )
+	{
+		delete[] indexArray;
+		delete[] lowLinkArray;
+		delete[] onStackArray;
+		delete[] stackArray;
+		delete[] componentArray;
+		delete[] componentSizeArray;
+	}
+
+	// The components are found in reverse topological order, so we fill in the
+	// component array from the back and reverse the list of component sizes.
+	void Find( GAVisToolConstraint** sortedConstraintArray, int* groupSizeArray, int& groupCount )
+	{
+		for( int vertex = 0; vertex < constraintCount; vertex++ )
+			if( indexArray[ vertex ] < 0 )
+				StrongConnect( vertex );
+
+		for( int index = 0; index < constraintCount; index++ )
+			sortedConstraintArray[ index ] = constraintArray[ componentArray[ index ] ];
+
+		groupCount = componentCount;
+		for( int index = 0; index < componentCount; index++ )
+			groupSizeArray[ index ] = componentSizeArray[ componentCount - 1 - index ];
+	}
+
+private:
+
+	void StrongConnect( int vertex )
+	{
+		indexArray[ vertex ] = nextIndex;
+		lowLinkArray[ vertex ] = nextIndex;
+		nextIndex++;
+		stackArray[ stackSize++ ] = vertex;
+		onStackArray[ vertex ] = true;
+
+		for( int adjacentVertex = 0; adjacentVertex < constraintCount; adjacentVertex++ )
+		{
+			if( adjacentVertex == vertex || !constraintArray[ adjacentVertex ]->DependsUpon( constraintArray[ vertex ] ) )
+				continue;
+
+			if( indexArray[ adjacentVertex ] < 0 )
+			{
+				StrongConnect( adjacentVertex );
+				if( lowLinkArray[ adjacentVertex ] < lowLinkArray[ vertex ] )
+					lowLinkArray[ vertex ] = lowLinkArray[ adjacentVertex ];
+			}
+			else if( onStackArray[ adjacentVertex ] && indexArray[ adjacentVertex ] < lowLinkArray[ vertex ] )
+				lowLinkArray[ vertex ] = indexArray[ adjacentVertex ];
+		}
+
+		if( lowLinkArray[ vertex ] != indexArray[ vertex ] )
+			return;
+
+		// The component is everything on the stack from the given vertex up.
+		int bottom = stackSize - 1;
+		while( stackArray[ bottom ] != vertex )
+			bottom--;
+
+		// Keep the members of the component in their original order.
+		for( int i = bottom + 1; i < stackSize; i++ )
+		{
+			int member = stackArray[i];
+			int j = i - 1;
+			while( j >= bottom && stackArray[j] > member )
+			{
+				stackArray[ j + 1 ] = stackArray[j];
+				j--;
+			}
+			stackArray[ j + 1 ] = member;
+		}
+
+		int componentSize = stackSize - bottom;
+		componentWriteIndex -= componentSize;
+		for( int i = 0; i < componentSize; i++ )
+		{
+			int member = stackArray[ bottom + i ];
+			onStackArray[ member ] = false;
+			componentArray[ componentWriteIndex + i ] = member;
+		}
+
+		componentSizeArray[ componentCount++ ] = componentSize;
+		stackSize = bottom;
+	}
+
+	GAVisToolConstraint** constraintArray;
+	int constraintCount;
+
+	int* indexArray;
+	int* lowLinkArray;
+	bool* onStackArray;
+	int* stackArray;
+	int stackSize;
+	int nextIndex;
+
+	int* componentArray;
+	int componentWriteIndex;
+	int* componentSizeArray;
+	int componentCount;
+};
+
+//=========================================================================================
+void GAVisToolConstraintSchedule::FindStronglyConnectedComponents( void )
+{
+	GAVisToolConstraint** sortedConstraintArray = new GAVisToolConstraint*[ constraintCount ];
+
+	StronglyConnectedComponentFinder finder( constraintArray, constraintCount );
+	finder.Find( sortedConstraintArray, groupSizeArray, groupCount );
+
+	delete[] constraintArray;
+	constraintArray = sortedConstraintArray;
+}
+
+//=========================================================================================
+// Within each cyclic group, move the constraints that read a changed bind target to the
+// front, keeping the order of those that do and of those that don't.  Had a group of
+// a=2b and b=a/2 started with a=2b after the user dragged a, the drag would be lost.
+void GAVisToolConstraintSchedule::OrderCyclicGroups( GAVisToolEnvironment* visToolEnv )
+{
+	GAVisToolConstraint** otherArray = new GAVisToolConstraint*[ constraintCount ];
+
+	int index = 0;
+	for( int group = 0; group < groupCount; group++ )
+	{
+		int groupSize = groupSizeArray[ group ];
+		if( groupSize > 1 )
+		{
+			GAVisToolConstraint** groupArray = &constraintArray[ index ];
+			int triggeredCount = 0;
+			int otherCount = 0;
+			for( int member = 0; member < groupSize; member++ )
+			{
+				GAVisToolConstraint* constraint = groupArray[ member ];
+				if( constraint->NeedsExecution( visToolEnv ) )
+					groupArray[ triggeredCount++ ] = constraint;
+				else
+					otherArray[ otherCount++ ] = constraint;
+			}
+
+			for( int member = 0; member < otherCount; member++ )
+				groupArray[ triggeredCount + member ] = otherArray[ member ];
+		}
+
+		index += groupSize;
+	}
+
+	delete[] otherArray;
+}
+
+//=========================================================================================
+bool GAVisToolConstraintSchedule::Execute( CalcLib::Environment* environment, Monitor* monitor /*= 0*/ )
+{
+	stats.Reset();
+
+	int index = 0;
+	for( int group = 0; group < groupCount; group++ )
+	{
+		if( monitor && monitor->ShouldAbandon() )
+			return false;
+
+		int groupSize = groupSizeArray[ group ];
+		if( groupSize == 1 )
+			constraintArray[ index ]->ProfiledExecute( environment );
+		else if( !RelaxCyclicGroup( &constraintArray[ index ], groupSize, environment, monitor ) )
+			return false;
+
+		index += groupSize;
+	}
+
+	return true;
+}
+
+//=========================================================================================
+bool GAVisToolConstraintSchedule::RelaxCyclicGroup( GAVisToolConstraint** groupArray, int groupSize, CalcLib::Environment* environment, Monitor* monitor )
+{
+	stats.cyclicGroupCount++;
+
+	Utilities::List previousValueList, currentValueList;
+	int index;
+
+	for( index = 0; index < groupSize; index++ )
+		groupArray[ index ]->AppendOutputValues( environment, previousValueList );
+
+	bool abandoned = false;
+	bool converged = false;
+	double residual = 0.0;
+
+	for( int sweep = 0; sweep < maxRelaxationSweeps && !converged; sweep++ )
+	{
+		if( monitor && monitor->ShouldAbandon() )
+		{
+			abandoned = true;
+			break;
+		}
+
+		for( index = 0; index < groupSize; index++ )
+			groupArray[ index ]->ProfiledExecute( environment );
+
+		stats.sweepCount++;
+
+		for( index = 0; index < groupSize; index++ )
+			groupArray[ index ]->AppendOutputValues( environment, currentValueList );
+
+		residual = CalculateResidual( previousValueList, currentValueList );
+		if( residual <= relaxationTolerance )
+			converged = true;
+
+		previousValueList.RemoveAll( true );
+		currentValueList.EmptyIntoOnRight( previousValueList );
+	}
+
+	previousValueList.RemoveAll( true );
+
+	if( abandoned )
+		return false;
+
+	if( !converged )
+		stats.unconvergedGroupCount++;
+	if( residual > stats.maxResidual )
+		stats.maxResidual = residual;
+
+	return true;
+}
+
+//=========================================================================================
+// Both lists are made the same way, so their values correspond one-to-one.
+/*static*/ double GAVisToolConstraintSchedule::CalculateResidual( const Utilities::List& previousValueList, const Utilities::List& currentValueList )
+{
+	double residual = 0.0;
+
+	const GAVisToolBindTargetValue* previousValue = ( const GAVisToolBindTargetValue* )previousValueList.LeftMost();
+	const GAVisToolBindTargetValue* currentValue = ( const GAVisToolBindTargetValue* )currentValueList.LeftMost();
+	while( previousValue && currentValue )
+	{
+		// We can't measure the change with the conformal metric, because the difference of two
+		// points on the same null cone, for example, can have zero magnitude.
+		ConformalCoefficients previousCoefficients, currentCoefficients;
+		if( previousCoefficients.AssignFrom( previousValue->multivector ) && currentCoefficients.AssignFrom( currentValue->multivector ) )
+		{
+			double change = currentCoefficients.EuclideanDistance( previousCoefficients );
+			if( change > residual )
+				residual = change;
+		}
+
+		previousValue = ( const GAVisToolBindTargetValue* )previousValue->Right();
+		currentValue = ( const GAVisToolBindTargetValue* )currentValue->Right();
+	}
+
+	return residual;
+}
+
+// ConstraintSchedule.cpp
\ No newline at end of file
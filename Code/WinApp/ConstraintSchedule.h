@@ -0,0 +1,93 @@
+// ConstraintSchedule.h
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#pragma once
+
+#include "Calculator/CalcLib.h"
+
+// TODO: Headers need clean-up.
+class GAVisToolConstraint;
+class GAVisToolEnvironment;
+
+//=========================================================================================
+// A schedule is the order in which a set of constraints is to be executed, partitioned
+// into groups.  A group of one constraint is simply executed once.  A group of more than
+// one constraint is a cycle in the constraint graph, which we satisfy by Gauss-Seidel
+// relaxation: we sweep over the group, each constraint seeing the outputs of the ones
+// before it, until the outputs of the group stop changing.  Each sweep starts with the
+// constraints that read a changed bind target, so that the change propagates through
+// the cycle instead of being overwritten from the stale values of the other targets.
+class GAVisToolConstraintSchedule
+{
+public:
+
+	GAVisToolConstraintSchedule( void );
+	virtual ~GAVisToolConstraintSchedule( void );
+
+	//=========================================================================================
+	class Stats
+	{
+	public:
+
+		Stats( void );
+
+		void Reset( void );
+
+		int cyclicGroupCount;
+		int sweepCount;
+		int unconvergedGroupCount;
+		double maxResidual;
+	};
+
+	//=========================================================================================
+	// This lets whoever is executing the schedule bail out of it part way through.
+	class Monitor
+	{
+	public:
+
+		virtual bool ShouldAbandon( void ) = 0;
+	};
+
+	// The given lists are those produced by the environment's schedualing algorithm.
+	// The execution list is already in a valid order.  If the other list is empty, then
+	// there are no cycles, and we take the execution list as is.  Otherwise, the given
+	// environment tells us which bind targets changed.
+	void Build( Utilities::List& executionList, Utilities::List& cannotExecuteList, GAVisToolEnvironment* visToolEnv );
+
+	// Return false if the monitor had us abandon the schedule.
+	bool Execute( CalcLib::Environment* environment, Monitor* monitor = 0 );
+
+	const Stats& GetStats( void ) const;
+
+	// A cyclic group has converged once no output changes by more than
+	// this much from one sweep to the next.
+	static double relaxationTolerance;
+	static int maxRelaxationSweeps;
+
+	GAVisToolConstraint** constraintArray;
+	int constraintCount;
+
+	// Groups are consecutive runs of the constraint array.
+	int* groupSizeArray;
+	int groupCount;
+
+private:
+
+	void Clear( void );
+	void FindStronglyConnectedComponents( void );
+	void OrderCyclicGroups( GAVisToolEnvironment* visToolEnv );
+	bool RelaxCyclicGroup( GAVisToolConstraint** groupArray, int groupSize, CalcLib::Environment* environment, Monitor* monitor );
+	static double CalculateResidual( const Utilities::List& previousValueList, const Utilities::List& currentValueList );
+
+	Stats stats;
+};
+
+// ConstraintSchedule.h
\ No newline at end of file
@@ -0,0 +1,273 @@
+// ConstraintSolver.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "ConstraintSolver.h"
+#include "Constraint.h"
+
+//=========================================================================================
+GAVisToolConstraintSolverJob::GAVisToolConstraintSolverJob( void )
+{
+	generation = 0;
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolConstraintSolverJob::~GAVisToolConstraintSolverJob( void )
+{
+	valueList.RemoveAll( true );
+}
+
+//=========================================================================================
+bool GAVisToolConstraintSolverJob::SnapshotBindTarget( const GAVisToolBindTarget* bindTarget )
+{
+	GAVisToolBindTargetValue* value = new GAVisToolBindTargetValue( bindTarget->GetName() );
+	bindTarget->CachedComposeTo( value->multivector );
+	valueList.InsertRightOf( valueList.RightMost(), value );
+	valueMap.Insert( value->name, value );
+	return true;
+}
+
+//=========================================================================================
+GAVisToolBindTargetValue* GAVisToolConstraintSolverJob::FindValue( const char* name )
+{
+	GAVisToolBindTargetValue* value = 0;
+	if( !valueMap.Lookup( name, &value ) )
+		return 0;
+	return value;
+}
+
+//=========================================================================================
+IMPLEMENT_CALCLIB_CLASS1( GAVisToolSnapshotEnvironment, GeometricAlgebraEnvironment );
+
+//=========================================================================================
+GAVisToolSnapshotEnvironment::GAVisToolSnapshotEnvironment( GAVisToolEnvironment* mainEnvironment )
+{
+	this->mainEnvironment = mainEnvironment;
+	job = 0;
+	printBuffer[0] = '\0';
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolSnapshotEnvironment::~GAVisToolSnapshotEnvironment( void )
+{
+}
+
+//=========================================================================================
+/*virtual*/ bool GAVisToolSnapshotEnvironment::LookupVariable( const char* variableName, CalcLib::Number& variableValue )
+{
+	if( job && variableValue.IsTypeOf( CalcLib::MultivectorNumber::ClassName() ) )
+	{
+		GAVisToolBindTargetValue* value = job->FindValue( variableName );
+		if( value )
+		{
+			CalcLib::MultivectorNumber* multivectorNumber = ( CalcLib::MultivectorNumber* )&variableValue;
+			if( !multivectorNumber->AssignFrom( value->multivector, *this ) )
+				return false;
+
+			return true;
+		}
+	}
+
+	// Variables that aren't bound to anything still live in the main environment.
+	return mainEnvironment->LookupUnboundVariable( variableName, variableValue );
+}
+
+//=========================================================================================
+/*virtual*/ bool GAVisToolSnapshotEnvironment::StoreVariable( const char* variableName, const CalcLib::Number& variableValue )
+{
+	if( job && variableValue.IsTypeOf( CalcLib::MultivectorNumber::ClassName() ) )
+	{
+		GAVisToolBindTargetValue* value = job->FindValue( variableName );
+		if( value )
+		{
+			CalcLib::MultivectorNumber* multivectorNumber = ( CalcLib::MultivectorNumber* )&variableValue;
+			if( !multivectorNumber->AssignTo( value->multivector, *this ) )
+				return false;
+
+			value->written = true;
+			return true;
+		}
+	}
+
+	// Constraints should only ever write to their outputs, but if a formula
+	// stores some intermediate result, keep it local to the solver.
+	return GeometricAlgebraEnvironment::StoreVariable( variableName, variableValue );
+}
+
+//=========================================================================================
+void GAVisToolSnapshotEnvironment::BeginJob( GAVisToolConstraintSolverJob* job )
+{
+	this->job = job;
+
+	printBuffer[0] = '\0';
+	PrintBuffer( printBuffer, sizeof( printBuffer ) );
+}
+
+//=========================================================================================
+// Errors are otherwise only reported by the calculator, which never sees this environment,
+// so they would pile up here unseen.
+void GAVisToolSnapshotEnvironment::EndJob( void )
+{
+	PrintErrorReport();
+
+	job->consoleOutput = printBuffer;
+	job = 0;
+}
+
+//=========================================================================================
+GAVisToolConstraintSolver::GAVisToolConstraintSolver( GAVisToolEnvironment* mainEnvironment ) : wxThread( wxTHREAD_JOINABLE ), snapshotEnvironment( mainEnvironment )
+{
+	pendingJob = 0;
+	finishedJob = 0;
+	executingJob = 0;
+	latestGeneration = 0;
+	shutdown = false;
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolConstraintSolver::~GAVisToolConstraintSolver( void )
+{
+	delete pendingJob;
+	delete finishedJob;
+}
+
+//=========================================================================================
+void GAVisToolConstraintSolver::Dispatch( GAVisToolConstraintSolverJob* job )
+{
+	wxCriticalSectionLocker locker( criticalSection );
+
+	// Anything not yet published is now obsolete.
+	job->generation = ++latestGeneration;
+	delete pendingJob;
+	pendingJob = job;
+	delete finishedJob;
+	finishedJob = 0;
+
+	jobSemaphore.Post();
+}
+
+//=========================================================================================
+GAVisToolConstraintSolverJob* GAVisToolConstraintSolver::TakeFinishedJob( void )
+{
+	wxCriticalSectionLocker locker( criticalSection );
+
+	GAVisToolConstraintSolverJob* job = finishedJob;
+	finishedJob = 0;
+	return job;
+}
+
+//=========================================================================================
+// Return true if work was thrown away.  The caller must wait for the solver if the
+// constraints referenced by the job in progress are about to be changed or deleted.
+bool GAVisToolConstraintSolver::Cancel( bool waitForSolver )
+{
+	bool workDiscarded = false;
+
+	{
+		wxCriticalSectionLocker locker( criticalSection );
+
+		workDiscarded = ( pendingJob || finishedJob || executionMutex.TryLock() == wxMUTEX_BUSY );
+		if( !workDiscarded )
+			executionMutex.Unlock();
+
+		latestGeneration++;
+		delete pendingJob;
+		pendingJob = 0;
+		delete finishedJob;
+		finishedJob = 0;
+	}
+
+	// The solver holds the execution mutex until it lets go of its job.
+	if( waitForSolver )
+	{
+		executionMutex.Lock();
+		executionMutex.Unlock();
+	}
+
+	return workDiscarded;
+}
+
+//=========================================================================================
+void GAVisToolConstraintSolver::Shutdown( void )
+{
+	{
+		wxCriticalSectionLocker locker( criticalSection );
+
+		shutdown = true;
+		latestGeneration++;
+	}
+
+	jobSemaphore.Post();
+	Wait();
+}
+
+//=========================================================================================
+bool GAVisToolConstraintSolver::IsObsolete( const GAVisToolConstraintSolverJob* job )
+{
+	wxCriticalSectionLocker locker( criticalSection );
+
+	return( shutdown || job->generation != latestGeneration );
+}
+
+//=========================================================================================
+// This is called by the schedule we're executing between constraints.
+/*virtual*/ bool GAVisToolConstraintSolver::ShouldAbandon( void )
+{
+	return IsObsolete( executingJob );
+}
+
+//=========================================================================================
+/*virtual*/ wxThread::ExitCode GAVisToolConstraintSolver::Entry( void )
+{
+	while( true )
+	{
+		jobSemaphore.Wait();
+
+		wxMutexLocker executionLocker( executionMutex );
+
+		GAVisToolConstraintSolverJob* job = 0;
+
+		{
+			wxCriticalSectionLocker locker( criticalSection );
+
+			if( shutdown )
+				break;
+
+			job = pendingJob;
+			pendingJob = 0;
+		}
+
+		// The semaphore may have been posted for a job that was since replaced.
+		if( !job )
+			continue;
+
+		snapshotEnvironment.BeginJob( job );
+		executingJob = job;
+
+		bool cancelled = !job->Execute( &snapshotEnvironment, this );
+
+		executingJob = 0;
+		snapshotEnvironment.EndJob();
+
+		wxCriticalSectionLocker locker( criticalSection );
+
+		if( cancelled || shutdown || job->generation != latestGeneration )
+			delete job;
+		else
+		{
+			delete finishedJob;
+			finishedJob = job;
+		}
+	}
+
+	return 0;
+}
+
+// ConstraintSolver.cpp
\ No newline at end of file
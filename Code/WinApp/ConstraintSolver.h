@@ -0,0 +1,119 @@
+// ConstraintSolver.h
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#pragma once
+
+#include "Calculator/CalcLib.h"
+#include "Environment.h"
+#include "wxAll.h"
+
+// TODO: Headers need clean-up.
+class GAVisToolConstraint;
+class GAVisToolConstraintSolver;
+
+//=========================================================================================
+// A job is everything the solver thread needs to satisfy a schedule of constraints
+// without ever touching the bind targets of the main environment.  The values of all bind
+// targets are snapshot into the job when it is dispatched, and the constraints read and
+// write that snapshot.  Once finished, the written values are what get published back to
+// the bind targets on the main thread.
+class GAVisToolConstraintSolverJob : public GAVisToolConstraintSchedule
+{
+public:
+
+	GAVisToolConstraintSolverJob( void );
+	virtual ~GAVisToolConstraintSolverJob( void );
+
+	bool SnapshotBindTarget( const GAVisToolBindTarget* bindTarget );
+	GAVisToolBindTargetValue* FindValue( const char* name );
+
+	int generation;
+
+	Utilities::List valueList;
+	Utilities::Map< GAVisToolBindTargetValue* > valueMap;
+
+	// Whatever the constraints printed, including any errors, while the job executed.
+	// Nothing on the solver thread can write to the console, so this is shown when
+	// the job is published.
+	wxString consoleOutput;
+};
+
+//=========================================================================================
+// This is the environment in which the solver thread executes constraints.  Bound variables
+// resolve to the snapshot of the job being executed, while all other variables are still
+// pulled from the main environment.  None of the bind target or inventory machinery of the
+// main environment is needed here, so this is just a geometric algebra environment.
+class GAVisToolSnapshotEnvironment : public CalcLib::GeometricAlgebraEnvironment
+{
+	DECLARE_CALCLIB_CLASS( GAVisToolSnapshotEnvironment );
+
+public:
+
+	GAVisToolSnapshotEnvironment( GAVisToolEnvironment* mainEnvironment );
+	virtual ~GAVisToolSnapshotEnvironment( void );
+
+	virtual bool LookupVariable( const char* variableName, CalcLib::Number& variableValue ) override;
+	virtual bool StoreVariable( const char* variableName, const CalcLib::Number& variableValue ) override;
+
+	// The given job is executed with all output going to its console output.
+	void BeginJob( GAVisToolConstraintSolverJob* job );
+	void EndJob( void );
+
+private:
+
+	GAVisToolConstraintSolverJob* job;
+	GAVisToolEnvironment* mainEnvironment;
+	char printBuffer[ PRINT_BUFFER_SIZE_LARGE ];
+};
+
+//=========================================================================================
+// The solver thread only ever works on the most recently dispatched job.  Dispatching a
+// new job makes any job in progress obsolete, and the solver abandons an obsolete job at
+// the next constraint boundary, or the next relaxation sweep of a cyclic group.  We can't
+// interrupt a constraint in the middle of its execution, but a single constraint is rarely
+// what makes a solve long.
+class GAVisToolConstraintSolver : public wxThread, public GAVisToolConstraintSchedule::Monitor
+{
+public:
+
+	GAVisToolConstraintSolver( GAVisToolEnvironment* mainEnvironment );
+	virtual ~GAVisToolConstraintSolver( void );
+
+	// These are all called from the main thread.  The solver takes ownership of
+	// a dispatched job, and the caller takes ownership of a finished job.
+	void Dispatch( GAVisToolConstraintSolverJob* job );
+	GAVisToolConstraintSolverJob* TakeFinishedJob( void );
+	bool Cancel( bool waitForSolver );
+	void Shutdown( void );
+
+private:
+
+	virtual ExitCode Entry( void ) override;
+	virtual bool ShouldAbandon( void ) override;
+
+	bool IsObsolete( const GAVisToolConstraintSolverJob* job );
+
+	GAVisToolSnapshotEnvironment snapshotEnvironment;
+
+	// This protects everything below it.
+	wxCriticalSection criticalSection;
+	GAVisToolConstraintSolverJob* pendingJob;
+	GAVisToolConstraintSolverJob* finishedJob;
+	int latestGeneration;
+	bool shutdown;
+
+	// This is held by the solver thread for as long as it is executing a job.
+	wxMutex executionMutex;
+	GAVisToolConstraintSolverJob* executingJob;
+	wxSemaphore jobSemaphore;
+};
+
+// ConstraintSolver.h
\ No newline at end of file
@@ -111,21 +111,35 @@ bool FormulatedConstraint::SetFormula( const char* formula, GAVisToolEnvironment
 }
 
 //=========================================================================================
-/*virtual*/ void FormulatedConstraint::Execute( GAVisToolEnvironment* visToolEnv )
+/*virtual*/ void FormulatedConstraint::Execute( CalcLib::Environment* environment )
 {
 	if( evaluationTreeRoot )
 	{
-		CalcLib::Environment* environment = visToolEnv;
 		CalcLib::Number* result = environment->CreateNumber( evaluationTreeRoot );
-		evaluationTreeRoot->EvaluateResult( *result, *visToolEnv );
+		evaluationTreeRoot->EvaluateResult( *result, *environment );
 		delete result;
 	}
 }
 
+//=========================================================================================
+// Formulas can be arbitrarily long, so the description is cut short to fit the buffer.
+/*virtual*/ void FormulatedConstraint::Describe( char* printBuffer, int printBufferSize ) const
+{
+	// We only have a formula once one has been successfully set.
+	if( !formula )
+	{
+		GAVisToolConstraint::Describe( printBuffer, printBufferSize );
+		return;
+	}
+
+	_snprintf_s( printBuffer, printBufferSize, _TRUNCATE, "Formula: %s", formula );
+}
+
 //=========================================================================================
 /*virtual*/ void FormulatedConstraint::AddInventoryTreeItem( wxTreeCtrl* treeCtrl, wxTreeItemId parentItem ) const
 {
-	wxTreeItemId constraintItem = treeCtrl->AppendItem( parentItem, wxString::Format( wxT( "Formula: %s" ), formula ), -1, -1, new GAVisToolInventoryTree::Data( id ) );
+	wxString itemText = formula ? wxString::Format( wxT( "Formula: %s" ), formula ) : wxString::Format( wxT( "Constraint %d" ), id );
+	wxTreeItemId constraintItem = treeCtrl->AppendItem( parentItem, itemText, -1, -1, new GAVisToolInventoryTree::Data( id ) );
 	AddConstraintDependencyTreeItems( treeCtrl, constraintItem );
 }
 
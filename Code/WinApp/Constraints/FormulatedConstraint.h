@@ -26,7 +26,8 @@ public:
 
 	bool SetFormula( const char* formula, GAVisToolEnvironment* visToolEnv );
 
-	virtual void Execute( GAVisToolEnvironment* visToolEnv ) override;
+	virtual void Execute( CalcLib::Environment* environment ) override;
+	virtual void Describe( char* printBuffer, int printBufferSize ) const override;
 
 	virtual void AddInventoryTreeItem( wxTreeCtrl* treeCtrl, wxTreeItemId parentItem ) const override;
 
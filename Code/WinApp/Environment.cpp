@@ -10,26 +10,9 @@
  */
 
 #include "Environment.h"
-#include "Functions/BindFunction.h"
-#include "Functions/ColorFunction.h"
-#include "Functions/DumpInfoFunction.h"
-#include "Functions/WipeEnvFunction.h"
-#include "Functions/FormulatedConstraintFunction.h"
-#include "Functions/ReduceBivectorFunction.h"
-#include "Functions/VectorToFromBivectorFunction.h"
-#include "Functions/PointFunction.h"
+#include "FunctionRegistry.h"
 #include "Application.h"
-#include "Geometries/RoundGeometry.h"
-#include "Geometries/FlatGeometry.h"
-#include "Geometries/TransformGeometry.h"
-#include "Geometries/PositionVectorGeometry.h"
-#include "Geometries/ProjectiveGeometry.h"
-#include "Geometries/QuadricGeometry.h"
-#include "Geometries/ConformalQuarticGeometry.h"
-#include "Geometries/PointSampledGeometry.h"
-#include "Geometries/PointCloudGeometry.h"
-#include "Interfaces/ScalarInterface.h"
-#include "VirtualBindTarget.h"
+#include "ConstraintSolver.h"
 #include "wxAll.h"
 
 //=========================================================================================
@@ -39,12 +22,51 @@ IMPLEMENT_CALCLIB_CLASS1( GAVisToolEnvironment, GeometricAlgebraEnvironment );
 GAVisToolEnvironment::GAVisToolEnvironment( void )
 {
 	wipingEnvironment = false;
+
+	drawOrderArray = 0;
+	drawOrderCount = 0;
+	drawOrderMembershipChanged = true;
+
+	constraintSolver = 0;
+	asyncConstraintSolving = false;
+	asyncSolveInFlight = false;
+	asyncSolveNeeded = false;
+	pendingChangeMap = 0;
+
+	bindTargetSlotList = 0;
+	bindTargetSlotMap = 0;
+
+	batchDepth = 0;
+	batchRegenerationNeeded = false;
+	batchSatisfactionNeeded = false;
+	batchAddCount = 0;
+	batchRemoveCount = 0;
 }
 
 //=========================================================================================
 /*virtual*/ GAVisToolEnvironment::~GAVisToolEnvironment( void )
 {
+	if( constraintSolver )
+	{
+		constraintSolver->Shutdown();
+		delete constraintSolver;
+		constraintSolver = 0;
+	}
+
 	Wipe( false, false );
+
+	delete[] drawOrderArray;
+}
+
+//=========================================================================================
+GAVisToolEnvironment::BindTargetSlot::BindTargetSlot( void )
+{
+	bindTarget = 0;
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolEnvironment::BindTargetSlot::~BindTargetSlot( void )
+{
 }
 
 //=========================================================================================
@@ -54,76 +76,13 @@ GAVisToolEnvironment::GAVisToolEnvironment( void )
 }
 
 //=========================================================================================
+// Our functions register themselves with the function registry.  Anything else may be
+// one of the functions every geometric algebra environment knows about.
 /*virtual*/ CalcLib::FunctionEvaluator* GAVisToolEnvironment::CreateFunction( const char* functionName )
 {
-	if( 0 == strcmp( functionName, "unbind" ) )
-		return new GAVisToolBindFunctionEvaluator( 0, GAVisToolBindTarget::DOESNT_MATTER );
-	else if( 0 == strcmp( functionName, "bind_virtual" ) )
-		return new GAVisToolBindFunctionEvaluator( &GAVisToolVirtualBindTarget::Create, GAVisToolBindTarget::DOESNT_MATTER );
-	else if( 0 == strcmp( functionName, "bind_posvec" ) )
-		return new GAVisToolBindFunctionEvaluator( &PositionVector::Create, GAVisToolBindTarget::DOESNT_MATTER );
-	else if( 0 == strcmp( functionName, "bind_point" ) )
-		return new GAVisToolBindFunctionEvaluator( &ConformalPoint::Create, GAVisToolBindTarget::NORMAL_FORM );
-	else if( 0 == strcmp( functionName, "bind_dual_point" ) )
-		return new GAVisToolBindFunctionEvaluator( &ConformalPoint::Create, GAVisToolBindTarget::DUAL_FORM );
-	else if( 0 == strcmp( functionName, "bind_sphere" ) )
-		return new GAVisToolBindFunctionEvaluator( &ConformalSphere::Create, GAVisToolBindTarget::NORMAL_FORM );
-	else if( 0 == strcmp( functionName, "bind_dual_sphere" ) )
-		return new GAVisToolBindFunctionEvaluator( &ConformalSphere::Create, GAVisToolBindTarget::DUAL_FORM );
-	else if( 0 == strcmp( functionName, "bind_circle" ) )
-		return new GAVisToolBindFunctionEvaluator( &ConformalCircle::Create, GAVisToolBindTarget::NORMAL_FORM );
-	else if( 0 == strcmp( functionName, "bind_dual_circle" ) )
-		return new GAVisToolBindFunctionEvaluator( &ConformalCircle::Create, GAVisToolBindTarget::DUAL_FORM );
-	else if( 0 == strcmp( functionName, "bind_pointpair" ) )
-		return new GAVisToolBindFunctionEvaluator( &ConformalPointPair::Create, GAVisToolBindTarget::NORMAL_FORM );
-	else if( 0 == strcmp( functionName, "bind_dual_pointpair" ) )
-		return new GAVisToolBindFunctionEvaluator( &ConformalPointPair::Create, GAVisToolBindTarget::DUAL_FORM );
-	else if( 0 == strcmp( functionName, "bind_flatpoint" ) )
-		return new GAVisToolBindFunctionEvaluator( &ConformalFlatPoint::Create, GAVisToolBindTarget::NORMAL_FORM );
-	else if( 0 == strcmp( functionName, "bind_dual_flatpoint" ) )
-		return new GAVisToolBindFunctionEvaluator( &ConformalFlatPoint::Create, GAVisToolBindTarget::DUAL_FORM );
-	else if( 0 == strcmp( functionName, "bind_line" ) )
-		return new GAVisToolBindFunctionEvaluator( &ConformalLine::Create, GAVisToolBindTarget::NORMAL_FORM );
-	else if( 0 == strcmp( functionName, "bind_dual_line" ) )
-		return new GAVisToolBindFunctionEvaluator( &ConformalLine::Create, GAVisToolBindTarget::DUAL_FORM );
-	else if( 0 == strcmp( functionName, "bind_plane" ) )
-		return new GAVisToolBindFunctionEvaluator( &ConformalPlane::Create, GAVisToolBindTarget::NORMAL_FORM );
-	else if( 0 == strcmp( functionName, "bind_dual_plane" ) )
-		return new GAVisToolBindFunctionEvaluator( &ConformalPlane::Create, GAVisToolBindTarget::DUAL_FORM );
-	else if( 0 == strcmp( functionName, "bind_transform" ) )
-		return new GAVisToolBindFunctionEvaluator( &ConformalTransformGeometry::Create, GAVisToolBindTarget::DOESNT_MATTER );
-	else if( 0 == strcmp( functionName, "bind_scalar_iface" ) )
-		return new GAVisToolBindFunctionEvaluator( &ScalarInterface::Create, GAVisToolBindTarget::DOESNT_MATTER );
-	else if( 0 == strcmp( functionName, "bind_psg" ) )
-		return new GAVisToolBindFunctionEvaluator( &PointSampledGeometry::Create, GAVisToolBindTarget::DOESNT_MATTER );
-	else if( 0 == strcmp( functionName, "geo_color" ) )
-		return new GAVisToolColorFunctionEvaluator();
-	else if( 0 == strcmp( functionName, "formula_constraint" ) )
-		return new GAVisToolFormulatedConstraintFunctionEvaluator();
-	else if( 0 == strcmp( functionName, "dump_info" ) )
-		return new GAVisToolDumpInfoFunctionEvaluator();
-	else if( 0 == strcmp( functionName, "wipe_env" ) )
-		return new GAVisToolWipeEnvFunctionEvaluator();
-	else if( 0 == strcmp( functionName, "bind_proj_point" ) )
-		return new GAVisToolBindFunctionEvaluator( &ProjectivePoint::Create, GAVisToolBindTarget::DOESNT_MATTER );
-	else if( 0 == strcmp( functionName, "bind_proj_line" ) )
-		return new GAVisToolBindFunctionEvaluator( &ProjectiveLine::Create, GAVisToolBindTarget::DOESNT_MATTER );
-	else if( 0 == strcmp( functionName, "bind_proj_plane" ) )
-		return new GAVisToolBindFunctionEvaluator( &ProjectivePlane::Create, GAVisToolBindTarget::DOESNT_MATTER );
-	else if( 0 == strcmp( functionName, "bind_quadric" ) )
-		return new GAVisToolBindFunctionEvaluator( &QuadricGeometry::Create, GAVisToolBindTarget::DOESNT_MATTER );
-	else if( 0 == strcmp( functionName, "bind_conformal_quartic" ) )
-		return new GAVisToolBindFunctionEvaluator( &ConformalQuarticGeometry::Create, GAVisToolBindTarget::DOESNT_MATTER );
-	else if( 0 == strcmp( functionName, "bind_pt_cloud" ) )
-		return new GAVisToolBindFunctionEvaluator( &PointCloudGeometry::Create, GAVisToolBindTarget::DOESNT_MATTER );
-	else if( 0 == strcmp( functionName, "reduce_bivector" ) )
-		return new GAVisToolReduceBivectorFunctionEvaluator();
-	else if( 0 == strcmp( functionName, "as_vector" ) )
-		return new GAVisToolVectorToFromBivectorFunctionEvaluator( GAVisToolVectorToFromBivectorFunctionEvaluator::CONVERT_VECTOR_FROM_BIVECTOR );
-	else if( 0 == strcmp( functionName, "as_bivector" ) )
-		return new GAVisToolVectorToFromBivectorFunctionEvaluator( GAVisToolVectorToFromBivectorFunctionEvaluator::CONVERT_VECTOR_TO_BIVECTOR );
-	else if( 0 == strcmp( functionName, "point" ) )
-		return new GAVisToolPointFunctionEvaluator();
+	CalcLib::FunctionEvaluator* functionEvaluator = GAVisToolFunctionRegistry::Create( functionName );
+	if( functionEvaluator )
+		return functionEvaluator;
 
 	return GeometricAlgebraEnvironment::CreateFunction( functionName );
 }
@@ -139,7 +98,7 @@ GAVisToolEnvironment::GAVisToolEnvironment( void )
 		if( bindTarget )
 		{
 			GeometricAlgebra::SumOfBlades multivector;
-			bindTarget->ComposeTo( multivector );
+			bindTarget->CachedComposeTo( multivector );
 			CalcLib::MultivectorNumber* multivectorNumber = ( CalcLib::MultivectorNumber* )&variableValue;
 			if( !multivectorNumber->AssignFrom( multivector, *this ) )
 				return false;
@@ -148,6 +107,7 @@ GAVisToolEnvironment::GAVisToolEnvironment( void )
 		}
 	}
 
+	wxCriticalSectionLocker locker( variableCriticalSection );
 	bool success = GeometricAlgebraEnvironment::LookupVariable( variableName, variableValue );
 	return success;
 }
@@ -171,10 +131,19 @@ GAVisToolEnvironment::GAVisToolEnvironment( void )
 		}
 	}
 
+	wxCriticalSectionLocker locker( variableCriticalSection );
 	bool success = GeometricAlgebraEnvironment::StoreVariable( variableName, variableValue );
 	return success;
 }
 
+//=========================================================================================
+bool GAVisToolEnvironment::LookupUnboundVariable( const char* variableName, CalcLib::Number& variableValue )
+{
+	wxCriticalSectionLocker locker( variableCriticalSection );
+	bool success = GeometricAlgebraEnvironment::LookupVariable( variableName, variableValue );
+	return success;
+}
+
 //=========================================================================================
 GAVisToolBindTarget* GAVisToolEnvironment::LookupBindTargetByIndex( int index )
 {
@@ -187,18 +156,75 @@ GAVisToolBindTarget* GAVisToolEnvironment::LookupBindTargetByIndex( int index )
 //=========================================================================================
 GAVisToolBindTarget* GAVisToolEnvironment::LookupBindTargetByName( const char* name )
 {
-	// Do a no-brainer linear search for a target by the given name.
-	GAVisToolBindTarget* foundTarget = 0;
-	for( GAVisToolBindTarget* bindTarget = ( GAVisToolBindTarget* )listOfBindTargets.LeftMost(); bindTarget && !foundTarget; bindTarget = ( GAVisToolBindTarget* )bindTarget->Right() )
-		if( 0 == strcmp( bindTarget->GetName(), name ) )
-			foundTarget = bindTarget;
-	return foundTarget;
+	BindTargetSlot* slot = LookupBindTargetSlot( name, false );
+	if( !slot )
+		return 0;
+	return slot->bindTarget;
+}
+
+//=========================================================================================
+GAVisToolEnvironment::BindTargetSlot* GAVisToolEnvironment::LookupBindTargetSlot( const char* name, bool create )
+{
+	BindTargetSlot* slot = 0;
+	if( bindTargetSlotMap && bindTargetSlotMap->Lookup( name, &slot ) )
+		return slot;
+
+	if( !create )
+		return 0;
+
+	if( !bindTargetSlotMap )
+	{
+		bindTargetSlotList = new Utilities::List();
+		bindTargetSlotMap = new Utilities::Map< BindTargetSlot* >();
+	}
+
+	slot = new BindTargetSlot();
+	bindTargetSlotList->InsertRightOf( bindTargetSlotList->RightMost(), slot );
+	bindTargetSlotMap->Insert( name, slot );
+	return slot;
+}
+
+//=========================================================================================
+// Every bind target in our list has a full slot, so the rest of the slots are empty.
+// The slots we keep are filed under the names of the bind targets they hold.
+void GAVisToolEnvironment::EmptyBindTargetSlot( BindTargetSlot* slot )
+{
+	slot->bindTarget = 0;
+
+	int emptySlotCount = bindTargetSlotList->Count() - listOfBindTargets.Count();
+	if( emptySlotCount <= listOfBindTargets.Count() )
+		return;
+
+	delete bindTargetSlotMap;
+	bindTargetSlotMap = new Utilities::Map< BindTargetSlot* >();
+
+	BindTargetSlot* nextSlot = 0;
+	for( slot = ( BindTargetSlot* )bindTargetSlotList->LeftMost(); slot; slot = nextSlot )
+	{
+		nextSlot = ( BindTargetSlot* )slot->Right();
+		if( slot->bindTarget )
+			bindTargetSlotMap->Insert( slot->bindTarget->GetName(), slot );
+		else
+			bindTargetSlotList->Remove( slot, true );
+	}
+}
+
+//=========================================================================================
+void GAVisToolEnvironment::WipeBindTargetSlots( void )
+{
+	delete bindTargetSlotMap;
+	bindTargetSlotMap = 0;
+
+	if( bindTargetSlotList )
+		bindTargetSlotList->RemoveAll( true );
+	delete bindTargetSlotList;
+	bindTargetSlotList = 0;
 }
 
 //=========================================================================================
-GAVisToolGeometry* GAVisToolEnvironment::LookupGeometryByIndex( int index )
+GAVisToolGeometry* GAVisToolEnvironment::LookupGeometryByID( int id )
 {
-	GAVisToolBindTarget* bindTarget = LookupBindTargetByIndex( index );
+	GAVisToolBindTarget* bindTarget = LookupBindTargetByID( id );
 	if( bindTarget && !bindTarget->IsTypeOf( GAVisToolGeometry::ClassName() ) )
 		bindTarget = 0;
 	return( ( GAVisToolGeometry* )bindTarget );
@@ -225,15 +251,23 @@ GAVisToolInterface* GAVisToolEnvironment::LookupInterfaceByName( const char* nam
 //=========================================================================================
 bool GAVisToolEnvironment::AddBindTarget( GAVisToolBindTarget* bindTarget )
 {
-	if( LookupBindTargetByName( bindTarget->GetName() ) )
+	BindTargetSlot* slot = LookupBindTargetSlot( bindTarget->GetName(), true );
+	if( slot->bindTarget )
 		return false;
 
 	if( !listOfBindTargets.InsertLeftOf( listOfBindTargets.LeftMost(), bindTarget ) )
 		return false;
 
+	slot->bindTarget = bindTarget;
+
 	bindTarget->Initialize();
 
-	wxGetApp().canvasFrame->inventoryTree->RegenerationNeeded();
+	drawOrderMembershipChanged = true;
+
+	if( batchDepth > 0 )
+		batchAddCount++;
+
+	InventoryTreeRegenerationNeeded();
 
 	return true;
 }
@@ -241,15 +275,23 @@ bool GAVisToolEnvironment::AddBindTarget( GAVisToolBindTarget* bindTarget )
 //=========================================================================================
 bool GAVisToolEnvironment::RemoveBindTarget( GAVisToolBindTarget* bindTarget )
 {
-	if( !LookupBindTargetByName( bindTarget->GetName() ) )
+	BindTargetSlot* slot = LookupBindTargetSlot( bindTarget->GetName(), false );
+	if( !slot || !slot->bindTarget )
 		return false;
 
 	if( !listOfBindTargets.Remove( bindTarget, false ) )
 		return false;
 
+	EmptyBindTargetSlot( slot );
+
 	bindTarget->Finalize();
 
-	wxGetApp().canvasFrame->inventoryTree->RegenerationNeeded();
+	drawOrderMembershipChanged = true;
+
+	if( batchDepth > 0 )
+		batchRemoveCount++;
+
+	InventoryTreeRegenerationNeeded();
 
 	return true;
 }
@@ -271,6 +313,14 @@ void GAVisToolEnvironment::Wipe( bool finalizeBindTargets, bool regenInventoryTr
 {
 	wipingEnvironment = true;
 
+	// Nothing in flight will be worth publishing after this.
+	if( constraintSolver )
+		constraintSolver->Cancel( true );
+	asyncSolveInFlight = false;
+	asyncSolveNeeded = false;
+	delete pendingChangeMap;
+	pendingChangeMap = 0;
+
 	while( listOfBindTargets.Count() > 0 )
 	{
 		GAVisToolBindTarget* bindTarget = ( GAVisToolBindTarget* )listOfBindTargets.LeftMost();
@@ -282,43 +332,170 @@ void GAVisToolEnvironment::Wipe( bool finalizeBindTargets, bool regenInventoryTr
 
 	listOfConstraints.RemoveAll( true );
 
+	WipeBindTargetSlots();
+
+	drawOrderMembershipChanged = true;
+
 	if( regenInventoryTree )
-		wxGetApp().canvasFrame->inventoryTree->RegenerationNeeded();
+		InventoryTreeRegenerationNeeded();
 
 	wipingEnvironment = false;
 }
 
+//=========================================================================================
+// A solve in flight is cancelled once up front, rather than every time a constraint is
+// added or removed.  Nothing new gets dispatched until the batch ends.
+void GAVisToolEnvironment::BeginBatch( void )
+{
+	if( batchDepth++ > 0 )
+		return;
+
+	CancelAsyncSolve();
+
+	batchRegenerationNeeded = false;
+	batchSatisfactionNeeded = false;
+	batchAddCount = 0;
+	batchRemoveCount = 0;
+}
+
+//=========================================================================================
+void GAVisToolEnvironment::EndBatch( void )
+{
+	wxASSERT( batchDepth > 0 );
+	if( batchDepth <= 0 || --batchDepth > 0 )
+		return;
+
+	if( batchAddCount > 0 || batchRemoveCount > 0 )
+		Print( "The batch bound %d and removed %d bind-target(s).\n", batchAddCount, batchRemoveCount );
+
+	if( batchRegenerationNeeded )
+	{
+		batchRegenerationNeeded = false;
+		wxGetApp().canvasFrame->inventoryTree->RegenerationNeeded();
+	}
+
+	if( batchSatisfactionNeeded )
+	{
+		batchSatisfactionNeeded = false;
+		SatisfyConstraints();
+	}
+}
+
+//=========================================================================================
+bool GAVisToolEnvironment::InBatch( void ) const
+{
+	return( batchDepth > 0 );
+}
+
+//=========================================================================================
+void GAVisToolEnvironment::InventoryTreeRegenerationNeeded( void )
+{
+	if( batchDepth > 0 )
+		batchRegenerationNeeded = true;
+	else
+		wxGetApp().canvasFrame->inventoryTree->RegenerationNeeded();
+}
+
 //=========================================================================================
 void GAVisToolEnvironment::Draw( GAVisToolRender& render, const char* selectedGeometry )
 {
 	// Do alpha sorting so that alpha blending works better.
 	// True alpha sorting would require us to sort all the individual polygons,
 	// but we can do a little better if we sort all the individual geometries.
-	listOfBindTargets.Sort( Utilities::List::SORT_ORDER_DESCENDING );
+	UpdateDrawOrder();
 
 	// Now go draw all the geometries in the correct order.
-	GLint selectionName = 0;
-	for( GAVisToolBindTarget* bindTarget = ( GAVisToolBindTarget* )listOfBindTargets.LeftMost(); bindTarget; bindTarget = ( GAVisToolBindTarget* )bindTarget->Right() )
+	for( int index = 0; index < drawOrderCount; index++ )
 	{
-		if( bindTarget->IsTypeOf( GAVisToolGeometry::ClassName() ) )
-		{
-			GAVisToolGeometry* geometry = ( GAVisToolGeometry* )bindTarget;
+		GAVisToolGeometry* geometry = drawOrderArray[ index ].geometry;
+
+		bool selected = false;
+		if( render.GetRenderMode() != GAVisToolRender::RENDER_MODE_SELECTION && selectedGeometry && 0 == strcmp( geometry->GetName(), selectedGeometry ) )
+			selected = true;
+
+		// The name is the ID of the geometry, which, unlike its position
+		// in any list, doesn't change from one frame to the next.
+		if( render.GetRenderMode() == GAVisToolRender::RENDER_MODE_SELECTION )
+			glPushName( geometry->ID() );
+
+		geometry->Draw( render, selected );
+
+		if( render.GetRenderMode() == GAVisToolRender::RENDER_MODE_SELECTION )
+			glPopName();
+	}
+}
+
+//=========================================================================================
+// This sorts the same way the geometries sort themselves in the bind target list.
+/*static*/ double GAVisToolEnvironment::CalculateDrawOrderSortKey( const GAVisToolGeometry* geometry, const VectorMath::Vector& cameraEye )
+{
+	// Pretend that opaque objects are very far away so that they draw
+	// before any objects that have some transparency in them.
+	if( geometry->IsOpaque() )
+		return -1000.0;
+
+	VectorMath::Vector center, delta;
+	geometry->CalcCenter( center );
+	VectorMath::Sub( delta, center, cameraEye );
+	return VectorMath::Dot( delta, delta );
+}
 
-			bool selected = false;
-			if( render.GetRenderMode() != GAVisToolRender::RENDER_MODE_SELECTION && selectedGeometry && 0 == strcmp( geometry->GetName(), selectedGeometry ) )
-				selected = true;
+//=========================================================================================
+// From one frame to the next, the draw order rarely changes by much, if at all, so an
+// insertion sort is all we need here, and we skip it entirely if no sort key changed.
+void GAVisToolEnvironment::UpdateDrawOrder( void )
+{
+	const VectorMath::Vector& cameraEye = wxGetApp().canvasFrame->canvas->camera.Eye();
 
-			if( render.GetRenderMode() == GAVisToolRender::RENDER_MODE_SELECTION )
-				glPushName( selectionName );
+	bool sortNeeded = false;
 
-			geometry->Draw( render, selected );
+	if( drawOrderMembershipChanged )
+	{
+		delete[] drawOrderArray;
+		drawOrderArray = new DrawOrderEntry[ listOfBindTargets.Count() + 1 ];
+		drawOrderCount = 0;
+
+		for( GAVisToolBindTarget* bindTarget = ( GAVisToolBindTarget* )listOfBindTargets.LeftMost(); bindTarget; bindTarget = ( GAVisToolBindTarget* )bindTarget->Right() )
+		{
+			if( bindTarget->IsTypeOf( GAVisToolGeometry::ClassName() ) )
+			{
+				DrawOrderEntry& entry = drawOrderArray[ drawOrderCount++ ];
+				entry.geometry = ( GAVisToolGeometry* )bindTarget;
+				entry.sortKey = CalculateDrawOrderSortKey( entry.geometry, cameraEye );
+			}
+		}
 
-			if( render.GetRenderMode() == GAVisToolRender::RENDER_MODE_SELECTION )
-				glPopName();
+		drawOrderMembershipChanged = false;
+		sortNeeded = true;
+	}
+	else
+	{
+		for( int index = 0; index < drawOrderCount; index++ )
+		{
+			DrawOrderEntry& entry = drawOrderArray[ index ];
+			double sortKey = CalculateDrawOrderSortKey( entry.geometry, cameraEye );
+			if( sortKey != entry.sortKey )
+			{
+				entry.sortKey = sortKey;
+				sortNeeded = true;
+			}
 		}
+	}
+
+	if( !sortNeeded )
+		return;
 
-		// The name should be an index into the bind targets list.
-		selectionName++;
+	// Sort in descending order of key.  This is stable, so geometries with equal keys keep their order.
+	for( int i = 1; i < drawOrderCount; i++ )
+	{
+		DrawOrderEntry entry = drawOrderArray[i];
+		int j = i - 1;
+		while( j >= 0 && drawOrderArray[j].sortKey < entry.sortKey )
+		{
+			drawOrderArray[ j + 1 ] = drawOrderArray[j];
+			j--;
+		}
+		drawOrderArray[ j + 1 ] = entry;
 	}
 }
 
@@ -387,7 +564,7 @@ void GAVisToolEnvironment::SchedualConstraint( GAVisToolConstraint* constraint,
 	GAVisToolConstraint* insertBefore = ( GAVisToolConstraint* )executionList.LeftMost();
 	while( insertBefore )
 	{
-		if( insertBefore->DependsUpon( insertBefore ) )
+		if( insertBefore->DependsUpon( constraint ) )
 			break;
 		insertBefore = ( GAVisToolConstraint* )insertBefore->Right();
 	}
@@ -419,6 +596,30 @@ bool GAVisToolEnvironment::SatisfyConstraints( void )
 	if( wipingEnvironment )
 		return true;
 
+	// Whatever changes during a batch is satisfied all at once when the batch ends.
+	if( batchDepth > 0 )
+	{
+		batchSatisfactionNeeded = true;
+		return true;
+	}
+
+	GAVisToolBindTarget* bindTarget = 0;
+
+	if( asyncConstraintSolving )
+	{
+		PublishSolvedConstraints();
+
+		// Only bother the solver if something changed since we last dispatched to it;
+		// otherwise we would keep making the solve in progress obsolete.
+		bool changeMade = asyncSolveNeeded;
+		for( bindTarget = ( GAVisToolBindTarget* )listOfBindTargets.LeftMost(); bindTarget && !changeMade; bindTarget = ( GAVisToolBindTarget* )bindTarget->Right() )
+			if( bindTarget->HasChanged() )
+				changeMade = true;
+
+		if( !changeMade )
+			return true;
+	}
+
 	Utilities::List executionList, cannotExecuteList;
 
 	// Sort our list first so that our schedualing algorithm is consistent in the cases
@@ -440,7 +641,8 @@ bool GAVisToolEnvironment::SatisfyConstraints( void )
 	}
 
 	// Complete the execution list with additional constraints that must execute in turn.
-	if( executionList.Count() > 0 )
+	// Constraints that depend on a cycle must execute in turn as well.
+	if( executionList.Count() > 0 || cannotExecuteList.Count() > 0 )
 	{
 		bool schedualingMade = false;
 		do
@@ -451,7 +653,7 @@ bool GAVisToolEnvironment::SatisfyConstraints( void )
 			while( constraint )
 			{
 				nextConstraint = ( GAVisToolConstraint* )constraint->Right();
-				if( constraint->NeedsExecution( executionList ) )
+				if( constraint->NeedsExecution( executionList ) || constraint->NeedsExecution( cannotExecuteList ) )
 				{
 					listOfConstraints.Remove( constraint, false );
 					SchedualConstraint( constraint, executionList, cannotExecuteList );
@@ -463,12 +665,19 @@ bool GAVisToolEnvironment::SatisfyConstraints( void )
 		while( schedualingMade );
 	}
 
-	// Now go execute the schedualed constraints in the proper order from left to right.
-	constraint = ( GAVisToolConstraint* )executionList.LeftMost();
-	while( constraint )
+	if( asyncConstraintSolving )
+		DispatchConstraints( executionList, cannotExecuteList );
+	else
 	{
-		constraint->Execute( this );
-		constraint = ( GAVisToolConstraint* )constraint->Right();
+		// Now go execute the schedualed constraints in the proper order.  Any constraints
+		// that could not be schedualed are part of a cycle, which the schedule will relax.
+		GAVisToolConstraintSchedule schedule;
+		schedule.Build( executionList, cannotExecuteList, this );
+		schedule.Execute( this );
+		SetRelaxationStats( schedule.GetStats() );
+
+		if( GAVisToolConstraint::ProfilingEnabled() )
+			wxGetApp().canvasFrame->inventoryTree->ProfileRefreshNeeded();
 	}
 
 	// Dump the constraints on each of these lists back into the list of constraints.
@@ -478,16 +687,204 @@ bool GAVisToolEnvironment::SatisfyConstraints( void )
 	// Lastly, reset the changed status flag of all bind targets.  Notice that here we may not
 	// be reseting just the flags that triggered constraints to fire in the first place, but may
 	// also be reseting flags that were set during the constraint execution process.
-	for( GAVisToolBindTarget* bindTarget = ( GAVisToolBindTarget* )listOfBindTargets.LeftMost(); bindTarget; bindTarget = ( GAVisToolBindTarget* )bindTarget->Right() )
+	for( bindTarget = ( GAVisToolBindTarget* )listOfBindTargets.LeftMost(); bindTarget; bindTarget = ( GAVisToolBindTarget* )bindTarget->Right() )
 		bindTarget->HasChanged( false );
 
 	return true;
 }
 
+//=========================================================================================
+// Hand the given schedual over to the solver thread.  Every job we dispatch makes the
+// one before it obsolete, so each job must also account for the changes of any job that
+// has not yet been published.  That is what the pending change map is for.
+void GAVisToolEnvironment::DispatchConstraints( Utilities::List& executionList, Utilities::List& cannotExecuteList )
+{
+	asyncSolveNeeded = false;
+
+	if( !pendingChangeMap )
+		pendingChangeMap = new Utilities::Map< bool >();
+
+	GAVisToolBindTarget* bindTarget = 0;
+	for( bindTarget = ( GAVisToolBindTarget* )listOfBindTargets.LeftMost(); bindTarget; bindTarget = ( GAVisToolBindTarget* )bindTarget->Right() )
+	{
+		bool entryValue = false;
+		if( bindTarget->HasChanged() && !pendingChangeMap->Lookup( bindTarget->GetName(), &entryValue ) )
+			pendingChangeMap->Insert( bindTarget->GetName(), true );
+	}
+
+	if( executionList.Count() == 0 && cannotExecuteList.Count() == 0 )
+	{
+		// If nothing is in flight, then there is nothing for these changes to wait on.
+		if( !asyncSolveInFlight )
+		{
+			delete pendingChangeMap;
+			pendingChangeMap = 0;
+		}
+		return;
+	}
+
+	GAVisToolConstraintSolverJob* job = new GAVisToolConstraintSolverJob();
+	job->Build( executionList, cannotExecuteList, this );
+
+	// Only snapshot the bind targets that the schedualed constraints actually touch.
+	for( bindTarget = ( GAVisToolBindTarget* )listOfBindTargets.LeftMost(); bindTarget; bindTarget = ( GAVisToolBindTarget* )bindTarget->Right() )
+	{
+		for( int index = 0; index < job->constraintCount; index++ )
+		{
+			GAVisToolConstraint* constraint = job->constraintArray[ index ];
+			if( constraint->IsInput( bindTarget->GetName() ) || constraint->IsOutput( bindTarget->GetName() ) )
+			{
+				job->SnapshotBindTarget( bindTarget );
+				break;
+			}
+		}
+	}
+
+	constraintSolver->Dispatch( job );
+	asyncSolveInFlight = true;
+}
+
+//=========================================================================================
+// The solver only ever finishes the latest job it was given, so everything it wrote can
+// be published together, and we never draw a partially solved set of bind targets.
+bool GAVisToolEnvironment::PublishSolvedConstraints( void )
+{
+	if( !constraintSolver )
+		return false;
+
+	GAVisToolConstraintSolverJob* job = constraintSolver->TakeFinishedJob();
+	if( !job )
+		return false;
+
+	SetRelaxationStats( job->GetStats() );
+
+	if( GAVisToolConstraint::ProfilingEnabled() )
+		wxGetApp().canvasFrame->inventoryTree->ProfileRefreshNeeded();
+
+	for( GAVisToolBindTargetValue* value = ( GAVisToolBindTargetValue* )job->valueList.LeftMost(); value; value = ( GAVisToolBindTargetValue* )value->Right() )
+	{
+		if( !value->written )
+			continue;
+
+		// Notice that we don't flag the bind target as changed here, because the
+		// constraints that depend on it were already part of the published job.
+		GAVisToolBindTarget* bindTarget = LookupBindTargetByName( value->name );
+		if( bindTarget )
+			bindTarget->DecomposeFrom( value->multivector );
+	}
+
+	if( !job->consoleOutput.IsEmpty() )
+		wxGetApp().consoleFrame->PrintConsoleOutput( job->consoleOutput );
+
+	delete job;
+
+	delete pendingChangeMap;
+	pendingChangeMap = 0;
+	asyncSolveInFlight = false;
+
+	wxGetApp().canvasFrame->canvas->RedrawNeeded( true );
+
+	return true;
+}
+
+//=========================================================================================
+// The solver must be done with a job before the constraints it references change.
+void GAVisToolEnvironment::CancelAsyncSolve( void )
+{
+	if( constraintSolver && constraintSolver->Cancel( true ) )
+		asyncSolveNeeded = true;
+}
+
+//=========================================================================================
+void GAVisToolEnvironment::SetAsyncConstraintSolving( bool asyncConstraintSolving )
+{
+	if( this->asyncConstraintSolving == asyncConstraintSolving )
+		return;
+
+	if( asyncConstraintSolving )
+	{
+		if( !constraintSolver )
+		{
+			constraintSolver = new GAVisToolConstraintSolver( this );
+			if( constraintSolver->Create() != wxTHREAD_NO_ERROR || constraintSolver->Run() != wxTHREAD_NO_ERROR )
+			{
+				AddError( "Failed to start the constraint solver thread." );
+				delete constraintSolver;
+				constraintSolver = 0;
+				return;
+			}
+		}
+	}
+	else
+	{
+		CancelAsyncSolve();
+
+		// Whatever was still pending must now be satisfied on the main thread.
+		if( pendingChangeMap )
+		{
+			Utilities::Map< bool >::Iterator pendingChangeMapIter( pendingChangeMap );
+			while( !pendingChangeMapIter.Finished() )
+			{
+				const char* bindTargetName = 0;
+				pendingChangeMapIter.CurrentEntry( &bindTargetName );
+				GAVisToolBindTarget* bindTarget = LookupBindTargetByName( bindTargetName );
+				if( bindTarget )
+					bindTarget->HasChanged( true );
+				pendingChangeMapIter.Next();
+			}
+
+			delete pendingChangeMap;
+			pendingChangeMap = 0;
+		}
+
+		asyncSolveInFlight = false;
+		asyncSolveNeeded = false;
+	}
+
+	this->asyncConstraintSolving = asyncConstraintSolving;
+}
+
+//=========================================================================================
+bool GAVisToolEnvironment::GetAsyncConstraintSolving( void ) const
+{
+	return asyncConstraintSolving;
+}
+
+//=========================================================================================
+void GAVisToolEnvironment::GetRelaxationStats( GAVisToolConstraintSchedule::Stats& stats )
+{
+	wxCriticalSectionLocker locker( relaxationStatsCriticalSection );
+	stats = relaxationStats;
+}
+
+//=========================================================================================
+// Every solve replaces the stats of the one before it, whether it had cycles or not.
+void GAVisToolEnvironment::SetRelaxationStats( const GAVisToolConstraintSchedule::Stats& stats )
+{
+	wxCriticalSectionLocker locker( relaxationStatsCriticalSection );
+	relaxationStats = stats;
+}
+
+//=========================================================================================
+bool GAVisToolEnvironment::BindTargetChangePending( GAVisToolBindTarget* bindTarget )
+{
+	if( bindTarget->HasChanged() )
+		return true;
+
+	bool entryValue = false;
+	if( pendingChangeMap && pendingChangeMap->Lookup( bindTarget->GetName(), &entryValue ) && entryValue )
+		return true;
+
+	return false;
+}
+
 //=========================================================================================
 bool GAVisToolEnvironment::AddConstraint( GAVisToolConstraint* constraint )
 {
-	wxGetApp().canvasFrame->inventoryTree->RegenerationNeeded();
+	if( batchDepth == 0 )
+		CancelAsyncSolve();
+
+	InventoryTreeRegenerationNeeded();
 
 	return listOfConstraints.InsertRightOf( listOfConstraints.RightMost(), constraint );
 }
@@ -495,7 +892,10 @@ bool GAVisToolEnvironment::AddConstraint( GAVisToolConstraint* constraint )
 //=========================================================================================
 bool GAVisToolEnvironment::RemoveConstraint( GAVisToolConstraint* constraint )
 {
-	wxGetApp().canvasFrame->inventoryTree->RegenerationNeeded();
+	if( batchDepth == 0 )
+		CancelAsyncSolve();
+
+	InventoryTreeRegenerationNeeded();
 
 	return listOfConstraints.Remove( constraint, false );
 }
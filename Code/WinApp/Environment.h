@@ -15,10 +15,13 @@
 #include "Geometry.h"
 #include "Interface.h"
 #include "Constraint.h"
+#include "ConstraintSchedule.h"
 #include "Render.h"
+#include "wxAll.h"
 
 // TODO: Headers need clean-up.
 class GAVisToolConstraint;
+class GAVisToolConstraintSolver;
 
 //=========================================================================================
 class GAVisToolEnvironment : public CalcLib::GeometricAlgebraEnvironment
@@ -39,7 +42,7 @@ public:
 	GAVisToolBindTarget* LookupBindTargetByID( int id );
 	GAVisToolBindTarget* LookupBindTargetByIndex( int index );
 	GAVisToolBindTarget* LookupBindTargetByName( const char* name );
-	GAVisToolGeometry* LookupGeometryByIndex( int index );
+	GAVisToolGeometry* LookupGeometryByID( int id );
 	GAVisToolGeometry* LookupGeometryByName( const char* name );
 	GAVisToolInterface* LookupInterfaceByName( const char* name );
 	bool AddBindTarget( GAVisToolBindTarget* bindTarget );
@@ -55,6 +58,21 @@ public:
 	bool RemoveConstraint( GAVisToolConstraint* constraint );
 	GAVisToolConstraint* LookupConstraintByID( int id );
 
+	// In async mode, constraints are satisfied on a solver thread against a snapshot of
+	// the bind targets, and the results are published back to the bind targets here on
+	// the main thread the next time we try to satisfy constraints.
+	void SetAsyncConstraintSolving( bool asyncConstraintSolving );
+	bool GetAsyncConstraintSolving( void ) const;
+
+	// A bind target's change is pending until a solve that saw it has been published.
+	bool BindTargetChangePending( GAVisToolBindTarget* bindTarget );
+
+	// This is safe to call from the solver thread.
+	bool LookupUnboundVariable( const char* variableName, CalcLib::Number& variableValue );
+
+	// These describe how the cyclic groups of the most recent solve were relaxed.
+	void GetRelaxationStats( GAVisToolConstraintSchedule::Stats& stats );
+
 	GAVisToolInventoryTree::Item* LookupInventoryItemByID( int id );
 
 	const Utilities::List& BindTargetList( void ) const;
@@ -63,14 +81,86 @@ public:
 	// This wipes out everything, cleaning/resetting the environment.
 	void Wipe( bool finalizeBindTargets, bool regenInventoryTree );
 
+	// Binding a lot of targets at once, as a script that loads a scene does, is best done in
+	// a batch.  While a batch is open, the inventory tree isn't regenerated, constraints aren't
+	// satisfied and the bind functions don't report every target they bind.  All of that is
+	// done just once when the outermost batch ends.  Batches nest.
+	void BeginBatch( void );
+	void EndBatch( void );
+	bool InBatch( void ) const;
+
 private:
 
+	//=========================================================================================
+	// Bind targets are looked up by name all the time, so we index them by name.  A slot is
+	// emptied when its bind target is removed, and is reused if the name is bound again.  We
+	// only ever insert into the map, so once empty slots outnumber the full ones, the map is
+	// rebuilt without them, and they're freed.
+	class BindTargetSlot : public Utilities::List::Item
+	{
+	public:
+
+		BindTargetSlot( void );
+		virtual ~BindTargetSlot( void );
+
+		GAVisToolBindTarget* bindTarget;
+	};
+
+	BindTargetSlot* LookupBindTargetSlot( const char* name, bool create );
+	void EmptyBindTargetSlot( BindTargetSlot* slot );
+	void WipeBindTargetSlots( void );
+	void InventoryTreeRegenerationNeeded( void );
+
+	void UpdateDrawOrder( void );
+	static double CalculateDrawOrderSortKey( const GAVisToolGeometry* geometry, const VectorMath::Vector& cameraEye );
+
 	void SchedualConstraint( GAVisToolConstraint* constraint, Utilities::List& executionList, Utilities::List& cannotExecuteList );
+	void DispatchConstraints( Utilities::List& executionList, Utilities::List& cannotExecuteList );
+	bool PublishSolvedConstraints( void );
+	void CancelAsyncSolve( void );
+	void SetRelaxationStats( const GAVisToolConstraintSchedule::Stats& stats );
 
 	Utilities::List listOfBindTargets;
 	Utilities::List listOfConstraints;
 
+	Utilities::List* bindTargetSlotList;
+	Utilities::Map< BindTargetSlot* >* bindTargetSlotMap;
+
+	int batchDepth;
+	bool batchRegenerationNeeded;
+	bool batchSatisfactionNeeded;
+	int batchAddCount;
+	int batchRemoveCount;
+
 	bool wipingEnvironment;
+
+	// Geometries are drawn in this order.  We keep it apart from the list of bind targets so
+	// that sorting for the sake of alpha blending doesn't disturb anything else.  The sort
+	// key of each geometry is cached so that we only re-sort when a key actually changes.
+	struct DrawOrderEntry
+	{
+		GAVisToolGeometry* geometry;
+		double sortKey;
+	};
+
+	DrawOrderEntry* drawOrderArray;
+	int drawOrderCount;
+	bool drawOrderMembershipChanged;
+
+	GAVisToolConstraintSolver* constraintSolver;
+	bool asyncConstraintSolving;
+	bool asyncSolveInFlight;
+	bool asyncSolveNeeded;
+	Utilities::Map< bool >* pendingChangeMap;
+
+	// The stats are copied in and out under this lock, so they're never read half written.
+	wxCriticalSection relaxationStatsCriticalSection;
+	GAVisToolConstraintSchedule::Stats relaxationStats;
+
+	// The solver thread may read unbound variables while the main thread writes them, so
+	// the virtual lookup and store that CalcLib goes through both take this.  Only the main
+	// thread ever writes, so its other reads of the variable map don't need to.
+	wxCriticalSection variableCriticalSection;
 };
 
 // Environment.h
\ No newline at end of file
@@ -0,0 +1,99 @@
+// EvaluatorCache.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "EvaluatorCache.h"
+
+//=========================================================================================
+/*static*/ wxCriticalSection GAVisToolEvaluatorCache::criticalSection;
+/*static*/ Utilities::List* GAVisToolEvaluatorCache::entryList = 0;
+/*static*/ Utilities::Map< GAVisToolEvaluatorCache::Entry* >* GAVisToolEvaluatorCache::entryMap = 0;
+/*static*/ GAVisToolEvaluatorCache::Stats GAVisToolEvaluatorCache::stats = { 0, 0, 0, 0.0 };
+
+//=========================================================================================
+GAVisToolEvaluatorCache::Entry::Entry( CalcLib::Evaluator* evaluator )
+{
+	this->evaluator = evaluator;
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolEvaluatorCache::Entry::~Entry( void )
+{
+	delete evaluator;
+}
+
+//=========================================================================================
+// Return the evaluator compiled from the given code, compiling it only if we haven't
+// already done so.  Zero is returned if the code doesn't compile, and we don't cache that.
+/*static*/ CalcLib::Evaluator* GAVisToolEvaluatorCache::Lookup( const char* code, wxCriticalSection** evaluatorLock /*= 0*/ )
+{
+	wxCriticalSectionLocker locker( criticalSection );
+
+	if( !entryMap )
+	{
+		entryList = new Utilities::List();
+		entryMap = new Utilities::Map< Entry* >();
+	}
+
+	Entry* entry = 0;
+	if( entryMap->Lookup( code, &entry ) )
+	{
+		stats.hitCount++;
+		if( evaluatorLock )
+			*evaluatorLock = &entry->evaluatorLock;
+		return entry->evaluator;
+	}
+
+	stats.missCount++;
+
+	wxStopWatch stopWatch;
+	CalcLib::Calculator calculator( "geoalg" );
+	CalcLib::Evaluator* evaluator = calculator.CompileEvaluator( code );
+	stats.compileTime += stopWatch.TimeInMicro().ToDouble();
+	if( !evaluator )
+		return 0;
+
+	entry = new Entry( evaluator );
+	entryList->InsertRightOf( entryList->RightMost(), entry );
+	entryMap->Insert( code, entry );
+	stats.evaluatorCount++;
+
+	if( evaluatorLock )
+		*evaluatorLock = &entry->evaluatorLock;
+
+	return evaluator;
+}
+
+//=========================================================================================
+// All geometries and script-backed functions must be gone before this is called.
+/*static*/ void GAVisToolEvaluatorCache::Wipe( void )
+{
+	wxCriticalSectionLocker locker( criticalSection );
+
+	delete entryMap;
+	entryMap = 0;
+
+	if( entryList )
+		entryList->RemoveAll( true );
+	delete entryList;
+	entryList = 0;
+
+	stats.evaluatorCount = 0;
+}
+
+//=========================================================================================
+/*static*/ void GAVisToolEvaluatorCache::GetStats( Stats& stats )
+{
+	wxCriticalSectionLocker locker( criticalSection );
+
+	stats = GAVisToolEvaluatorCache::stats;
+}
+
+// EvaluatorCache.cpp
\ No newline at end of file
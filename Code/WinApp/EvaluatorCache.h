@@ -0,0 +1,67 @@
+// EvaluatorCache.h
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#pragma once
+
+#include "Calculator/CalcLib.h"
+#include "wxAll.h"
+
+//=========================================================================================
+// Every geometry of a given type and bind-type compiles the very same decomposition and
+// composition scripts, so there is no reason to compile them more than once.  The same goes
+// for the script-backed console functions, like point(), which get a new evaluator every
+// time a script calls them.  Compiled evaluators are cached here by their source code and
+// shared by all geometries and functions.  The cache owns the evaluators, so they must never
+// be deleted by anyone else, and they live until the cache is wiped when the application exits.
+// Evaluators aren't reentrant, so a cached one must only ever be run on one thread at a time.
+// The geometries only run theirs on the main thread, but the script-backed functions may also
+// be called by constraints on the solver thread, so they hold the evaluator's lock while they
+// run it.
+class GAVisToolEvaluatorCache
+{
+public:
+
+	// The lock is returned if asked for, and lives as long as the evaluator.
+	static CalcLib::Evaluator* Lookup( const char* code, wxCriticalSection** evaluatorLock = 0 );
+	static void Wipe( void );
+
+	struct Stats
+	{
+		int evaluatorCount;
+		int hitCount;
+		int missCount;
+		double compileTime;		// Total microseconds spent compiling on misses.
+	};
+
+	static void GetStats( Stats& stats );
+
+private:
+
+	//=========================================================================================
+	class Entry : public Utilities::List::Item
+	{
+	public:
+
+		Entry( CalcLib::Evaluator* evaluator );
+		virtual ~Entry( void );
+
+		CalcLib::Evaluator* evaluator;
+		wxCriticalSection evaluatorLock;
+	};
+
+	// Geometries are created on the main thread, but we don't want to rely on that.
+	static wxCriticalSection criticalSection;
+	static Utilities::List* entryList;
+	static Utilities::Map< Entry* >* entryMap;
+	static Stats stats;
+};
+
+// EvaluatorCache.h
\ No newline at end of file
@@ -0,0 +1,104 @@
+// FunctionRegistry.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "FunctionRegistry.h"
+#include "Functions/BindFunction.h"
+#include <assert.h>
+
+//=========================================================================================
+// These are zero before any constructor runs, so the registrars can count on that.
+/*static*/ Utilities::List* GAVisToolFunctionRegistry::entryList = 0;
+/*static*/ Utilities::Map< GAVisToolFunctionRegistry::Entry* >* GAVisToolFunctionRegistry::entryMap = 0;
+
+//=========================================================================================
+GAVisToolFunctionRegistry::Entry::Entry( void )
+{
+	factory = 0;
+	funcType = 0;
+	creationFunction = 0;
+	bindType = GAVisToolBindTarget::DOESNT_MATTER;
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolFunctionRegistry::Entry::~Entry( void )
+{
+}
+
+//=========================================================================================
+GAVisToolFunctionRegistry::Registrar::Registrar( const char* functionName, Factory factory, int funcType /*= 0*/ )
+{
+	Entry* entry = new Entry();
+	entry->factory = factory;
+	entry->funcType = funcType;
+	Register( functionName, entry );
+}
+
+//=========================================================================================
+GAVisToolFunctionRegistry::Registrar::Registrar( const char* functionName, GAVisToolBindTarget::CreationFunction creationFunction, GAVisToolBindTarget::BindType bindType )
+{
+	Entry* entry = new Entry();
+	entry->creationFunction = creationFunction;
+	entry->bindType = bindType;
+	Register( functionName, entry );
+}
+
+//=========================================================================================
+// Registration all happens before main(), so there's only ever one thread here.
+/*static*/ void GAVisToolFunctionRegistry::Register( const char* functionName, Entry* entry )
+{
+	if( !entryMap )
+	{
+		entryList = new Utilities::List();
+		entryMap = new Utilities::Map< Entry* >();
+	}
+
+	// Two registrars for the same name is a mistake, and which one wins depends on the order
+	// in which translation units get initialized.  This runs before wxWidgets is initialized,
+	// so we use the C runtime's assert rather than wxASSERT.  Release builds keep the first.
+	Entry* existingEntry = 0;
+	bool alreadyRegistered = entryMap->Lookup( functionName, &existingEntry );
+	assert( !alreadyRegistered );
+	if( alreadyRegistered )
+	{
+		delete entry;
+		return;
+	}
+
+	entryList->InsertRightOf( entryList->RightMost(), entry );
+	entryMap->Insert( functionName, entry );
+}
+
+//=========================================================================================
+/*static*/ CalcLib::FunctionEvaluator* GAVisToolFunctionRegistry::Create( const char* functionName )
+{
+	Entry* entry = 0;
+	if( !entryMap || !entryMap->Lookup( functionName, &entry ) )
+		return 0;
+
+	if( entry->factory )
+		return entry->factory( entry->funcType );
+
+	return new GAVisToolBindFunctionEvaluator( entry->creationFunction, entry->bindType );
+}
+
+//=========================================================================================
+/*static*/ void GAVisToolFunctionRegistry::Shutdown( void )
+{
+	delete entryMap;
+	entryMap = 0;
+
+	if( entryList )
+		entryList->RemoveAll( true );
+	delete entryList;
+	entryList = 0;
+}
+
+// FunctionRegistry.cpp
\ No newline at end of file
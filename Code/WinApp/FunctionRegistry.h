@@ -0,0 +1,69 @@
+// FunctionRegistry.h
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#pragma once
+
+#include "Calculator/CalcLib.h"
+#include "BindTarget.h"
+
+//=========================================================================================
+// The parser asks the environment for a function every time it meets a function name, so
+// the names of all of our functions are hashed here instead of being compared one at a time.
+// Nobody needs to edit a central list to add a function.  Every function evaluator and every
+// type of bind target registers its names from its own translation unit with a static
+// registrar, which runs before main().  A bind function is registered with the creation
+// function and bind-type of its bind target; everything else, with a factory and an argument.
+class GAVisToolFunctionRegistry
+{
+public:
+
+	typedef CalcLib::FunctionEvaluator* ( *Factory )( int funcType );
+
+	//=========================================================================================
+	class Registrar
+	{
+	public:
+
+		Registrar( const char* functionName, Factory factory, int funcType = 0 );
+		Registrar( const char* functionName, GAVisToolBindTarget::CreationFunction creationFunction, GAVisToolBindTarget::BindType bindType );
+	};
+
+	// Zero is returned if no function by the given name was registered.
+	static CalcLib::FunctionEvaluator* Create( const char* functionName );
+	static void Shutdown( void );
+
+private:
+
+	//=========================================================================================
+	class Entry : public Utilities::List::Item
+	{
+	public:
+
+		Entry( void );
+		virtual ~Entry( void );
+
+		// This is zero for bind functions.
+		Factory factory;
+		int funcType;
+
+		GAVisToolBindTarget::CreationFunction creationFunction;
+		GAVisToolBindTarget::BindType bindType;
+	};
+
+	static void Register( const char* functionName, Entry* entry );
+
+	// These are created by the first registrar to run, because we can't know which
+	// translation unit gets initialized first.
+	static Utilities::List* entryList;
+	static Utilities::Map< Entry* >* entryMap;
+};
+
+// FunctionRegistry.h
\ No newline at end of file
@@ -0,0 +1,95 @@
+// AsyncSolveFunction.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "AsyncSolveFunction.h"
+#include "../FunctionRegistry.h"
+#include "../Environment.h"
+
+//=========================================================================================
+IMPLEMENT_CALCLIB_CLASS1( GAVisToolAsyncSolveFunctionEvaluator, FunctionEvaluator );
+
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar asyncSolveRegistrar( "async_solve", &GAVisToolAsyncSolveFunctionEvaluator::Create );
+
+//=========================================================================================
+GAVisToolAsyncSolveFunctionEvaluator::GAVisToolAsyncSolveFunctionEvaluator( void )
+{
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolAsyncSolveFunctionEvaluator::~GAVisToolAsyncSolveFunctionEvaluator( void )
+{
+}
+
+//=========================================================================================
+/*static*/ CalcLib::FunctionEvaluator* GAVisToolAsyncSolveFunctionEvaluator::Create( int funcType )
+{
+	return new GAVisToolAsyncSolveFunctionEvaluator();
+}
+
+//=========================================================================================
+// Usage: async_solve(1) to satisfy constraints on the solver thread, async_solve(0) to
+// satisfy them on the main thread as before, and async_solve() to see which it is.
+/*virtual*/ bool GAVisToolAsyncSolveFunctionEvaluator::EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment )
+{
+	bool success = false;
+	CalcLib::Number* argumentResult = 0;
+
+	do
+	{
+		if( !result.AssignAdditiveIdentity( environment ) )
+			break;
+
+		GAVisToolEnvironment* visToolEnv = environment.Cast< GAVisToolEnvironment >();
+		if( !visToolEnv )
+		{
+			environment.AddError( "The async_solve() function only operates within the GAVisTool environment." );
+			break;
+		}
+
+		if( GetArgumentCount() > 1 )
+		{
+			environment.AddError( "The async_solve() function expects zero or one argument." );
+			break;
+		}
+
+		if( GetArgumentCount() == 1 )
+		{
+			CalcLib::FunctionArgumentEvaluator* argumentEvaluator = GetArgument(0);
+			argumentResult = environment.CreateNumber( argumentEvaluator );
+			if( !argumentEvaluator->EvaluateResult( *argumentResult, environment ) )
+				break;
+
+			CalcLib::MultivectorNumber* multivectorNumber = argumentResult->Cast< CalcLib::MultivectorNumber >();
+			GeometricAlgebra::SumOfBlades multivector;
+			GeometricAlgebra::Scalar scalar;
+			if( !multivectorNumber || !multivectorNumber->AssignTo( multivector, environment ) || !multivector.AssignScalarTo( scalar ) )
+			{
+				environment.AddError( "The async_solve() function expects its argument to be a scalar." );
+				break;
+			}
+
+			double value = scalar;
+			visToolEnv->SetAsyncConstraintSolving( value != 0.0 );
+		}
+
+		environment.Print( "Constraints are satisfied %s.\n", visToolEnv->GetAsyncConstraintSolving() ? "asynchronously on the solver thread" : "synchronously on the main thread" );
+
+		success = true;
+	}
+	while( false );
+
+	delete argumentResult;
+
+	return success;
+}
+
+// AsyncSolveFunction.cpp
\ No newline at end of file
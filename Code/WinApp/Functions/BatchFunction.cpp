@@ -0,0 +1,74 @@
+// BatchFunction.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "BatchFunction.h"
+#include "../FunctionRegistry.h"
+#include "../Environment.h"
+
+//=========================================================================================
+IMPLEMENT_CALCLIB_CLASS1( GAVisToolBatchFunctionEvaluator, FunctionEvaluator );
+
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar batchRegistrar( "batch", &GAVisToolBatchFunctionEvaluator::Create );
+
+//=========================================================================================
+GAVisToolBatchFunctionEvaluator::GAVisToolBatchFunctionEvaluator( void )
+{
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolBatchFunctionEvaluator::~GAVisToolBatchFunctionEvaluator( void )
+{
+}
+
+//=========================================================================================
+/*static*/ CalcLib::FunctionEvaluator* GAVisToolBatchFunctionEvaluator::Create( int funcType )
+{
+	return new GAVisToolBatchFunctionEvaluator();
+}
+
+//=========================================================================================
+// Usage: batch( bind_point( p1 ), bind_point( p2 ), ... ) evaluates its arguments in order,
+// just like do(), and its result is that of its last argument.  All of the bookkeeping the
+// environment would do for each argument is done once, after the last one.  The batch is
+// still closed if an argument fails, so that the environment isn't left in a batch.
+/*virtual*/ bool GAVisToolBatchFunctionEvaluator::EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment )
+{
+	GAVisToolEnvironment* visToolEnv = environment.Cast< GAVisToolEnvironment >();
+	if( !visToolEnv )
+	{
+		environment.AddError( "The batch() function only operates within the GAVisTool environment." );
+		return false;
+	}
+
+	if( !result.AssignAdditiveIdentity( environment ) )
+		return false;
+
+	bool success = true;
+
+	visToolEnv->BeginBatch();
+
+	for( int index = 0; index < GetArgumentCount() && success; index++ )
+	{
+		CalcLib::FunctionArgumentEvaluator* argumentEvaluator = GetArgument( index );
+		if( !argumentEvaluator->EvaluateResult( result, environment ) )
+		{
+			environment.AddError( "Argument %d of the batch failed to evaluate.", index + 1 );
+			success = false;
+		}
+	}
+
+	visToolEnv->EndBatch();
+
+	return success;
+}
+
+// BatchFunction.cpp
\ No newline at end of file
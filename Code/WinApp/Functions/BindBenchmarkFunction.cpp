@@ -0,0 +1,165 @@
+// BindBenchmarkFunction.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "BindBenchmarkFunction.h"
+#include "../FunctionRegistry.h"
+#include "../Environment.h"
+#include "../EvaluatorCache.h"
+#include "../ScratchEnvironment.h"
+#include "../Geometries/RoundGeometry.h"
+#include "PointFunction.h"
+#include "../Interfaces/ScalarInterface.h"
+
+//=========================================================================================
+IMPLEMENT_CALCLIB_CLASS1( GAVisToolBindBenchmarkFunctionEvaluator, FunctionEvaluator );
+
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar benchBindRegistrar( "bench_bind", &GAVisToolBindBenchmarkFunctionEvaluator::Create );
+
+//=========================================================================================
+GAVisToolBindBenchmarkFunctionEvaluator::GAVisToolBindBenchmarkFunctionEvaluator( void )
+{
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolBindBenchmarkFunctionEvaluator::~GAVisToolBindBenchmarkFunctionEvaluator( void )
+{
+}
+
+//=========================================================================================
+/*static*/ CalcLib::FunctionEvaluator* GAVisToolBindBenchmarkFunctionEvaluator::Create( int funcType )
+{
+	return new GAVisToolBindBenchmarkFunctionEvaluator();
+}
+
+//=========================================================================================
+// Usage: bench_bind(N) binds N points, alternating between normal and dual form, and
+// then runs the point() script N times with and without the evaluator cache.
+/*virtual*/ bool GAVisToolBindBenchmarkFunctionEvaluator::EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment )
+{
+	if( !result.AssignAdditiveIdentity( environment ) )
+		return false;
+
+	GAVisToolEnvironment* visToolEnv = environment.Cast< GAVisToolEnvironment >();
+	if( !visToolEnv )
+	{
+		environment.AddError( "The bind benchmark only operates within the GAVisTool environment." );
+		return false;
+	}
+
+	double bindCount = 1000.0;
+	if( GetArgumentCount() > 0 && !ScalarInterface::EvaluateScalarArgument( GetArgument( 0 ), 0, bindCount, environment ) )
+		return false;
+
+	if( bindCount < 1.0 )
+	{
+		environment.AddError( "The bench_bind() function expects a positive number of binds." );
+		return false;
+	}
+
+	BenchmarkBind( int( bindCount ), visToolEnv );
+	BenchmarkPointScript( int( bindCount ), visToolEnv );
+	return true;
+}
+
+//=========================================================================================
+// This does what the bind function does to a point, minus the environment bookkeeping and
+// redraw, which is the same with or without the cache.  Every point constructed goes to
+// the cache for both of its scripts, so all but the first two of each form are hits.
+void GAVisToolBindBenchmarkFunctionEvaluator::BenchmarkBind( int bindCount, GAVisToolEnvironment* visToolEnv )
+{
+	GAVisToolEvaluatorCache::Stats statsBefore, statsAfter;
+	GAVisToolEvaluatorCache::GetStats( statsBefore );
+
+	GeometricAlgebra::SumOfBlades element;
+	wxStopWatch stopWatch;
+
+	for( int index = 0; index < bindCount; index++ )
+	{
+		GAVisToolBindTarget::BindType bindType = ( index % 2 ) ? GAVisToolBindTarget::DUAL_FORM : GAVisToolBindTarget::NORMAL_FORM;
+		GAVisToolBindTarget* bindTarget = ConformalPoint::Create( bindType );
+		bindTarget->SetName( "bench_bind" );
+		bindTarget->ComposeTo( element );
+		bindTarget->DecomposeFrom( element );
+		delete bindTarget;
+	}
+
+	double bindTime = stopWatch.TimeInMicro().ToDouble();
+
+	GAVisToolEvaluatorCache::GetStats( statsAfter );
+
+	int hitCount = statsAfter.hitCount - statsBefore.hitCount;
+	int missCount = statsAfter.missCount - statsBefore.missCount;
+
+	visToolEnv->Print( "Bound %d points in %1.3f ms (%1.2f us/bind, %1.0f binds/sec).\n", bindCount, bindTime / 1000.0, bindTime / double( bindCount ), double( bindCount ) * 1e6 / bindTime );
+	visToolEnv->Print( "Evaluator cache: %d evaluators, %d hits and %d misses during the benchmark.\n", statsAfter.evaluatorCount, hitCount, missCount );
+}
+
+//=========================================================================================
+// Before the cache, point() compiled its script every time it was called.  Here we time the
+// script both ways, each in a scratch environment, so the only difference is the compile.
+void GAVisToolBindBenchmarkFunctionEvaluator::BenchmarkPointScript( int evaluationCount, GAVisToolEnvironment* visToolEnv )
+{
+	const char* code = GAVisToolPointFunctionEvaluator::evaluatorCode;
+
+	wxCriticalSection* evaluatorLock = 0;
+	CalcLib::Evaluator* cachedEvaluator = GAVisToolEvaluatorCache::Lookup( code, &evaluatorLock );
+	if( !cachedEvaluator )
+		return;
+
+	ConformalCoefficients coefficients;
+	coefficients.coefficient[ ConformalCoefficients::E1 ] = 1.0;
+	coefficients.coefficient[ ConformalCoefficients::E2 ] = -2.0;
+	coefficients.coefficient[ ConformalCoefficients::E3 ] = 3.0;
+	GeometricAlgebra::SumOfBlades point;
+	coefficients.AssignTo( point );
+
+	wxStopWatch stopWatch;
+
+	for( int index = 0; index < evaluationCount; index++ )
+	{
+		GAVisToolScratchEnvironment::Loan loan;
+		GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
+		gaEnv.multivector->AssignFrom( point, gaEnv );
+		gaEnv.StoreVariable( "point", *gaEnv.number );
+
+		wxCriticalSectionLocker locker( *evaluatorLock );
+		cachedEvaluator->EvaluateResult( *gaEnv.number, gaEnv );
+	}
+
+	double cachedTime = stopWatch.TimeInMicro().ToDouble();
+
+	stopWatch.Start();
+
+	for( int index = 0; index < evaluationCount; index++ )
+	{
+		CalcLib::Calculator calculator( "geoalg" );
+		CalcLib::Evaluator* evaluator = calculator.CompileEvaluator( code );
+		if( !evaluator )
+			return;
+
+		GAVisToolScratchEnvironment::Loan loan;
+		GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
+		gaEnv.multivector->AssignFrom( point, gaEnv );
+		gaEnv.StoreVariable( "point", *gaEnv.number );
+		evaluator->EvaluateResult( *gaEnv.number, gaEnv );
+
+		delete evaluator;
+	}
+
+	double uncachedTime = stopWatch.TimeInMicro().ToDouble();
+
+	visToolEnv->Print( "Ran the point() script %d times: %1.2f us/call from the cache, %1.2f us/call compiling every time (%1.1fx).\n",
+					evaluationCount, cachedTime / double( evaluationCount ), uncachedTime / double( evaluationCount ),
+					( cachedTime > 0.0 ? uncachedTime / cachedTime : 0.0 ) );
+}
+
+// BindBenchmarkFunction.cpp
\ No newline at end of file
@@ -0,0 +1,36 @@
+// BindBenchmarkFunction.h
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#pragma once
+
+#include "Calculator/CalcLib.h"
+
+class GAVisToolEnvironment;
+
+//=========================================================================================
+class GAVisToolBindBenchmarkFunctionEvaluator : public CalcLib::FunctionEvaluator
+{
+	DECLARE_CALCLIB_CLASS( GAVisToolBindBenchmarkFunctionEvaluator );
+
+public:
+
+	GAVisToolBindBenchmarkFunctionEvaluator( void );
+	virtual ~GAVisToolBindBenchmarkFunctionEvaluator( void );
+	static CalcLib::FunctionEvaluator* Create( int funcType );
+	virtual bool EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment );
+
+private:
+
+	void BenchmarkBind( int bindCount, GAVisToolEnvironment* visToolEnv );
+	void BenchmarkPointScript( int evaluationCount, GAVisToolEnvironment* visToolEnv );
+};
+
+// BindBenchmarkFunction.h
\ No newline at end of file
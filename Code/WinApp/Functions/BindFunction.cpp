@@ -10,12 +10,17 @@
  */
 
 #include "BindFunction.h"
+#include "../FunctionRegistry.h"
 #include "../Environment.h"
 #include "../Application.h"
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( GAVisToolBindFunctionEvaluator, FunctionEvaluator );
 
+//=========================================================================================
+// Every other bind function is registered by the bind target it creates.
+static GAVisToolFunctionRegistry::Registrar unbindRegistrar( "unbind", GAVisToolBindTarget::CreationFunction( 0 ), GAVisToolBindTarget::DOESNT_MATTER );
+
 //=========================================================================================
 GAVisToolBindFunctionEvaluator::GAVisToolBindFunctionEvaluator( GAVisToolGeometry::CreationFunction creationFunction, GAVisToolGeometry::BindType bindType )
 {
@@ -102,7 +107,8 @@ bool GAVisToolBindFunctionEvaluator::Unbind(
 		// Okay, now blow it away.
 		visToolEnv->RemoveBindTarget( bindTarget );
 		delete bindTarget;
-		visToolEnv->Print( "The old bind-target bound to variable \"%s\" has been removed.\n", variableEvaluator->Name() );
+		if( !visToolEnv->InBatch() )
+			visToolEnv->Print( "The old bind-target bound to variable \"%s\" has been removed.\n", variableEvaluator->Name() );
 
 		// Now sync the variable value.
 		CalcLib::MultivectorNumber multivectorNumber( element );
@@ -151,7 +157,8 @@ bool GAVisToolBindFunctionEvaluator::Bind(
 	}
 
 	visToolEnv->AddBindTarget( bindTarget );
-	visToolEnv->Print( "A new bind-target has been bound to variable \"%s\".\n", variableEvaluator->Name() );
+	if( !visToolEnv->InBatch() )
+		visToolEnv->Print( "A new bind-target has been bound to variable \"%s\".\n", variableEvaluator->Name() );
 	return true;
 }
 
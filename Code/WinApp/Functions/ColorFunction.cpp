@@ -10,12 +10,16 @@
  */
 
 #include "ColorFunction.h"
+#include "../FunctionRegistry.h"
 #include "../Environment.h"
 #include "../Application.h"
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( GAVisToolColorFunctionEvaluator, FunctionEvaluator );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar geoColorRegistrar( "geo_color", &GAVisToolColorFunctionEvaluator::Create );
+
 //=========================================================================================
 GAVisToolColorFunctionEvaluator::GAVisToolColorFunctionEvaluator( void )
 {
@@ -26,6 +30,12 @@ GAVisToolColorFunctionEvaluator::GAVisToolColorFunctionEvaluator( void )
 {
 }
 
+//=========================================================================================
+/*static*/ CalcLib::FunctionEvaluator* GAVisToolColorFunctionEvaluator::Create( int funcType )
+{
+	return new GAVisToolColorFunctionEvaluator();
+}
+
 //=========================================================================================
 /*virtual*/ bool GAVisToolColorFunctionEvaluator::EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment )
 {
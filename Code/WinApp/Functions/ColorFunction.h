@@ -23,6 +23,7 @@ public:
 
 	GAVisToolColorFunctionEvaluator( void );
 	virtual ~GAVisToolColorFunctionEvaluator( void );
+	static CalcLib::FunctionEvaluator* Create( int funcType );
 	virtual bool EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment );
 
 private:
@@ -0,0 +1,160 @@
+// ConstraintProfileFunction.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "ConstraintProfileFunction.h"
+#include "../FunctionRegistry.h"
+#include "../Environment.h"
+#include "../Application.h"
+#include "../Interfaces/ScalarInterface.h"
+
+//=========================================================================================
+IMPLEMENT_CALCLIB_CLASS1( GAVisToolConstraintProfileFunctionEvaluator, FunctionEvaluator );
+
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar profileConstraintsRegistrar( "profile_constraints", &GAVisToolConstraintProfileFunctionEvaluator::Create, GAVisToolConstraintProfileFunctionEvaluator::ENABLE_PROFILING );
+static GAVisToolFunctionRegistry::Registrar dumpProfileRegistrar( "dump_profile", &GAVisToolConstraintProfileFunctionEvaluator::Create, GAVisToolConstraintProfileFunctionEvaluator::DUMP_PROFILE );
+
+//=========================================================================================
+GAVisToolConstraintProfileFunctionEvaluator::GAVisToolConstraintProfileFunctionEvaluator( FuncType funcType )
+{
+	this->funcType = funcType;
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolConstraintProfileFunctionEvaluator::~GAVisToolConstraintProfileFunctionEvaluator( void )
+{
+}
+
+//=========================================================================================
+/*static*/ CalcLib::FunctionEvaluator* GAVisToolConstraintProfileFunctionEvaluator::Create( int funcType )
+{
+	return new GAVisToolConstraintProfileFunctionEvaluator( FuncType( funcType ) );
+}
+
+//=========================================================================================
+// Usage: profile_constraints(1) resets and starts profiling, profile_constraints(0) stops it,
+// and dump_profile(N) lists the N constraints that have cost the most total time so far.
+/*virtual*/ bool GAVisToolConstraintProfileFunctionEvaluator::EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment )
+{
+	if( !result.AssignAdditiveIdentity( environment ) )
+		return false;
+
+	GAVisToolEnvironment* visToolEnv = environment.Cast< GAVisToolEnvironment >();
+	if( !visToolEnv )
+	{
+		environment.AddError( "Constraint profiling only operates within the GAVisTool environment." );
+		return false;
+	}
+
+	switch( funcType )
+	{
+		case ENABLE_PROFILING:
+		{
+			if( GetArgumentCount() != 1 )
+			{
+				environment.AddError( "The profile_constraints() function expects one argument." );
+				return false;
+			}
+
+			double enable = 0.0;
+			if( !ScalarInterface::EvaluateScalarArgument( GetArgument( 0 ), 0, enable, environment ) )
+				return false;
+
+			if( enable != 0.0 && !GAVisToolConstraint::ProfilingEnabled() )
+			{
+				const Utilities::List& constraintList = visToolEnv->ConstraintList();
+				for( GAVisToolConstraint* constraint = ( GAVisToolConstraint* )constraintList.LeftMost(); constraint; constraint = ( GAVisToolConstraint* )constraint->Right() )
+					constraint->ResetProfile();
+			}
+
+			GAVisToolConstraint::EnableProfiling( enable != 0.0 );
+			wxGetApp().canvasFrame->inventoryTree->RegenerationNeeded();
+			break;
+		}
+		case DUMP_PROFILE:
+		{
+			double constraintCount = 10.0;
+			if( GetArgumentCount() > 0 && !ScalarInterface::EvaluateScalarArgument( GetArgument( 0 ), 0, constraintCount, environment ) )
+				return false;
+
+			DumpProfile( int( constraintCount ), visToolEnv );
+
+			// The inventory tree shows the same numbers, so bring it up to date too.
+			wxGetApp().canvasFrame->inventoryTree->RegenerationNeeded();
+			break;
+		}
+	}
+
+	return true;
+}
+
+//=========================================================================================
+// Rank by total time, breaking ties by ID so that every constraint has a distinct rank.
+static bool IsRankedBelow( const GAVisToolConstraint* constraint, const GAVisToolConstraint* otherConstraint )
+{
+	double totalTime = constraint->GetProfile().totalTime;
+	double otherTotalTime = otherConstraint->GetProfile().totalTime;
+	if( totalTime != otherTotalTime )
+		return( totalTime < otherTotalTime );
+	return( constraint->ID() > otherConstraint->ID() );
+}
+
+//=========================================================================================
+// There are never so many constraints that repeatedly picking out the next most costly
+// one would be too slow, so we don't bother sorting the list of constraints here.
+void GAVisToolConstraintProfileFunctionEvaluator::DumpProfile( int constraintCount, GAVisToolEnvironment* visToolEnv )
+{
+	const Utilities::List& constraintList = visToolEnv->ConstraintList();
+	if( constraintList.Count() == 0 )
+	{
+		visToolEnv->Print( "There are no constraints to profile.\n" );
+		return;
+	}
+
+	if( !GAVisToolConstraint::ProfilingEnabled() )
+		visToolEnv->Print( "Constraint profiling is disabled.  Use profile_constraints(1) to enable it.\n" );
+
+	const GAVisToolConstraint* lastConstraint = 0;
+	for( int rank = 1; rank <= constraintCount; rank++ )
+	{
+		const GAVisToolConstraint* costliestConstraint = 0;
+		for( const GAVisToolConstraint* constraint = ( const GAVisToolConstraint* )constraintList.LeftMost(); constraint; constraint = ( const GAVisToolConstraint* )constraint->Right() )
+		{
+			if( lastConstraint && !IsRankedBelow( constraint, lastConstraint ) )
+				continue;
+			if( !costliestConstraint || IsRankedBelow( costliestConstraint, constraint ) )
+				costliestConstraint = constraint;
+		}
+
+		if( !costliestConstraint )
+			break;
+
+		char description[ 512 ];
+		costliestConstraint->Describe( description, sizeof( description ) );
+
+		const GAVisToolConstraint::Profile& profile = costliestConstraint->GetProfile();
+		visToolEnv->Print( "%d. %s\n", rank, description );
+		visToolEnv->Print( "   executions: %d, total: %1.3f ms, max: %1.3f ms, last: %1.3f ms\n",
+						profile.executionCount, profile.totalTime, profile.maxTime, profile.lastTime );
+
+		lastConstraint = costliestConstraint;
+	}
+
+	GAVisToolConstraintSchedule::Stats relaxationStats;
+	visToolEnv->GetRelaxationStats( relaxationStats );
+	if( relaxationStats.cyclicGroupCount > 0 )
+	{
+		visToolEnv->Print( "The last solve relaxed %d cyclic group(s) in %d sweep(s); %d did not converge, and the max residual was %g.\n",
+						relaxationStats.cyclicGroupCount, relaxationStats.sweepCount, relaxationStats.unconvergedGroupCount, relaxationStats.maxResidual );
+	}
+}
+
+// ConstraintProfileFunction.cpp
\ No newline at end of file
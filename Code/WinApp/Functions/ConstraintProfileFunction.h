@@ -0,0 +1,42 @@
+// ConstraintProfileFunction.h
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#pragma once
+
+#include "Calculator/CalcLib.h"
+#include "../Constraint.h"
+
+//=========================================================================================
+class GAVisToolConstraintProfileFunctionEvaluator : public CalcLib::FunctionEvaluator
+{
+	DECLARE_CALCLIB_CLASS( GAVisToolConstraintProfileFunctionEvaluator );
+
+public:
+
+	enum FuncType
+	{
+		ENABLE_PROFILING,
+		DUMP_PROFILE,
+	};
+
+	GAVisToolConstraintProfileFunctionEvaluator( FuncType funcType );
+	virtual ~GAVisToolConstraintProfileFunctionEvaluator( void );
+	static CalcLib::FunctionEvaluator* Create( int funcType );
+	virtual bool EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment );
+
+private:
+
+	void DumpProfile( int constraintCount, GAVisToolEnvironment* visToolEnv );
+
+	FuncType funcType;
+};
+
+// ConstraintProfileFunction.h
\ No newline at end of file
@@ -0,0 +1,85 @@
+// ConvergenceStatsFunction.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "ConvergenceStatsFunction.h"
+#include "../FunctionRegistry.h"
+#include "../Environment.h"
+#include "../Geometry.h"
+#include "../Interfaces/ScalarInterface.h"
+
+//=========================================================================================
+IMPLEMENT_CALCLIB_CLASS1( GAVisToolConvergenceStatsFunctionEvaluator, FunctionEvaluator );
+
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar convergenceStatsRegistrar( "convergence_stats", &GAVisToolConvergenceStatsFunctionEvaluator::Create );
+
+//=========================================================================================
+GAVisToolConvergenceStatsFunctionEvaluator::GAVisToolConvergenceStatsFunctionEvaluator( void )
+{
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolConvergenceStatsFunctionEvaluator::~GAVisToolConvergenceStatsFunctionEvaluator( void )
+{
+}
+
+//=========================================================================================
+/*static*/ CalcLib::FunctionEvaluator* GAVisToolConvergenceStatsFunctionEvaluator::Create( int funcType )
+{
+	return new GAVisToolConvergenceStatsFunctionEvaluator();
+}
+
+//=========================================================================================
+// Usage: convergence_stats() reports how much work it took to converge points to surfaces
+// since the last time it was called, for traces, meshes and point sampling each.  Given an
+// argument, it then switches to Newton steps if that argument is non-zero, and to the
+// plain walk down the gradient if it is zero, so that the two can be compared.
+/*virtual*/ bool GAVisToolConvergenceStatsFunctionEvaluator::EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment )
+{
+	if( !result.AssignAdditiveIdentity( environment ) )
+		return false;
+
+	GAVisToolEnvironment* visToolEnv = environment.Cast< GAVisToolEnvironment >();
+	if( !visToolEnv )
+	{
+		environment.AddError( "The convergence_stats() function only operates within the GAVisTool environment." );
+		return false;
+	}
+
+	double useNewtonSteps = GAVisToolGeometry::UsingNewtonSteps() ? 1.0 : 0.0;
+	if( GetArgumentCount() > 0 && !ScalarInterface::EvaluateScalarArgument( GetArgument( 0 ), 0, useNewtonSteps, environment ) )
+		return false;
+
+	static const char* purposeName[ GAVisToolGeometry::CONVERGENCE_PURPOSE_COUNT ] = { "Tracing", "Meshing", "Point sampling" };
+
+	visToolEnv->Print( "Points were converged using %s.\n", GAVisToolGeometry::UsingNewtonSteps() ? "Newton steps" : "the gradient walk" );
+
+	for( int purpose = 0; purpose < GAVisToolGeometry::CONVERGENCE_PURPOSE_COUNT; purpose++ )
+	{
+		VectorMath::Surface::ConvergenceStats stats;
+		GAVisToolGeometry::GetConvergenceStats( GAVisToolGeometry::ConvergencePurpose( purpose ), stats );
+
+		visToolEnv->Print( "%s: %d points converged and %d failed to.\n", purposeName[ purpose ], stats.convergedCount, stats.failedCount );
+		if( stats.convergedCount > 0 )
+		{
+			double convergedCount = double( stats.convergedCount );
+			visToolEnv->Print( "\t%1.2f iterations and %1.2f evaluations per converged point; %d had to fall back on the walk.\n",
+								double( stats.iterationCount ) / convergedCount, double( stats.evaluationCount ) / convergedCount, stats.fallbackCount );
+		}
+	}
+
+	GAVisToolGeometry::ResetConvergenceStats();
+	GAVisToolGeometry::UseNewtonSteps( useNewtonSteps != 0.0 );
+
+	return true;
+}
+
+// ConvergenceStatsFunction.cpp
\ No newline at end of file
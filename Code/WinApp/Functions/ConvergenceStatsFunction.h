@@ -0,0 +1,29 @@
+// ConvergenceStatsFunction.h
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#pragma once
+
+#include "Calculator/CalcLib.h"
+
+//=========================================================================================
+class GAVisToolConvergenceStatsFunctionEvaluator : public CalcLib::FunctionEvaluator
+{
+	DECLARE_CALCLIB_CLASS( GAVisToolConvergenceStatsFunctionEvaluator );
+
+public:
+
+	GAVisToolConvergenceStatsFunctionEvaluator( void );
+	virtual ~GAVisToolConvergenceStatsFunctionEvaluator( void );
+	static CalcLib::FunctionEvaluator* Create( int funcType );
+	virtual bool EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment );
+};
+
+// ConvergenceStatsFunction.h
\ No newline at end of file
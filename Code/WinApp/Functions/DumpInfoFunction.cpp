@@ -10,11 +10,15 @@
  */
 
 #include "DumpInfoFunction.h"
+#include "../FunctionRegistry.h"
 #include "../Environment.h"
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( GAVisToolDumpInfoFunctionEvaluator, FunctionEvaluator );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar dumpInfoRegistrar( "dump_info", &GAVisToolDumpInfoFunctionEvaluator::Create );
+
 //=========================================================================================
 GAVisToolDumpInfoFunctionEvaluator::GAVisToolDumpInfoFunctionEvaluator( void )
 {
@@ -25,6 +29,12 @@ GAVisToolDumpInfoFunctionEvaluator::GAVisToolDumpInfoFunctionEvaluator( void )
 {
 }
 
+//=========================================================================================
+/*static*/ CalcLib::FunctionEvaluator* GAVisToolDumpInfoFunctionEvaluator::Create( int funcType )
+{
+	return new GAVisToolDumpInfoFunctionEvaluator();
+}
+
 //=========================================================================================
 /*virtual*/ bool GAVisToolDumpInfoFunctionEvaluator::EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment )
 {
@@ -23,6 +23,7 @@ public:
 
 	GAVisToolDumpInfoFunctionEvaluator( void );
 	virtual ~GAVisToolDumpInfoFunctionEvaluator( void );
+	static CalcLib::FunctionEvaluator* Create( int funcType );
 	virtual bool EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment );
 };
 
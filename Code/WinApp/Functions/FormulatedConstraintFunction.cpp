@@ -10,11 +10,15 @@
  */
 
 #include "FormulatedConstraintFunction.h"
+#include "../FunctionRegistry.h"
 #include "../Constraints/FormulatedConstraint.h"
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( GAVisToolFormulatedConstraintFunctionEvaluator, FunctionEvaluator );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar formulaConstraintRegistrar( "formula_constraint", &GAVisToolFormulatedConstraintFunctionEvaluator::Create );
+
 //=========================================================================================
 GAVisToolFormulatedConstraintFunctionEvaluator::GAVisToolFormulatedConstraintFunctionEvaluator( void )
 {
@@ -25,6 +29,12 @@ GAVisToolFormulatedConstraintFunctionEvaluator::GAVisToolFormulatedConstraintFun
 {
 }
 
+//=========================================================================================
+/*static*/ CalcLib::FunctionEvaluator* GAVisToolFormulatedConstraintFunctionEvaluator::Create( int funcType )
+{
+	return new GAVisToolFormulatedConstraintFunctionEvaluator();
+}
+
 //=========================================================================================
 /*virtual*/ bool GAVisToolFormulatedConstraintFunctionEvaluator::EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment )
 {
@@ -23,6 +23,7 @@ public:
 
 	GAVisToolFormulatedConstraintFunctionEvaluator( void );
 	virtual ~GAVisToolFormulatedConstraintFunctionEvaluator( void );
+	static CalcLib::FunctionEvaluator* Create( int funcType );
 	virtual bool EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment );
 };
 
@@ -0,0 +1,443 @@
+// GeometryOracleFunction.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "GeometryOracleFunction.h"
+#include "../FunctionRegistry.h"
+#include "../Environment.h"
+#include "../Geometries/RoundGeometry.h"
+#include "../Geometries/FlatGeometry.h"
+#include "../Geometries/TransformGeometry.h"
+#include "../Interfaces/ScalarInterface.h"
+
+//=========================================================================================
+IMPLEMENT_CALCLIB_CLASS1( GAVisToolGeometryOracleFunctionEvaluator, FunctionEvaluator );
+
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar geometryOracleRegistrar( "geometry_oracle", &GAVisToolGeometryOracleFunctionEvaluator::Create, GAVisToolGeometryOracleFunctionEvaluator::USE_SCRIPT_ORACLE );
+static GAVisToolFunctionRegistry::Registrar verifyGeometryRegistrar( "verify_geometry", &GAVisToolGeometryOracleFunctionEvaluator::Create, GAVisToolGeometryOracleFunctionEvaluator::VERIFY_NATIVE_GEOMETRY );
+static GAVisToolFunctionRegistry::Registrar benchProductsRegistrar( "bench_products", &GAVisToolGeometryOracleFunctionEvaluator::Create, GAVisToolGeometryOracleFunctionEvaluator::BENCHMARK_PRODUCTS );
+
+//=========================================================================================
+GAVisToolGeometryOracleFunctionEvaluator::GAVisToolGeometryOracleFunctionEvaluator( FuncType funcType )
+{
+	this->funcType = funcType;
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolGeometryOracleFunctionEvaluator::~GAVisToolGeometryOracleFunctionEvaluator( void )
+{
+}
+
+//=========================================================================================
+/*static*/ CalcLib::FunctionEvaluator* GAVisToolGeometryOracleFunctionEvaluator::Create( int funcType )
+{
+	return new GAVisToolGeometryOracleFunctionEvaluator( FuncType( funcType ) );
+}
+
+//=========================================================================================
+// Usage: geometry_oracle(1) makes the conformal geometries use their scripts, geometry_oracle(0)
+// goes back to the native code, and verify_geometry(N) checks the native code against the
+// scripts with N random geometries of each type and reports how much faster it is.  Also,
+// bench_products(N) times N dense products against the same products of sums of blades.
+/*virtual*/ bool GAVisToolGeometryOracleFunctionEvaluator::EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment )
+{
+	if( !result.AssignAdditiveIdentity( environment ) )
+		return false;
+
+	GAVisToolEnvironment* visToolEnv = environment.Cast< GAVisToolEnvironment >();
+	if( !visToolEnv )
+	{
+		environment.AddError( "Geometry verification only operates within the GAVisTool environment." );
+		return false;
+	}
+
+	switch( funcType )
+	{
+		case USE_SCRIPT_ORACLE:
+		{
+			if( GetArgumentCount() != 1 )
+			{
+				environment.AddError( "The geometry_oracle() function expects one argument." );
+				return false;
+			}
+
+			double useScriptOracle = 0.0;
+			if( !ScalarInterface::EvaluateScalarArgument( GetArgument( 0 ), 0, useScriptOracle, environment ) )
+				return false;
+
+			GAVisToolGeometry::UseScriptOracle( useScriptOracle != 0.0 );
+			break;
+		}
+		case VERIFY_NATIVE_GEOMETRY:
+		{
+			double trialCount = 100.0;
+			if( GetArgumentCount() > 0 && !ScalarInterface::EvaluateScalarArgument( GetArgument( 0 ), 0, trialCount, environment ) )
+				return false;
+
+			if( trialCount < 1.0 )
+			{
+				environment.AddError( "The verify_geometry() function expects a positive number of trials." );
+				return false;
+			}
+
+			VerifyNativeGeometry( int( trialCount ), visToolEnv );
+			break;
+		}
+		case BENCHMARK_PRODUCTS:
+		{
+			double productCount = 10000.0;
+			if( GetArgumentCount() > 0 && !ScalarInterface::EvaluateScalarArgument( GetArgument( 0 ), 0, productCount, environment ) )
+				return false;
+
+			if( productCount < 1.0 )
+			{
+				environment.AddError( "The bench_products() function expects a positive number of products." );
+				return false;
+			}
+
+			BenchmarkProducts( int( productCount ), visToolEnv );
+			break;
+		}
+	}
+
+	return true;
+}
+
+//=========================================================================================
+// Each geometry starts out as something simple, so we move it around to get a random one.
+/*static*/ void GAVisToolGeometryOracleFunctionEvaluator::Randomize( GAVisToolGeometry* geometry )
+{
+	// Rotating a transform only rotates its axis, so it would never get an angle.  Instead, give
+	// it a random motor, decomposed by the script so that the native code isn't checking itself.
+	if( geometry->IsTypeOf( ConformalTransformGeometry::ClassName() ) )
+	{
+		ConformalCoefficients coefficients;
+		RandomMotor( coefficients );
+
+		GeometricAlgebra::SumOfBlades element;
+		coefficients.AssignTo( element );
+
+		bool usingScriptOracle = GAVisToolGeometry::UsingScriptOracle();
+		GAVisToolGeometry::UseScriptOracle( true );
+		geometry->DecomposeFrom( element );
+		GAVisToolGeometry::UseScriptOracle( usingScriptOracle );
+		return;
+	}
+
+	VectorMath::Vector delta, unitAxis;
+	VectorMath::RandomVector( delta, -5.0, 5.0 );
+	do
+	{
+		VectorMath::RandomVector( unitAxis, -1.0, 1.0 );
+	}
+	while( VectorMath::Length( unitAxis ) < 0.1 );
+	VectorMath::Normalize( unitAxis, unitAxis );
+
+	geometry->Rotate( unitAxis, float( VectorMath::RandomNumber( -M_PI, M_PI ) ) );
+	geometry->Scale( float( VectorMath::RandomNumber( 0.5, 2.0 ) ) );
+	geometry->Translate( delta );
+}
+
+//=========================================================================================
+// This is w*T*R for a random weight w, translator T = 1 - 0.5*t*ni and rotor R = c - s*a*i,
+// multiplied out by the dense products rather than by the closed form of the transform.
+/*static*/ void GAVisToolGeometryOracleFunctionEvaluator::RandomMotor( ConformalCoefficients& coefficients )
+{
+	VectorMath::Vector translation, unitAxis;
+	VectorMath::RandomVector( translation, -5.0, 5.0 );
+	do
+	{
+		VectorMath::RandomVector( unitAxis, -1.0, 1.0 );
+	}
+	while( VectorMath::Length( unitAxis ) < 0.1 );
+	VectorMath::Normalize( unitAxis, unitAxis );
+
+	double halfAngle = 0.5 * VectorMath::RandomNumber( -M_PI, M_PI );
+	double s = sin( halfAngle );
+
+	ConformalCoefficients rotor, translator;
+	rotor.coefficient[0] = cos( halfAngle );
+	rotor.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::E3 ] = -s * unitAxis.x;
+	rotor.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E3 ] = s * unitAxis.y;
+	rotor.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E2 ] = -s * unitAxis.z;
+
+	translator.coefficient[0] = 1.0;
+	translator.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::NI ] = -0.5 * translation.x;
+	translator.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::NI ] = -0.5 * translation.y;
+	translator.coefficient[ ConformalCoefficients::E3 | ConformalCoefficients::NI ] = -0.5 * translation.z;
+
+	coefficients.AssignGeometricProduct( translator, rotor );
+	coefficients.Scale( VectorMath::RandomNumber( 0.5, 2.0 ) );
+}
+
+//=========================================================================================
+/*static*/ double GAVisToolGeometryOracleFunctionEvaluator::MaxDifference( const GeometricAlgebra::SumOfBlades& element, const GeometricAlgebra::SumOfBlades& otherElement )
+{
+	ConformalCoefficients coefficients, otherCoefficients;
+	coefficients.AssignFrom( element );
+	otherCoefficients.AssignFrom( otherElement );
+
+	return coefficients.MaxDifference( otherCoefficients );
+}
+
+//=========================================================================================
+// A negative grade gives us a random multivector with every coefficient filled in.
+/*static*/ void GAVisToolGeometryOracleFunctionEvaluator::Randomize( ConformalCoefficients& coefficients, int grade )
+{
+	for( int blade = 0; blade < ConformalCoefficients::BLADE_COUNT; blade++ )
+	{
+		if( grade < 0 || ConformalCoefficients::Grade( blade ) == grade )
+			coefficients.coefficient[ blade ] = VectorMath::RandomNumber( -1.0, 1.0 );
+		else
+			coefficients.coefficient[ blade ] = 0.0;
+	}
+}
+
+//=========================================================================================
+// The scripts are the reference here.  Compositions are compared directly.  Decompositions
+// are compared by decomposing the same element both ways and then recomposing each result
+// the same way, which compares every parameter of the geometry without our needing to see it.
+void GAVisToolGeometryOracleFunctionEvaluator::VerifyNativeGeometry( int trialCount, GAVisToolEnvironment* visToolEnv )
+{
+	struct GeometryType
+	{
+		const char* name;
+		GAVisToolBindTarget::CreationFunction creationFunction;
+		bool hasDualForm;
+	};
+
+	static GeometryType geometryTypeArray[] =
+	{
+		{ "point", &ConformalPoint::Create, true },
+		{ "sphere", &ConformalSphere::Create, true },
+		{ "circle", &ConformalCircle::Create, true },
+		{ "point-pair", &ConformalPointPair::Create, true },
+		{ "flat-point", &ConformalFlatPoint::Create, true },
+		{ "line", &ConformalLine::Create, true },
+		{ "plane", &ConformalPlane::Create, true },
+		{ "transform", &ConformalTransformGeometry::Create, false },
+	};
+
+	static const double tolerance = 1e-6;
+
+	bool usingScriptOracle = GAVisToolGeometry::UsingScriptOracle();
+	int failureCount = 0;
+
+	visToolEnv->Print( "Checking native geometry code against the scripts with %d trial(s) per type...\n", trialCount );
+
+	for( int index = 0; index < sizeof( geometryTypeArray ) / sizeof( GeometryType ); index++ )
+	{
+		const GeometryType& geometryType = geometryTypeArray[ index ];
+
+		for( int form = 0; form < ( geometryType.hasDualForm ? 2 : 1 ); form++ )
+		{
+			GAVisToolBindTarget::BindType bindType = GAVisToolBindTarget::DOESNT_MATTER;
+			if( geometryType.hasDualForm )
+				bindType = ( form == 0 ) ? GAVisToolBindTarget::DUAL_FORM : GAVisToolBindTarget::NORMAL_FORM;
+
+			GAVisToolGeometry* geometry = ( GAVisToolGeometry* )geometryType.creationFunction( bindType );
+			GAVisToolGeometry* scriptGeometry = ( GAVisToolGeometry* )geometryType.creationFunction( bindType );
+			GAVisToolGeometry* nativeGeometry = ( GAVisToolGeometry* )geometryType.creationFunction( bindType );
+
+			double maxCompositionDifference = 0.0;
+			double maxDecompositionDifference = 0.0;
+			double scriptTime = 0.0, nativeTime = 0.0;
+
+			for( int trial = 0; trial < trialCount; trial++ )
+			{
+				Randomize( geometry );
+
+				GeometricAlgebra::SumOfBlades scriptElement, nativeElement;
+				wxStopWatch stopWatch;
+
+				GAVisToolGeometry::UseScriptOracle( true );
+				stopWatch.Start();
+				geometry->ComposeTo( scriptElement );
+				scriptGeometry->DecomposeFrom( scriptElement );
+				scriptTime += stopWatch.TimeInMicro().ToDouble();
+
+				GAVisToolGeometry::UseScriptOracle( false );
+				stopWatch.Start();
+				geometry->ComposeTo( nativeElement );
+				nativeGeometry->DecomposeFrom( scriptElement );
+				nativeTime += stopWatch.TimeInMicro().ToDouble();
+
+				double difference = MaxDifference( scriptElement, nativeElement );
+				if( difference > maxCompositionDifference )
+					maxCompositionDifference = difference;
+
+				scriptGeometry->ComposeTo( scriptElement );
+				nativeGeometry->ComposeTo( nativeElement );
+
+				difference = MaxDifference( scriptElement, nativeElement );
+				if( difference > maxDecompositionDifference )
+					maxDecompositionDifference = difference;
+			}
+
+			delete geometry;
+			delete scriptGeometry;
+			delete nativeGeometry;
+
+			bool passed = ( maxCompositionDifference <= tolerance && maxDecompositionDifference <= tolerance );
+			if( !passed )
+				failureCount++;
+
+			const char* formName = "any";
+			if( bindType == GAVisToolBindTarget::NORMAL_FORM )
+				formName = "normal";
+			else if( bindType == GAVisToolBindTarget::DUAL_FORM )
+				formName = "dual";
+
+			visToolEnv->Print( "%s (%s form): %s (max differences: %g composing, %g decomposing)\n",
+							geometryType.name, formName,
+							( passed ? "ok" : "MISMATCH" ), maxCompositionDifference, maxDecompositionDifference );
+			visToolEnv->Print( "   script: %1.2f us/call, native: %1.2f us/call, speedup: %1.1fx\n",
+							scriptTime / double( 2 * trialCount ), nativeTime / double( 2 * trialCount ),
+							( nativeTime > 0.0 ? scriptTime / nativeTime : 0.0 ) );
+		}
+	}
+
+	GAVisToolGeometry::UseScriptOracle( usingScriptOracle );
+
+	if( !VerifyTransformPoints( trialCount, visToolEnv ) )
+		failureCount++;
+
+	if( failureCount == 0 )
+		visToolEnv->Print( "The native geometry code agrees with the scripts.\n" );
+	else
+		visToolEnv->Print( "The native geometry code disagrees with the scripts for %d type(s)!\n", failureCount );
+}
+
+//=========================================================================================
+// The batched application of a transform is checked against sandwiching each point with the
+// dense products, which is how we'd otherwise have to apply a motor to a bunch of points.
+bool GAVisToolGeometryOracleFunctionEvaluator::VerifyTransformPoints( int pointCount, GAVisToolEnvironment* visToolEnv )
+{
+	static const double tolerance = 1e-6;
+
+	ConformalCoefficients motor, reverseMotor;
+	RandomMotor( motor );
+	reverseMotor.AssignReverse( motor );
+
+	GeometricAlgebra::SumOfBlades element;
+	motor.AssignTo( element );
+
+	ConformalTransformGeometry* transform = ( ConformalTransformGeometry* )ConformalTransformGeometry::Create( GAVisToolBindTarget::DOESNT_MATTER );
+	transform->DecomposeFrom( element );
+
+	VectorMath::Vector* points = new VectorMath::Vector[ pointCount ];
+	VectorMath::Vector* transformedPoints = new VectorMath::Vector[ pointCount ];
+	for( int index = 0; index < pointCount; index++ )
+		VectorMath::RandomVector( points[ index ], -5.0, 5.0 );
+
+	wxStopWatch stopWatch;
+	transform->TransformPoints( points, transformedPoints, pointCount );
+	double batchTime = stopWatch.TimeInMicro().ToDouble();
+
+	double maxDifference = 0.0;
+	double sandwichTime = 0.0;
+
+	for( int index = 0; index < pointCount; index++ )
+	{
+		const VectorMath::Vector& point = points[ index ];
+
+		stopWatch.Start();
+		ConformalCoefficients coefficients;
+		coefficients.coefficient[ ConformalCoefficients::NO ] = 1.0;
+		coefficients.coefficient[ ConformalCoefficients::E1 ] = point.x;
+		coefficients.coefficient[ ConformalCoefficients::E2 ] = point.y;
+		coefficients.coefficient[ ConformalCoefficients::E3 ] = point.z;
+		coefficients.coefficient[ ConformalCoefficients::NI ] = 0.5 * VectorMath::Dot( point, point );
+		coefficients.AssignGeometricProduct( motor, coefficients );
+		coefficients.AssignGeometricProduct( coefficients, reverseMotor );
+		double weight = coefficients.coefficient[ ConformalCoefficients::NO ];
+		VectorMath::Vector sandwichedPoint;
+		VectorMath::Set( sandwichedPoint,
+			coefficients.coefficient[ ConformalCoefficients::E1 ] / weight,
+			coefficients.coefficient[ ConformalCoefficients::E2 ] / weight,
+			coefficients.coefficient[ ConformalCoefficients::E3 ] / weight );
+		sandwichTime += stopWatch.TimeInMicro().ToDouble();
+
+		double difference = VectorMath::Distance( sandwichedPoint, transformedPoints[ index ] );
+		if( difference > maxDifference )
+			maxDifference = difference;
+	}
+
+	delete[] points;
+	delete[] transformedPoints;
+	delete transform;
+
+	bool passed = ( maxDifference <= tolerance );
+
+	visToolEnv->Print( "transform points: %s (max difference: %g)\n", ( passed ? "ok" : "MISMATCH" ), maxDifference );
+	visToolEnv->Print( "   sandwich: %1.3f us/point, batch: %1.3f us/point, speedup: %1.1fx\n",
+					sandwichTime / double( pointCount ), batchTime / double( pointCount ),
+					( batchTime > 0.0 ? sandwichTime / batchTime : 0.0 ) );
+
+	return passed;
+}
+
+//=========================================================================================
+// The geometries mostly multiply elements of a single grade, so that's what we time, along
+// with full multivectors, which is the worst case for the dense products.
+void GAVisToolGeometryOracleFunctionEvaluator::BenchmarkProducts( int productCount, GAVisToolEnvironment* visToolEnv )
+{
+	struct ProductCase
+	{
+		const char* name;
+		int leftGrade, rightGrade;
+	};
+
+	static ProductCase productCaseArray[] =
+	{
+		{ "vector * vector", 1, 1 },
+		{ "vector * 4-vector", 1, 4 },
+		{ "bivector * trivector", 2, 3 },
+		{ "multivector * multivector", -1, -1 },
+	};
+
+	static const double tolerance = 1e-9;
+
+	visToolEnv->Print( "Timing %d geometric product(s) per case, dense versus sums of blades...\n", productCount );
+
+	for( int index = 0; index < sizeof( productCaseArray ) / sizeof( ProductCase ); index++ )
+	{
+		const ProductCase& productCase = productCaseArray[ index ];
+
+		ConformalCoefficients left, right, denseProduct, sparseProductCoefficients;
+		Randomize( left, productCase.leftGrade );
+		Randomize( right, productCase.rightGrade );
+
+		GeometricAlgebra::SumOfBlades sparseLeft, sparseRight, sparseProduct;
+		left.AssignTo( sparseLeft );
+		right.AssignTo( sparseRight );
+
+		wxStopWatch stopWatch;
+		for( int count = 0; count < productCount; count++ )
+			denseProduct.AssignGeometricProduct( left, right );
+		double denseTime = stopWatch.TimeInMicro().ToDouble();
+
+		stopWatch.Start();
+		for( int count = 0; count < productCount; count++ )
+			sparseProduct.AssignGeometricProduct( sparseLeft, sparseRight );
+		double sparseTime = stopWatch.TimeInMicro().ToDouble();
+
+		sparseProductCoefficients.AssignFrom( sparseProduct );
+		double difference = denseProduct.MaxDifference( sparseProductCoefficients );
+
+		visToolEnv->Print( "%s: %s (max difference: %g)\n", productCase.name, ( difference <= tolerance ? "ok" : "MISMATCH" ), difference );
+		visToolEnv->Print( "   sum of blades: %1.3f us/product, dense: %1.3f us/product, speedup: %1.1fx\n",
+						sparseTime / double( productCount ), denseTime / double( productCount ),
+						( denseTime > 0.0 ? sparseTime / denseTime : 0.0 ) );
+	}
+}
+
+// GeometryOracleFunction.cpp
\ No newline at end of file
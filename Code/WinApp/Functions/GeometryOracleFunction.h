@@ -0,0 +1,51 @@
+// GeometryOracleFunction.h
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#pragma once
+
+#include "Calculator/CalcLib.h"
+#include "../Geometry.h"
+
+class GAVisToolEnvironment;
+
+//=========================================================================================
+class GAVisToolGeometryOracleFunctionEvaluator : public CalcLib::FunctionEvaluator
+{
+	DECLARE_CALCLIB_CLASS( GAVisToolGeometryOracleFunctionEvaluator );
+
+public:
+
+	enum FuncType
+	{
+		USE_SCRIPT_ORACLE,
+		VERIFY_NATIVE_GEOMETRY,
+		BENCHMARK_PRODUCTS,
+	};
+
+	GAVisToolGeometryOracleFunctionEvaluator( FuncType funcType );
+	virtual ~GAVisToolGeometryOracleFunctionEvaluator( void );
+	static CalcLib::FunctionEvaluator* Create( int funcType );
+	virtual bool EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment );
+
+private:
+
+	void VerifyNativeGeometry( int trialCount, GAVisToolEnvironment* visToolEnv );
+	bool VerifyTransformPoints( int pointCount, GAVisToolEnvironment* visToolEnv );
+	void BenchmarkProducts( int productCount, GAVisToolEnvironment* visToolEnv );
+	static void RandomMotor( ConformalCoefficients& coefficients );
+	static void Randomize( ConformalCoefficients& coefficients, int grade );
+	static void Randomize( GAVisToolGeometry* geometry );
+	static double MaxDifference( const GeometricAlgebra::SumOfBlades& element, const GeometricAlgebra::SumOfBlades& otherElement );
+
+	FuncType funcType;
+};
+
+// GeometryOracleFunction.h
\ No newline at end of file
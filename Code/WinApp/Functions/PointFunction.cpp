@@ -10,27 +10,37 @@
  */
 
 #include "PointFunction.h"
+#include "../FunctionRegistry.h"
 #include "../Environment.h"
 #include "../Application.h"
+#include "../EvaluatorCache.h"
+#include "../ScratchEnvironment.h"
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( GAVisToolPointFunctionEvaluator, FunctionEvaluator );
 
 //=========================================================================================
-GAVisToolPointFunctionEvaluator::GAVisToolPointFunctionEvaluator( void )
-{
-	CalcLib::Calculator calculator( "geoalg" );
+static GAVisToolFunctionRegistry::Registrar pointRegistrar( "point", &GAVisToolPointFunctionEvaluator::Create );
 
-	char evaluatorCode[ 256 ];
-	strcpy_s( evaluatorCode, sizeof( evaluatorCode ), "no + point + 0.5*(point.point)*ni" );
+//=========================================================================================
+/*static*/ const char* GAVisToolPointFunctionEvaluator::evaluatorCode = "no + point + 0.5*(point.point)*ni";
 
-	evaluator = calculator.CompileEvaluator( evaluatorCode );
+//=========================================================================================
+GAVisToolPointFunctionEvaluator::GAVisToolPointFunctionEvaluator( void )
+{
+	evaluatorLock = 0;
+	evaluator = GAVisToolEvaluatorCache::Lookup( evaluatorCode, &evaluatorLock );
 }
 
 //=========================================================================================
 /*virtual*/ GAVisToolPointFunctionEvaluator::~GAVisToolPointFunctionEvaluator( void )
 {
-	delete evaluator;
+}
+
+//=========================================================================================
+/*static*/ CalcLib::FunctionEvaluator* GAVisToolPointFunctionEvaluator::Create( int funcType )
+{
+	return new GAVisToolPointFunctionEvaluator();
 }
 
 //=========================================================================================
@@ -47,10 +57,13 @@ GAVisToolPointFunctionEvaluator::GAVisToolPointFunctionEvaluator( void )
 		if( !argument->EvaluateResult( result, environment ) )
 			break;
 		
-		CalcLib::GeometricAlgebraEnvironment gaEnv;
+		GAVisToolScratchEnvironment::Loan loan;
+		GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 		if( !gaEnv.StoreVariable( "point", result ) )
 			break;
 
+		// Constraints may call us on the solver thread while the console calls us on the main thread.
+		wxCriticalSectionLocker locker( *evaluatorLock );
 		if( !evaluator->EvaluateResult( result, gaEnv ) )
 			break;
 
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "Calculator/CalcLib.h"
+#include "../wxAll.h"
 
 //=========================================================================================
 class GAVisToolPointFunctionEvaluator : public CalcLib::FunctionEvaluator
@@ -20,9 +21,12 @@ class GAVisToolPointFunctionEvaluator : public CalcLib::FunctionEvaluator
 public:
 	GAVisToolPointFunctionEvaluator( void );
 	virtual ~GAVisToolPointFunctionEvaluator( void );
+	static CalcLib::FunctionEvaluator* Create( int funcType );
 	virtual bool EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment );
+	static const char* evaluatorCode;
 private:
 	CalcLib::Evaluator* evaluator;
+	wxCriticalSection* evaluatorLock;
 };
 
 // PointFunction.h
\ No newline at end of file
@@ -10,17 +10,21 @@
  */
 
 #include "ReduceBivectorFunction.h"
+#include "../FunctionRegistry.h"
 #include "../Environment.h"
 #include "../Application.h"
+#include "../EvaluatorCache.h"
+#include "../ScratchEnvironment.h"
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( GAVisToolReduceBivectorFunctionEvaluator, FunctionEvaluator );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar reduceBivectorRegistrar( "reduce_bivector", &GAVisToolReduceBivectorFunctionEvaluator::Create );
+
 //=========================================================================================
 GAVisToolReduceBivectorFunctionEvaluator::GAVisToolReduceBivectorFunctionEvaluator( void )
 {
-	CalcLib::Calculator calculator( "geoalg" );
-
 	char reductionCode[ 2*1024 ];
 	strcpy_s( reductionCode, sizeof( reductionCode ),
 		"do("
@@ -79,13 +83,19 @@ GAVisToolReduceBivectorFunctionEvaluator::GAVisToolReduceBivectorFunctionEvaluat
 		")"
 	);
 
-	reductionEvaluator = calculator.CompileEvaluator( reductionCode );
+	reductionEvaluatorLock = 0;
+	reductionEvaluator = GAVisToolEvaluatorCache::Lookup( reductionCode, &reductionEvaluatorLock );
 }
 
 //=========================================================================================
 /*virtual*/ GAVisToolReduceBivectorFunctionEvaluator::~GAVisToolReduceBivectorFunctionEvaluator( void )
 {
-	delete reductionEvaluator;
+}
+
+//=========================================================================================
+/*static*/ CalcLib::FunctionEvaluator* GAVisToolReduceBivectorFunctionEvaluator::Create( int funcType )
+{
+	return new GAVisToolReduceBivectorFunctionEvaluator();
 }
 
 //=========================================================================================
@@ -105,10 +115,12 @@ GAVisToolReduceBivectorFunctionEvaluator::GAVisToolReduceBivectorFunctionEvaluat
 		if( !argument->EvaluateResult( result, environment ) )
 			break;
 		
-		CalcLib::GeometricAlgebraEnvironment gaEnv;
+		GAVisToolScratchEnvironment::Loan loan;
+		GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 		if( !gaEnv.StoreVariable( "bivector", result ) )
 			break;
 
+		wxCriticalSectionLocker locker( *reductionEvaluatorLock );
 		if( !reductionEvaluator->EvaluateResult( result, gaEnv ) )
 			break;
 
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "Calculator/CalcLib.h"
+#include "../wxAll.h"
 
 //=========================================================================================
 class GAVisToolReduceBivectorFunctionEvaluator : public CalcLib::FunctionEvaluator
@@ -20,9 +21,11 @@ class GAVisToolReduceBivectorFunctionEvaluator : public CalcLib::FunctionEvaluat
 public:
 	GAVisToolReduceBivectorFunctionEvaluator( void );
 	virtual ~GAVisToolReduceBivectorFunctionEvaluator( void );
+	static CalcLib::FunctionEvaluator* Create( int funcType );
 	virtual bool EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment );
 private:
 	CalcLib::Evaluator* reductionEvaluator;
+	wxCriticalSection* reductionEvaluatorLock;
 };
 
 // ReduceBivectorFunction.h
\ No newline at end of file
@@ -0,0 +1,79 @@
+// ScratchStatsFunction.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "ScratchStatsFunction.h"
+#include "../FunctionRegistry.h"
+#include "../Environment.h"
+#include "../ScratchEnvironment.h"
+#include "../EvaluatorCache.h"
+
+//=========================================================================================
+IMPLEMENT_CALCLIB_CLASS1( GAVisToolScratchStatsFunctionEvaluator, FunctionEvaluator );
+
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar scratchStatsRegistrar( "scratch_stats", &GAVisToolScratchStatsFunctionEvaluator::Create );
+
+//=========================================================================================
+GAVisToolScratchStatsFunctionEvaluator::GAVisToolScratchStatsFunctionEvaluator( void )
+{
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolScratchStatsFunctionEvaluator::~GAVisToolScratchStatsFunctionEvaluator( void )
+{
+}
+
+//=========================================================================================
+/*static*/ CalcLib::FunctionEvaluator* GAVisToolScratchStatsFunctionEvaluator::Create( int funcType )
+{
+	return new GAVisToolScratchStatsFunctionEvaluator();
+}
+
+//=========================================================================================
+// Usage: scratch_stats() reports how many times the geometries have borrowed a scratch
+// environment against how many allocations that has cost us.  Before the environments were
+// pooled, every loan would have cost an environment, a number and a variable per input and
+// output of the script.  It also reports how often a script was compiled against how often
+// it was asked for, so that running something like PointFitTest.txt in between two calls
+// to this shows what the shared evaluators of point() and friends are saving us.
+/*virtual*/ bool GAVisToolScratchStatsFunctionEvaluator::EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment )
+{
+	if( !result.AssignAdditiveIdentity( environment ) )
+		return false;
+
+	GAVisToolEnvironment* visToolEnv = environment.Cast< GAVisToolEnvironment >();
+	if( !visToolEnv )
+	{
+		environment.AddError( "The scratch_stats() function only operates within the GAVisTool environment." );
+		return false;
+	}
+
+	GAVisToolScratchEnvironment::Stats stats;
+	GAVisToolScratchEnvironment::GetStats( stats );
+
+	int allocationCount = stats.environmentCount + stats.numberCount + stats.variableCount;
+
+	visToolEnv->Print( "Scratch environments were loaned out %d times.\n", stats.loanCount );
+	visToolEnv->Print( "Allocated: %d environments, %d numbers, %d variables.\n", stats.environmentCount, stats.numberCount, stats.variableCount );
+	if( stats.loanCount > 0 )
+		visToolEnv->Print( "That's %1.3f allocations per loan.\n", double( allocationCount ) / double( stats.loanCount ) );
+
+	GAVisToolEvaluatorCache::Stats cacheStats;
+	GAVisToolEvaluatorCache::GetStats( cacheStats );
+
+	visToolEnv->Print( "Compiled scripts were asked for %d times and compiled %d times into %d evaluators.\n",
+						cacheStats.hitCount + cacheStats.missCount, cacheStats.missCount, cacheStats.evaluatorCount );
+	visToolEnv->Print( "Compiling took %1.2f ms in all.\n", cacheStats.compileTime / 1000.0 );
+
+	return true;
+}
+
+// ScratchStatsFunction.cpp
\ No newline at end of file
@@ -0,0 +1,29 @@
+// ScratchStatsFunction.h
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#pragma once
+
+#include "Calculator/CalcLib.h"
+
+//=========================================================================================
+class GAVisToolScratchStatsFunctionEvaluator : public CalcLib::FunctionEvaluator
+{
+	DECLARE_CALCLIB_CLASS( GAVisToolScratchStatsFunctionEvaluator );
+
+public:
+
+	GAVisToolScratchStatsFunctionEvaluator( void );
+	virtual ~GAVisToolScratchStatsFunctionEvaluator( void );
+	static CalcLib::FunctionEvaluator* Create( int funcType );
+	virtual bool EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment );
+};
+
+// ScratchStatsFunction.h
\ No newline at end of file
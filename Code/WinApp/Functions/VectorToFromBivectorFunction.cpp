@@ -10,19 +10,24 @@
  */
 
 #include "VectorToFromBivectorFunction.h"
+#include "../FunctionRegistry.h"
 #include "../Environment.h"
 #include "../Application.h"
+#include "../EvaluatorCache.h"
+#include "../ScratchEnvironment.h"
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( GAVisToolVectorToFromBivectorFunctionEvaluator, FunctionEvaluator );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar asVectorRegistrar( "as_vector", &GAVisToolVectorToFromBivectorFunctionEvaluator::Create, GAVisToolVectorToFromBivectorFunctionEvaluator::CONVERT_VECTOR_FROM_BIVECTOR );
+static GAVisToolFunctionRegistry::Registrar asBivectorRegistrar( "as_bivector", &GAVisToolVectorToFromBivectorFunctionEvaluator::Create, GAVisToolVectorToFromBivectorFunctionEvaluator::CONVERT_VECTOR_TO_BIVECTOR );
+
 //=========================================================================================
 GAVisToolVectorToFromBivectorFunctionEvaluator::GAVisToolVectorToFromBivectorFunctionEvaluator( FuncType funcType )
 {
 	this->funcType = funcType;
 
-	CalcLib::Calculator calculator( "geoalg" );
-
 	char conversionCode[ 5*1024 ];
 	conversionCode[0] = '\0';
 
@@ -97,13 +102,19 @@ GAVisToolVectorToFromBivectorFunctionEvaluator::GAVisToolVectorToFromBivectorFun
 		);
 	}
 
-	conversionEvaluator = calculator.CompileEvaluator( conversionCode );
+	conversionEvaluatorLock = 0;
+	conversionEvaluator = GAVisToolEvaluatorCache::Lookup( conversionCode, &conversionEvaluatorLock );
 }
 
 //=========================================================================================
 /*virtual*/ GAVisToolVectorToFromBivectorFunctionEvaluator::~GAVisToolVectorToFromBivectorFunctionEvaluator( void )
 {
-	delete conversionEvaluator;
+}
+
+//=========================================================================================
+/*static*/ CalcLib::FunctionEvaluator* GAVisToolVectorToFromBivectorFunctionEvaluator::Create( int funcType )
+{
+	return new GAVisToolVectorToFromBivectorFunctionEvaluator( FuncType( funcType ) );
 }
 
 //=========================================================================================
@@ -120,10 +131,12 @@ GAVisToolVectorToFromBivectorFunctionEvaluator::GAVisToolVectorToFromBivectorFun
 		if( !argument->EvaluateResult( result, environment ) )
 			break;
 		
-		CalcLib::GeometricAlgebraEnvironment gaEnv;
+		GAVisToolScratchEnvironment::Loan loan;
+		GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 		if( !gaEnv.StoreVariable( "element", result ) )
 			break;
 
+		wxCriticalSectionLocker locker( *conversionEvaluatorLock );
 		if( !conversionEvaluator->EvaluateResult( result, gaEnv ) )
 			break;
 
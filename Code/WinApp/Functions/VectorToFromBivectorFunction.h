@@ -12,6 +12,7 @@
 #pragma once
 
 #include "Calculator/CalcLib.h"
+#include "../wxAll.h"
 
 //=========================================================================================
 class GAVisToolVectorToFromBivectorFunctionEvaluator : public CalcLib::FunctionEvaluator
@@ -25,10 +26,12 @@ public:
 	};
 	GAVisToolVectorToFromBivectorFunctionEvaluator( FuncType funcType );
 	virtual ~GAVisToolVectorToFromBivectorFunctionEvaluator( void );
+	static CalcLib::FunctionEvaluator* Create( int funcType );
 	virtual bool EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment );
 private:
 	FuncType funcType;
 	CalcLib::Evaluator* conversionEvaluator;
+	wxCriticalSection* conversionEvaluatorLock;
 };
 
 // VectorToFromBivectorFunction.h
\ No newline at end of file
@@ -10,12 +10,16 @@
  */
 
 #include "WipeEnvFunction.h"
+#include "../FunctionRegistry.h"
 #include "../Environment.h"
 #include "../Application.h"
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( GAVisToolWipeEnvFunctionEvaluator, FunctionEvaluator );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar wipeEnvRegistrar( "wipe_env", &GAVisToolWipeEnvFunctionEvaluator::Create );
+
 //=========================================================================================
 GAVisToolWipeEnvFunctionEvaluator::GAVisToolWipeEnvFunctionEvaluator( void )
 {
@@ -26,6 +30,12 @@ GAVisToolWipeEnvFunctionEvaluator::GAVisToolWipeEnvFunctionEvaluator( void )
 {
 }
 
+//=========================================================================================
+/*static*/ CalcLib::FunctionEvaluator* GAVisToolWipeEnvFunctionEvaluator::Create( int funcType )
+{
+	return new GAVisToolWipeEnvFunctionEvaluator();
+}
+
 //=========================================================================================
 /*virtual*/ bool GAVisToolWipeEnvFunctionEvaluator::EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment )
 {
@@ -23,6 +23,7 @@ public:
 
 	GAVisToolWipeEnvFunctionEvaluator( void );
 	virtual ~GAVisToolWipeEnvFunctionEvaluator( void );
+	static CalcLib::FunctionEvaluator* Create( int funcType );
 	virtual bool EvaluateResult( CalcLib::Number& result, CalcLib::Environment& environment );
 };
 
@@ -0,0 +1,565 @@
+// ConformalBlades.h
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#pragma once
+
+#include "ConformalCoefficients.h"
+#include "../VectorMath/Vector.h"
+
+//=========================================================================================
+// These are elements of the conformal model whose grades are known at compile time.  The
+// template argument is a mask of the grades an element may have, so that a vector has the
+// mask GRADE_1, and a motor, GRADE_0 | GRADE_2 | GRADE_4.  Only the coefficients of those
+// grades are stored, and a product only computes the terms that can contribute to it, with
+// all of the signs and indices worked out by the compiler.  Everything here is unrolled.
+//
+// Unlike the dense coefficients, which are taken in the null basis, these are taken in the
+// orthogonal basis { e1, e2, e3, e+, e- }, where e+ and e- square to 1 and -1, respectively.
+// There, the product of two blades is always plus or minus a single blade.  The vectors e+
+// and e- take the places of no and ni in the bit-masks of the blades.  Converting to and
+// from the null basis is cheap, because only the no and ni parts of a blade get mixed up.
+namespace ConformalBladesMeta
+{
+	enum
+	{
+		E1 = ConformalCoefficients::E1,
+		E2 = ConformalCoefficients::E2,
+		E3 = ConformalCoefficients::E3,
+		EP = ConformalCoefficients::NO,
+		EM = ConformalCoefficients::NI,
+		BLADE_COUNT = ConformalCoefficients::BLADE_COUNT,
+	};
+
+	enum Product
+	{
+		GEOMETRIC_PRODUCT,
+		OUTER_PRODUCT,
+		INNER_PRODUCT,
+	};
+
+	//=========================================================================================
+	template< int blade >
+	struct Grade
+	{
+		enum { value = ( blade & 1 ) + Grade< ( blade >> 1 ) >::value };
+	};
+
+	template<>
+	struct Grade<0>
+	{
+		enum { value = 0 };
+	};
+
+	//=========================================================================================
+	template< int gradeMask, int blade >
+	struct InGradeSet
+	{
+		enum { value = ( gradeMask >> Grade< blade >::value ) & 1 };
+	};
+
+	//=========================================================================================
+	// This is where the given blade lives in the storage of an element with the given grades.
+	template< int gradeMask, int blade >
+	struct Index
+	{
+		enum { value = Index< gradeMask, blade - 1 >::value + InGradeSet< gradeMask, blade - 1 >::value };
+	};
+
+	template< int gradeMask >
+	struct Index< gradeMask, 0 >
+	{
+		enum { value = 0 };
+	};
+
+	template< int gradeMask >
+	struct Size
+	{
+		enum { value = Index< gradeMask, BLADE_COUNT >::value };
+	};
+
+	//=========================================================================================
+	// Bringing the vectors of the product of two blades into canonical order takes one swap
+	// for every pair of a vector of the right blade that precedes one of the left blade.
+	template< int leftBlade, int rightBlade >
+	struct ReorderingSign
+	{
+		enum
+		{
+			swapCount = Grade< ( leftBlade >> 1 ) & rightBlade >::value + Grade< ( leftBlade >> 2 ) & rightBlade >::value +
+						Grade< ( leftBlade >> 3 ) & rightBlade >::value + Grade< ( leftBlade >> 4 ) & rightBlade >::value,
+			value = ( swapCount & 1 ) ? -1 : 1,
+		};
+	};
+
+	//=========================================================================================
+	template< int leftBlade, int rightBlade, int product >
+	struct Term
+	{
+		enum
+		{
+			productBlade = leftBlade ^ rightBlade,
+			leftGrade = int( Grade< leftBlade >::value ),
+			rightGrade = int( Grade< rightBlade >::value ),
+			innerGrade = ( leftGrade > rightGrade ) ? ( leftGrade - rightGrade ) : ( rightGrade - leftGrade ),
+			metricSign = ( leftBlade & rightBlade & EM ) ? -1 : 1,
+			sign = ReorderingSign< leftBlade, rightBlade >::value * metricSign,
+			exists = ( product == GEOMETRIC_PRODUCT ) ||
+					( product == OUTER_PRODUCT && ( leftBlade & rightBlade ) == 0 ) ||
+					( product == INNER_PRODUCT && int( Grade< productBlade >::value ) == innerGrade ),
+		};
+	};
+
+	//=========================================================================================
+	// These are all of the grades that can show up in the given product of blades of the
+	// given grades.  The geometric product of an r-blade and an s-blade has grades |r-s|
+	// through r+s in steps of two, and can't have a grade that isn't there in 5 dimensions.
+	template< int low, int high >
+	struct GradeRange
+	{
+		enum { value = ( low > high ) ? 0 : ( ( 1 << low ) | GradeRange< ( low + 2 <= high ) ? low + 2 : 6, ( low + 2 <= high ) ? high : 0 >::value ) };
+	};
+
+	template<>
+	struct GradeRange< 6, 0 >
+	{
+		enum { value = 0 };
+	};
+
+	template< int leftGrade, int rightGrade, int product >
+	struct GradePairProduct
+	{
+		enum
+		{
+			low = ( leftGrade > rightGrade ) ? ( leftGrade - rightGrade ) : ( rightGrade - leftGrade ),
+			sum = leftGrade + rightGrade,
+			high = ( sum <= 5 ) ? sum : ( 10 - sum ),
+			value = ( product == GEOMETRIC_PRODUCT ) ? GradeRange< low, high >::value :
+					( product == OUTER_PRODUCT ) ? ( ( sum <= 5 ) ? ( 1 << sum ) : 0 ) : ( 1 << low ),
+		};
+	};
+
+	template< int leftGradeMask, int rightGradeMask, int product, int leftGrade = 0, int rightGrade = 0 >
+	struct ProductGrades
+	{
+		enum
+		{
+			present = ( ( leftGradeMask >> leftGrade ) & 1 ) && ( ( rightGradeMask >> rightGrade ) & 1 ),
+			value = ( present ? GradePairProduct< leftGrade, rightGrade, product >::value : 0 ) |
+					ProductGrades< leftGradeMask, rightGradeMask, product, ( rightGrade == 5 ) ? leftGrade + 1 : leftGrade, ( rightGrade == 5 ) ? 0 : rightGrade + 1 >::value,
+		};
+	};
+
+	template< int leftGradeMask, int rightGradeMask, int product >
+	struct ProductGrades< leftGradeMask, rightGradeMask, product, 6, 0 >
+	{
+		enum { value = 0 };
+	};
+}
+
+//=========================================================================================
+template< int gradeMask >
+class ConformalBlades
+{
+public:
+
+	enum
+	{
+		GRADE_MASK = gradeMask,
+		SIZE = ConformalBladesMeta::Size< gradeMask >::value,
+	};
+
+	ConformalBlades( void )
+	{
+		Zero();
+	}
+
+	void Zero( void )
+	{
+		for( int index = 0; index < SIZE; index++ )
+			coefficient[ index ] = 0.0;
+	}
+
+	// The blade is a bit-mask in the orthogonal basis, and must be one of ours.
+	double& operator[]( int blade );
+	double operator[]( int blade ) const;
+
+	// Whatever the dense coefficients have outside of our grades is ignored.
+	void AssignFrom( const ConformalCoefficients& coefficients );
+	void AssignTo( ConformalCoefficients& coefficients ) const;
+
+	// This takes the parts of the given element that are of our grades.
+	template< int otherGradeMask >
+	void AssignGradesFrom( const ConformalBlades< otherGradeMask >& element );
+
+	void AssignReverse( const ConformalBlades& element );
+	void Scale( double scale );
+
+	double coefficient[ SIZE ];
+};
+
+//=========================================================================================
+template< int leftGradeMask, int rightGradeMask, int product >
+struct ConformalProduct
+{
+	typedef ConformalBlades< ConformalBladesMeta::ProductGrades< leftGradeMask, rightGradeMask, product >::value > Type;
+};
+
+typedef ConformalBlades< 1 << 1 > ConformalVector;
+typedef ConformalBlades< 1 << 2 > ConformalBivector;
+typedef ConformalBlades< 1 << 3 > ConformalTrivector;
+typedef ConformalBlades< ( 1 << 0 ) | ( 1 << 2 ) | ( 1 << 4 ) > ConformalEvenVersor;
+
+namespace ConformalBladesMeta
+{
+	//=========================================================================================
+	// Visit every blade of the given grades.  The visitor gets the blade as a template
+	// argument, so that whatever it does with it can be worked out at compile time.
+	template< int gradeMask, typename Visitor, int blade = 0, bool visit = ( blade < BLADE_COUNT && InGradeSet< gradeMask, blade >::value != 0 ) >
+	struct ForEachBlade
+	{
+		static inline void Do( Visitor& visitor )
+		{
+			visitor.template Visit< blade >();
+			ForEachBlade< gradeMask, Visitor, blade + 1 >::Do( visitor );
+		}
+	};
+
+	template< int gradeMask, typename Visitor, int blade >
+	struct ForEachBlade< gradeMask, Visitor, blade, false >
+	{
+		static inline void Do( Visitor& visitor )
+		{
+			ForEachBlade< gradeMask, Visitor, blade + 1 >::Do( visitor );
+		}
+	};
+
+	template< int gradeMask, typename Visitor >
+	struct ForEachBlade< gradeMask, Visitor, BLADE_COUNT, false >
+	{
+		static inline void Do( Visitor& visitor )
+		{
+		}
+	};
+
+	//=========================================================================================
+	template< int leftBlade, int rightBlade, int product, int productGradeMask, bool exists = ( Term< leftBlade, rightBlade, product >::exists != 0 ) >
+	struct AccumulateTerm
+	{
+		template< typename Left, typename Right, typename Product >
+		static inline void Do( const Left& left, const Right& right, Product& productElement )
+		{
+			productElement.coefficient[ Index< productGradeMask, ( leftBlade ^ rightBlade ) >::value ] +=
+				double( Term< leftBlade, rightBlade, product >::sign ) *
+				left.coefficient[ Index< Left::GRADE_MASK, leftBlade >::value ] *
+				right.coefficient[ Index< Right::GRADE_MASK, rightBlade >::value ];
+		}
+	};
+
+	template< int leftBlade, int rightBlade, int product, int productGradeMask >
+	struct AccumulateTerm< leftBlade, rightBlade, product, productGradeMask, false >
+	{
+		template< typename Left, typename Right, typename Product >
+		static inline void Do( const Left& left, const Right& right, Product& productElement )
+		{
+		}
+	};
+
+	//=========================================================================================
+	template< typename Left, typename Right, typename Product, int product, int leftBlade >
+	struct RightVisitor
+	{
+		RightVisitor( const Left& left, const Right& right, Product& productElement ) : left( left ), right( right ), productElement( productElement ) {}
+
+		template< int rightBlade >
+		inline void Visit( void )
+		{
+			AccumulateTerm< leftBlade, rightBlade, product, Product::GRADE_MASK >::Do( left, right, productElement );
+		}
+
+		const Left& left;
+		const Right& right;
+		Product& productElement;
+	};
+
+	template< typename Left, typename Right, typename Product, int product >
+	struct LeftVisitor
+	{
+		LeftVisitor( const Left& left, const Right& right, Product& productElement ) : left( left ), right( right ), productElement( productElement ) {}
+
+		template< int leftBlade >
+		inline void Visit( void )
+		{
+			RightVisitor< Left, Right, Product, product, leftBlade > visitor( left, right, productElement );
+			ForEachBlade< Right::GRADE_MASK, RightVisitor< Left, Right, Product, product, leftBlade > >::Do( visitor );
+		}
+
+		const Left& left;
+		const Right& right;
+		Product& productElement;
+	};
+
+	//=========================================================================================
+	template< int product, int leftGradeMask, int rightGradeMask >
+	inline typename ConformalProduct< leftGradeMask, rightGradeMask, product >::Type Multiply( const ConformalBlades< leftGradeMask >& left, const ConformalBlades< rightGradeMask >& right )
+	{
+		typedef ConformalBlades< leftGradeMask > Left;
+		typedef ConformalBlades< rightGradeMask > Right;
+		typedef typename ConformalProduct< leftGradeMask, rightGradeMask, product >::Type Product;
+
+		Product productElement;
+		LeftVisitor< Left, Right, Product, product > visitor( left, right, productElement );
+		ForEachBlade< leftGradeMask, LeftVisitor< Left, Right, Product, product > >::Do( visitor );
+		return productElement;
+	}
+
+	//=========================================================================================
+	template< int blade, bool exists >
+	struct CopyBlade
+	{
+		template< typename OtherElement >
+		static inline double Do( const OtherElement& otherElement )
+		{
+			return otherElement.coefficient[ Index< OtherElement::GRADE_MASK, blade >::value ];
+		}
+	};
+
+	template< int blade >
+	struct CopyBlade< blade, false >
+	{
+		template< typename OtherElement >
+		static inline double Do( const OtherElement& otherElement )
+		{
+			return 0.0;
+		}
+	};
+
+	template< typename Element, typename OtherElement >
+	struct GradesVisitor
+	{
+		GradesVisitor( Element& element, const OtherElement& otherElement ) : element( element ), otherElement( otherElement ) {}
+
+		template< int blade >
+		inline void Visit( void )
+		{
+			element.coefficient[ Index< Element::GRADE_MASK, blade >::value ] =
+				CopyBlade< blade, ( InGradeSet< OtherElement::GRADE_MASK, blade >::value != 0 ) >::Do( otherElement );
+		}
+
+		Element& element;
+		const OtherElement& otherElement;
+	};
+
+	//=========================================================================================
+	template< typename Element >
+	struct ReverseVisitor
+	{
+		ReverseVisitor( Element& element, const Element& otherElement ) : element( element ), otherElement( otherElement ) {}
+
+		template< int blade >
+		inline void Visit( void )
+		{
+			enum { grade = Grade< blade >::value, sign = ( ( grade * ( grade - 1 ) / 2 ) & 1 ) ? -1 : 1 };
+			element.coefficient[ Index< Element::GRADE_MASK, blade >::value ] = double( sign ) * otherElement.coefficient[ Index< Element::GRADE_MASK, blade >::value ];
+		}
+
+		Element& element;
+		const Element& otherElement;
+	};
+
+	//=========================================================================================
+	// Only the no and ni parts of a blade change with the basis.  In the null basis, no = ( e- - e+ )/2,
+	// ni = e- + e+ and no^ni = -e+^e-.  Going the other way, e+ = ni/2 - no, e- = ni/2 + no and e+^e- = -no^ni.
+	template< typename Element >
+	struct FromNullVisitor
+	{
+		FromNullVisitor( Element& element, const ConformalCoefficients& coefficients ) : element( element ), coefficients( coefficients ) {}
+
+		template< int blade >
+		inline void Visit( void )
+		{
+			enum { euclideanBlade = blade & ( E1 | E2 | E3 ) };
+			double& result = element.coefficient[ Index< Element::GRADE_MASK, blade >::value ];
+			const double* nullCoefficient = coefficients.coefficient;
+
+			switch( blade & ( EP | EM ) )
+			{
+				case 0:			result = nullCoefficient[ blade ]; break;
+				case EP:		result = nullCoefficient[ euclideanBlade | ConformalCoefficients::NI ] - 0.5 * nullCoefficient[ euclideanBlade | ConformalCoefficients::NO ]; break;
+				case EM:		result = nullCoefficient[ euclideanBlade | ConformalCoefficients::NI ] + 0.5 * nullCoefficient[ euclideanBlade | ConformalCoefficients::NO ]; break;
+				case EP | EM:	result = -nullCoefficient[ blade ]; break;
+			}
+		}
+
+		Element& element;
+		const ConformalCoefficients& coefficients;
+	};
+
+	//=========================================================================================
+	template< typename Element >
+	struct ToNullVisitor
+	{
+		ToNullVisitor( const Element& element, ConformalCoefficients& coefficients ) : element( element ), coefficients( coefficients ) {}
+
+		template< int blade >
+		inline void Visit( void )
+		{
+			enum { euclideanBlade = blade & ( E1 | E2 | E3 ) };
+			double value = element.coefficient[ Index< Element::GRADE_MASK, blade >::value ];
+			double* nullCoefficient = coefficients.coefficient;
+
+			switch( blade & ( EP | EM ) )
+			{
+				case 0:
+				{
+					nullCoefficient[ blade ] += value;
+					break;
+				}
+				case EP:
+				{
+					nullCoefficient[ euclideanBlade | ConformalCoefficients::NI ] += 0.5 * value;
+					nullCoefficient[ euclideanBlade | ConformalCoefficients::NO ] -= value;
+					break;
+				}
+				case EM:
+				{
+					nullCoefficient[ euclideanBlade | ConformalCoefficients::NI ] += 0.5 * value;
+					nullCoefficient[ euclideanBlade | ConformalCoefficients::NO ] += value;
+					break;
+				}
+				case EP | EM:
+				{
+					nullCoefficient[ blade ] -= value;
+					break;
+				}
+			}
+		}
+
+		const Element& element;
+		ConformalCoefficients& coefficients;
+	};
+}
+
+//=========================================================================================
+template< int leftGradeMask, int rightGradeMask >
+inline typename ConformalProduct< leftGradeMask, rightGradeMask, ConformalBladesMeta::GEOMETRIC_PRODUCT >::Type GeometricProduct( const ConformalBlades< leftGradeMask >& left, const ConformalBlades< rightGradeMask >& right )
+{
+	return ConformalBladesMeta::Multiply< ConformalBladesMeta::GEOMETRIC_PRODUCT >( left, right );
+}
+
+//=========================================================================================
+template< int leftGradeMask, int rightGradeMask >
+inline typename ConformalProduct< leftGradeMask, rightGradeMask, ConformalBladesMeta::OUTER_PRODUCT >::Type OuterProduct( const ConformalBlades< leftGradeMask >& left, const ConformalBlades< rightGradeMask >& right )
+{
+	return ConformalBladesMeta::Multiply< ConformalBladesMeta::OUTER_PRODUCT >( left, right );
+}
+
+//=========================================================================================
+// As with the dense coefficients, this is the grade |r-s| part of the geometric product of an r-blade and an s-blade.
+template< int leftGradeMask, int rightGradeMask >
+inline typename ConformalProduct< leftGradeMask, rightGradeMask, ConformalBladesMeta::INNER_PRODUCT >::Type InnerProduct( const ConformalBlades< leftGradeMask >& left, const ConformalBlades< rightGradeMask >& right )
+{
+	return ConformalBladesMeta::Multiply< ConformalBladesMeta::INNER_PRODUCT >( left, right );
+}
+
+//=========================================================================================
+// This applies the given versor to the given element, V*X*reverse(V), assuming that the
+// versor is normalized, and keeps only the grades of the element, which are all that's left
+// of the product for a proper versor anyway.
+template< int versorGradeMask, int gradeMask >
+inline ConformalBlades< gradeMask > Sandwich( const ConformalBlades< versorGradeMask >& versor, const ConformalBlades< gradeMask >& element )
+{
+	ConformalBlades< versorGradeMask > reverse;
+	reverse.AssignReverse( versor );
+
+	ConformalBlades< gradeMask > result;
+	result.AssignGradesFrom( GeometricProduct( GeometricProduct( versor, element ), reverse ) );
+	return result;
+}
+
+//=========================================================================================
+// This is the point at the given center with the given weight: w( no + c + c^2/2 ni ).
+inline ConformalVector ConformalPointVector( const VectorMath::Vector& center, double weight )
+{
+	ConformalCoefficients coefficients;
+	coefficients.coefficient[ ConformalCoefficients::NO ] = weight;
+	coefficients.coefficient[ ConformalCoefficients::E1 ] = weight * center.x;
+	coefficients.coefficient[ ConformalCoefficients::E2 ] = weight * center.y;
+	coefficients.coefficient[ ConformalCoefficients::E3 ] = weight * center.z;
+	coefficients.coefficient[ ConformalCoefficients::NI ] = weight * 0.5 * VectorMath::Dot( center, center );
+
+	ConformalVector point;
+	point.AssignFrom( coefficients );
+	return point;
+}
+
+//=========================================================================================
+template< int gradeMask >
+inline double& ConformalBlades< gradeMask >::operator[]( int blade )
+{
+	int index = 0;
+	for( int otherBlade = 0; otherBlade < blade; otherBlade++ )
+		if( ( gradeMask >> ConformalCoefficients::Grade( otherBlade ) ) & 1 )
+			index++;
+	return coefficient[ index ];
+}
+
+//=========================================================================================
+template< int gradeMask >
+inline double ConformalBlades< gradeMask >::operator[]( int blade ) const
+{
+	if( !( ( gradeMask >> ConformalCoefficients::Grade( blade ) ) & 1 ) )
+		return 0.0;
+	return const_cast< ConformalBlades* >( this )->operator[]( blade );
+}
+
+//=========================================================================================
+template< int gradeMask >
+inline void ConformalBlades< gradeMask >::AssignFrom( const ConformalCoefficients& coefficients )
+{
+	ConformalBladesMeta::FromNullVisitor< ConformalBlades > visitor( *this, coefficients );
+	ConformalBladesMeta::ForEachBlade< gradeMask, ConformalBladesMeta::FromNullVisitor< ConformalBlades > >::Do( visitor );
+}
+
+//=========================================================================================
+template< int gradeMask >
+inline void ConformalBlades< gradeMask >::AssignTo( ConformalCoefficients& coefficients ) const
+{
+	coefficients.Zero();
+	ConformalBladesMeta::ToNullVisitor< ConformalBlades > visitor( *this, coefficients );
+	ConformalBladesMeta::ForEachBlade< gradeMask, ConformalBladesMeta::ToNullVisitor< ConformalBlades > >::Do( visitor );
+}
+
+//=========================================================================================
+template< int gradeMask >
+template< int otherGradeMask >
+inline void ConformalBlades< gradeMask >::AssignGradesFrom( const ConformalBlades< otherGradeMask >& element )
+{
+	ConformalBladesMeta::GradesVisitor< ConformalBlades, ConformalBlades< otherGradeMask > > visitor( *this, element );
+	ConformalBladesMeta::ForEachBlade< gradeMask, ConformalBladesMeta::GradesVisitor< ConformalBlades, ConformalBlades< otherGradeMask > > >::Do( visitor );
+}
+
+//=========================================================================================
+template< int gradeMask >
+inline void ConformalBlades< gradeMask >::AssignReverse( const ConformalBlades& element )
+{
+	ConformalBladesMeta::ReverseVisitor< ConformalBlades > visitor( *this, element );
+	ConformalBladesMeta::ForEachBlade< gradeMask, ConformalBladesMeta::ReverseVisitor< ConformalBlades > >::Do( visitor );
+}
+
+//=========================================================================================
+template< int gradeMask >
+inline void ConformalBlades< gradeMask >::Scale( double scale )
+{
+	for( int index = 0; index < SIZE; index++ )
+		coefficient[ index ] *= scale;
+}
+
+// ConformalBlades.h
\ No newline at end of file
@@ -0,0 +1,499 @@
+// ConformalCoefficients.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "ConformalCoefficients.h"
+#include "../wxAll.h"
+
+//=========================================================================================
+/*static*/ GeometricAlgebra::SumOfBlades* ConformalCoefficients::basisBlade[ BLADE_COUNT ];
+/*static*/ GeometricAlgebra::SumOfBlades* ConformalCoefficients::reciprocalBasisBlade[ BLADE_COUNT ];
+/*static*/ ConformalCoefficients::ProductTable ConformalCoefficients::geometricProductTable;
+/*static*/ ConformalCoefficients::ProductTable ConformalCoefficients::outerProductTable;
+/*static*/ ConformalCoefficients::ProductTable ConformalCoefficients::innerProductTable;
+
+//=========================================================================================
+ConformalCoefficients::ConformalCoefficients( void )
+{
+	Zero();
+}
+
+//=========================================================================================
+ConformalCoefficients::~ConformalCoefficients( void )
+{
+}
+
+//=========================================================================================
+// Each basis blade is paired with a reciprocal blade so that the scalar part of the
+// geometric product of the i^{th} basis blade with the j^{th} reciprocal blade is one if
+// i=j, and zero otherwise.  Since no.ni = -1, the reciprocal of a blade is found by
+// replacing no with -ni, ni with -no, and then reversing the order of the vectors.
+/*static*/ bool ConformalCoefficients::Setup( void )
+{
+	static const char* vectorName[] = { "e1", "e2", "e3", "no", "ni" };
+	static const char* reciprocalVectorName[] = { "e1", "e2", "e3", "(-ni)", "(-no)" };
+
+	bool success = BuildProductTables();
+
+	CalcLib::Calculator calculator( "geoalg" );
+	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	CalcLib::Number* number = gaEnv.CreateNumber();
+	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+
+	for( int blade = 0; blade < BLADE_COUNT && success; blade++ )
+	{
+		char bladeCode[ 128 ], reciprocalBladeCode[ 128 ];
+		strcpy_s( bladeCode, sizeof( bladeCode ), "1" );
+		strcpy_s( reciprocalBladeCode, sizeof( reciprocalBladeCode ), "1" );
+
+		for( int index = 0; index < 5; index++ )
+		{
+			if( blade & ( 1 << index ) )
+			{
+				strcat_s( bladeCode, sizeof( bladeCode ), "^" );
+				strcat_s( bladeCode, sizeof( bladeCode ), vectorName[ index ] );
+			}
+
+			if( blade & ( 1 << ( 4 - index ) ) )
+			{
+				strcat_s( reciprocalBladeCode, sizeof( reciprocalBladeCode ), "^" );
+				strcat_s( reciprocalBladeCode, sizeof( reciprocalBladeCode ), reciprocalVectorName[ 4 - index ] );
+			}
+		}
+
+		basisBlade[ blade ] = new GeometricAlgebra::SumOfBlades();
+		reciprocalBasisBlade[ blade ] = new GeometricAlgebra::SumOfBlades();
+
+		CalcLib::Evaluator* evaluator = calculator.CompileEvaluator( bladeCode );
+		if( !evaluator || !evaluator->EvaluateResult( *number, gaEnv ) || !multivector->AssignTo( *basisBlade[ blade ], gaEnv ) )
+			success = false;
+		delete evaluator;
+
+		evaluator = calculator.CompileEvaluator( reciprocalBladeCode );
+		if( !evaluator || !evaluator->EvaluateResult( *number, gaEnv ) || !multivector->AssignTo( *reciprocalBasisBlade[ blade ], gaEnv ) )
+			success = false;
+		delete evaluator;
+	}
+
+	delete number;
+
+	wxASSERT( success );
+	return success;
+}
+
+//=========================================================================================
+/*static*/ void ConformalCoefficients::Shutdown( void )
+{
+	for( int blade = 0; blade < BLADE_COUNT; blade++ )
+	{
+		delete basisBlade[ blade ];
+		basisBlade[ blade ] = 0;
+		delete reciprocalBasisBlade[ blade ];
+		reciprocalBasisBlade[ blade ] = 0;
+	}
+}
+
+//=========================================================================================
+void ConformalCoefficients::Zero( void )
+{
+	for( int blade = 0; blade < BLADE_COUNT; blade++ )
+		coefficient[ blade ] = 0.0;
+}
+
+//=========================================================================================
+/*static*/ int ConformalCoefficients::Grade( int blade )
+{
+	int grade = 0;
+	for( ; blade != 0; blade >>= 1 )
+		grade += blade & 1;
+	return grade;
+}
+
+//=========================================================================================
+// We can't multiply the blades of the null basis directly, because no and ni aren't
+// orthogonal.  So we take each blade to the orthogonal basis { e1, e2, e3, e+, e- }, with
+// e+ and e- squaring to 1 and -1, respectively, multiply there, and then come back.  Here,
+// no = ( e- - e+ )/2 and ni = e- + e+, so going back, e+ = ni/2 - no and e- = ni/2 + no.
+// Within the orthogonal basis, e+ and e- take the places of no and ni in the bit-masks.
+/*static*/ bool ConformalCoefficients::BuildProductTables( void )
+{
+	double nullToOrthogonal[5][ BLADE_COUNT ];
+	double orthogonalToNull[5][ BLADE_COUNT ];
+
+	for( int index = 0; index < 5; index++ )
+	{
+		for( int blade = 0; blade < BLADE_COUNT; blade++ )
+		{
+			nullToOrthogonal[ index ][ blade ] = 0.0;
+			orthogonalToNull[ index ][ blade ] = 0.0;
+		}
+	}
+
+	for( int index = 0; index < 3; index++ )
+	{
+		nullToOrthogonal[ index ][ 1 << index ] = 1.0;
+		orthogonalToNull[ index ][ 1 << index ] = 1.0;
+	}
+
+	nullToOrthogonal[3][ NO ] = -0.5;
+	nullToOrthogonal[3][ NI ] = 0.5;
+	nullToOrthogonal[4][ NO ] = 1.0;
+	nullToOrthogonal[4][ NI ] = 1.0;
+
+	orthogonalToNull[3][ NO ] = -1.0;
+	orthogonalToNull[3][ NI ] = 0.5;
+	orthogonalToNull[4][ NO ] = 1.0;
+	orthogonalToNull[4][ NI ] = 0.5;
+
+	for( int leftBlade = 0; leftBlade < BLADE_COUNT; leftBlade++ )
+	{
+		for( int rightBlade = 0; rightBlade < BLADE_COUNT; rightBlade++ )
+		{
+			double left[ BLADE_COUNT ], right[ BLADE_COUNT ];
+			for( int blade = 0; blade < BLADE_COUNT; blade++ )
+			{
+				left[ blade ] = ( blade == leftBlade ) ? 1.0 : 0.0;
+				right[ blade ] = ( blade == rightBlade ) ? 1.0 : 0.0;
+			}
+
+			double orthogonalLeft[ BLADE_COUNT ], orthogonalRight[ BLADE_COUNT ], orthogonalProduct[ BLADE_COUNT ], product[ BLADE_COUNT ];
+			ChangeBasis( left, nullToOrthogonal, orthogonalLeft );
+			ChangeBasis( right, nullToOrthogonal, orthogonalRight );
+			OrthogonalGeometricProduct( orthogonalLeft, orthogonalRight, orthogonalProduct );
+			ChangeBasis( orthogonalProduct, orthogonalToNull, product );
+
+			ProductTable* productTable[3] = { &geometricProductTable, &outerProductTable, &innerProductTable };
+			int productGrade[3] = { -1, Grade( leftBlade ) + Grade( rightBlade ), abs( Grade( leftBlade ) - Grade( rightBlade ) ) };
+
+			for( int table = 0; table < 3; table++ )
+			{
+				int termCount = 0;
+
+				for( int term = 0; term < 2; term++ )
+				{
+					productTable[ table ]->blade[ leftBlade ][ rightBlade ][ term ] = 0;
+					productTable[ table ]->scale[ leftBlade ][ rightBlade ][ term ] = 0.0;
+				}
+
+				for( int blade = 0; blade < BLADE_COUNT; blade++ )
+				{
+					// Everything here is a dyadic rational, so there is no round-off to worry about.
+					if( product[ blade ] == 0.0 )
+						continue;
+					if( productGrade[ table ] >= 0 && Grade( blade ) != productGrade[ table ] )
+						continue;
+					if( termCount == 2 )
+						return false;
+
+					productTable[ table ]->blade[ leftBlade ][ rightBlade ][ termCount ] = blade;
+					productTable[ table ]->scale[ leftBlade ][ rightBlade ][ termCount ] = product[ blade ];
+					termCount++;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+//=========================================================================================
+// Blades are bit-masks, so the sign that comes from bringing the vectors of the product of
+// two blades into canonical order is just the parity of the number of swaps it takes.
+/*static*/ int ConformalCoefficients::ReorderingSign( int leftBlade, int rightBlade )
+{
+	int swapCount = 0;
+	for( leftBlade >>= 1; leftBlade != 0; leftBlade >>= 1 )
+		swapCount += Grade( leftBlade & rightBlade );
+	return( ( swapCount & 1 ) ? -1 : 1 );
+}
+
+//=========================================================================================
+// The outer product doesn't care about the metric, so this works in either basis.
+/*static*/ void ConformalCoefficients::OuterProduct( const double* left, const double* right, double* product )
+{
+	for( int blade = 0; blade < BLADE_COUNT; blade++ )
+		product[ blade ] = 0.0;
+
+	for( int leftBlade = 0; leftBlade < BLADE_COUNT; leftBlade++ )
+	{
+		if( left[ leftBlade ] == 0.0 )
+			continue;
+
+		for( int rightBlade = 0; rightBlade < BLADE_COUNT; rightBlade++ )
+		{
+			if( right[ rightBlade ] == 0.0 || ( leftBlade & rightBlade ) != 0 )
+				continue;
+
+			product[ leftBlade ^ rightBlade ] += double( ReorderingSign( leftBlade, rightBlade ) ) * left[ leftBlade ] * right[ rightBlade ];
+		}
+	}
+}
+
+//=========================================================================================
+/*static*/ void ConformalCoefficients::OrthogonalGeometricProduct( const double* left, const double* right, double* product )
+{
+	static const double metric[5] = { 1.0, 1.0, 1.0, 1.0, -1.0 };
+
+	for( int blade = 0; blade < BLADE_COUNT; blade++ )
+		product[ blade ] = 0.0;
+
+	for( int leftBlade = 0; leftBlade < BLADE_COUNT; leftBlade++ )
+	{
+		if( left[ leftBlade ] == 0.0 )
+			continue;
+
+		for( int rightBlade = 0; rightBlade < BLADE_COUNT; rightBlade++ )
+		{
+			if( right[ rightBlade ] == 0.0 )
+				continue;
+
+			double scale = double( ReorderingSign( leftBlade, rightBlade ) );
+			for( int index = 0; index < 5; index++ )
+				if( leftBlade & rightBlade & ( 1 << index ) )
+					scale *= metric[ index ];
+
+			product[ leftBlade ^ rightBlade ] += scale * left[ leftBlade ] * right[ rightBlade ];
+		}
+	}
+}
+
+//=========================================================================================
+// Each blade of the given element is taken to the outer product of the images of its vectors.
+/*static*/ void ConformalCoefficients::ChangeBasis( const double* element, const double vectorImage[5][ BLADE_COUNT ], double* image )
+{
+	for( int blade = 0; blade < BLADE_COUNT; blade++ )
+		image[ blade ] = 0.0;
+
+	for( int blade = 0; blade < BLADE_COUNT; blade++ )
+	{
+		if( element[ blade ] == 0.0 )
+			continue;
+
+		double bladeImage[ BLADE_COUNT ], product[ BLADE_COUNT ];
+		for( int index = 0; index < BLADE_COUNT; index++ )
+			bladeImage[ index ] = ( index == 0 ) ? element[ blade ] : 0.0;
+
+		for( int index = 0; index < 5; index++ )
+		{
+			if( !( blade & ( 1 << index ) ) )
+				continue;
+
+			OuterProduct( bladeImage, vectorImage[ index ], product );
+			for( int productBlade = 0; productBlade < BLADE_COUNT; productBlade++ )
+				bladeImage[ productBlade ] = product[ productBlade ];
+		}
+
+		for( int index = 0; index < BLADE_COUNT; index++ )
+			image[ index ] += bladeImage[ index ];
+	}
+}
+
+//=========================================================================================
+// Only the coefficients of blades of the given grade are read unless the grade is negative.
+bool ConformalCoefficients::AssignFrom( const GeometricAlgebra::SumOfBlades& element, int grade )
+{
+	Zero();
+
+	GeometricAlgebra::SumOfBlades product;
+	GeometricAlgebra::Scalar scalar;
+
+	for( int blade = 0; blade < BLADE_COUNT; blade++ )
+	{
+		if( grade >= 0 && Grade( blade ) != grade )
+			continue;
+
+		if( !product.AssignGeometricProduct( element, *reciprocalBasisBlade[ blade ] ) )
+			return false;
+		if( !product.AssignScalarTo( scalar ) )
+			return false;
+
+		coefficient[ blade ] = scalar;
+	}
+
+	return true;
+}
+
+//=========================================================================================
+bool ConformalCoefficients::AssignFrom( const GeometricAlgebra::SumOfBlades& element )
+{
+	return AssignFrom( element, -1 );
+}
+
+//=========================================================================================
+bool ConformalCoefficients::AssignTo( GeometricAlgebra::SumOfBlades& element ) const
+{
+	GeometricAlgebra::SumOfBlades sum, term, scalar;
+	sum.AssignScalar( 0.0 );
+
+	for( int blade = 0; blade < BLADE_COUNT; blade++ )
+	{
+		if( coefficient[ blade ] == 0.0 )
+			continue;
+
+		scalar.AssignScalar( coefficient[ blade ] );
+		if( !term.AssignGeometricProduct( scalar, *basisBlade[ blade ] ) )
+			return false;
+		if( !element.AssignSum( sum, term ) )
+			return false;
+
+		sum.AssignSumOfBlades( element );
+	}
+
+	element.AssignSumOfBlades( sum );
+	return true;
+}
+
+//=========================================================================================
+void ConformalCoefficients::AssignGeometricProduct( const ConformalCoefficients& left, const ConformalCoefficients& right )
+{
+	AssignProduct( left, right, geometricProductTable );
+}
+
+//=========================================================================================
+void ConformalCoefficients::AssignOuterProduct( const ConformalCoefficients& left, const ConformalCoefficients& right )
+{
+	AssignProduct( left, right, outerProductTable );
+}
+
+//=========================================================================================
+void ConformalCoefficients::AssignInnerProduct( const ConformalCoefficients& left, const ConformalCoefficients& right )
+{
+	AssignProduct( left, right, innerProductTable );
+}
+
+//=========================================================================================
+// Entries of a table with fewer than two terms are padded with zero-scaled scalars, so
+// that we never have to branch on the number of terms.
+void ConformalCoefficients::AssignProduct( const ConformalCoefficients& left, const ConformalCoefficients& right, const ProductTable& productTable )
+{
+	double product[ BLADE_COUNT ];
+	for( int blade = 0; blade < BLADE_COUNT; blade++ )
+		product[ blade ] = 0.0;
+
+	for( int leftBlade = 0; leftBlade < BLADE_COUNT; leftBlade++ )
+	{
+		double leftCoefficient = left.coefficient[ leftBlade ];
+		if( leftCoefficient == 0.0 )
+			continue;
+
+		const int ( *blade )[2] = productTable.blade[ leftBlade ];
+		const double ( *scale )[2] = productTable.scale[ leftBlade ];
+
+		for( int rightBlade = 0; rightBlade < BLADE_COUNT; rightBlade++ )
+		{
+			double rightCoefficient = right.coefficient[ rightBlade ];
+			if( rightCoefficient == 0.0 )
+				continue;
+
+			double coefficientProduct = leftCoefficient * rightCoefficient;
+			product[ blade[ rightBlade ][0] ] += scale[ rightBlade ][0] * coefficientProduct;
+			product[ blade[ rightBlade ][1] ] += scale[ rightBlade ][1] * coefficientProduct;
+		}
+	}
+
+	for( int blade = 0; blade < BLADE_COUNT; blade++ )
+		coefficient[ blade ] = product[ blade ];
+}
+
+//=========================================================================================
+void ConformalCoefficients::AssignSum( const ConformalCoefficients& left, const ConformalCoefficients& right )
+{
+	for( int blade = 0; blade < BLADE_COUNT; blade++ )
+		coefficient[ blade ] = left.coefficient[ blade ] + right.coefficient[ blade ];
+}
+
+//=========================================================================================
+// The reverse of a blade of grade r picks up the sign (-1)^{r(r-1)/2}.
+void ConformalCoefficients::AssignReverse( const ConformalCoefficients& coefficients )
+{
+	for( int blade = 0; blade < BLADE_COUNT; blade++ )
+	{
+		int grade = Grade( blade );
+		double sign = ( ( ( grade * ( grade - 1 ) ) / 2 ) & 1 ) ? -1.0 : 1.0;
+		coefficient[ blade ] = sign * coefficients.coefficient[ blade ];
+	}
+}
+
+//=========================================================================================
+void ConformalCoefficients::Scale( double scale )
+{
+	for( int blade = 0; blade < BLADE_COUNT; blade++ )
+		coefficient[ blade ] *= scale;
+}
+
+//=========================================================================================
+void ConformalCoefficients::MultiplyByPseudoScalar( void )
+{
+	MultiplyByPseudoScalar( 1.0 );
+}
+
+//=========================================================================================
+void ConformalCoefficients::MultiplyByNegativePseudoScalar( void )
+{
+	MultiplyByPseudoScalar( -1.0 );
+}
+
+//=========================================================================================
+// Every blade of the null basis is taken to plus or minus a single blade by I.  The
+// Euclidean part of the blade goes to its complement in e1^e2^e3, no and ni are left
+// alone when only one of them is present, no^ni goes away, and no^ni appears if neither
+// one was present.
+void ConformalCoefficients::MultiplyByPseudoScalar( double sign )
+{
+	static const double productSign[ BLADE_COUNT ] =
+	{
+		-1.0, -1.0,  1.0,  1.0, -1.0, -1.0,  1.0,  1.0,
+		 1.0,  1.0, -1.0, -1.0,  1.0,  1.0, -1.0, -1.0,
+		-1.0, -1.0,  1.0,  1.0, -1.0, -1.0,  1.0,  1.0,
+		-1.0, -1.0,  1.0,  1.0, -1.0, -1.0,  1.0,  1.0,
+	};
+
+	double product[ BLADE_COUNT ];
+
+	for( int blade = 0; blade < BLADE_COUNT; blade++ )
+	{
+		int productBlade = blade ^ ( E1 | E2 | E3 );
+		int nullPart = blade & ( NO | NI );
+		if( nullPart == 0 || nullPart == ( NO | NI ) )
+			productBlade ^= NO | NI;
+
+		product[ productBlade ] = sign * productSign[ blade ] * coefficient[ blade ];
+	}
+
+	for( int blade = 0; blade < BLADE_COUNT; blade++ )
+		coefficient[ blade ] = product[ blade ];
+}
+
+//=========================================================================================
+double ConformalCoefficients::MaxDifference( const ConformalCoefficients& coefficients ) const
+{
+	double maxDifference = 0.0;
+	for( int blade = 0; blade < BLADE_COUNT; blade++ )
+	{
+		double difference = fabs( coefficient[ blade ] - coefficients.coefficient[ blade ] );
+		if( difference > maxDifference )
+			maxDifference = difference;
+	}
+	return maxDifference;
+}
+
+//=========================================================================================
+double ConformalCoefficients::EuclideanDistance( const ConformalCoefficients& coefficients ) const
+{
+	double squareDistance = 0.0;
+	for( int blade = 0; blade < BLADE_COUNT; blade++ )
+	{
+		double difference = coefficient[ blade ] - coefficients.coefficient[ blade ];
+		squareDistance += difference * difference;
+	}
+	return sqrt( squareDistance );
+}
+
+// ConformalCoefficients.cpp
\ No newline at end of file
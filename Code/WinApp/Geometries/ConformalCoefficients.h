@@ -0,0 +1,108 @@
+// ConformalCoefficients.h
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#pragma once
+
+#include "Calculator/CalcLib.h"
+
+//=========================================================================================
+// This is a dense representation of an element of the conformal model in terms of the
+// blades of the null basis { e1, e2, e3, no, ni }.  A blade is indexed by a bit-mask of
+// the basis vectors in its outer product, always taken in that order, so that the index
+// of e1^e3^ni, for example, is E1 | E3 | NI.  The conformal geometries decompose and
+// compose their elements here using hand-derived formulas, which is a lot faster than
+// running their scripts.  Only the conversion to and from the GA library types touches
+// the GA library, so that's the only part of this that isn't just arithmetic.  Products
+// are table-driven.  The product of any two blades of the null basis has at most two
+// terms, so each table entry is just a pair of blades and their scales.
+class ConformalCoefficients
+{
+public:
+
+	enum
+	{
+		E1 = 1,
+		E2 = 2,
+		E3 = 4,
+		NO = 8,
+		NI = 16,
+		BLADE_COUNT = 32,
+	};
+
+	ConformalCoefficients( void );
+	~ConformalCoefficients( void );
+
+	// These must be called after and before the GA library is setup and shutdown, respectively.
+	static bool Setup( void );
+	static void Shutdown( void );
+
+	void Zero( void );
+
+	// Only the coefficients of blades of the given grade are read from the given element.
+	// All other coefficients are zeroed.  This is all the geometries ever need, and it saves
+	// us from calculating coefficients we already know to be zero.
+	bool AssignFrom( const GeometricAlgebra::SumOfBlades& element, int grade );
+	bool AssignFrom( const GeometricAlgebra::SumOfBlades& element );
+	bool AssignTo( GeometricAlgebra::SumOfBlades& element ) const;
+
+	// The inner product taken here is the grade |r-s| part of the geometric product of an
+	// r-blade and an s-blade.  It's fine for the product to alias either of its factors.
+	void AssignGeometricProduct( const ConformalCoefficients& left, const ConformalCoefficients& right );
+	void AssignOuterProduct( const ConformalCoefficients& left, const ConformalCoefficients& right );
+	void AssignInnerProduct( const ConformalCoefficients& left, const ConformalCoefficients& right );
+	void AssignSum( const ConformalCoefficients& left, const ConformalCoefficients& right );
+	void AssignReverse( const ConformalCoefficients& coefficients );
+	void Scale( double scale );
+
+	// These take us between the normal and dual forms of a geometry.  Here, I = no^e1^e2^e3^ni,
+	// which is the pseudo-scalar used by the "geoalg" scripts.
+	void MultiplyByPseudoScalar( void );
+	void MultiplyByNegativePseudoScalar( void );
+
+	double MaxDifference( const ConformalCoefficients& coefficients ) const;
+
+	// This treats the blades as an orthonormal basis, which they aren't under the conformal
+	// metric, but unlike the metric, it only vanishes for identical elements.
+	double EuclideanDistance( const ConformalCoefficients& coefficients ) const;
+
+	static int Grade( int blade );
+
+	// This is aligned so that loops over the coefficients vectorize nicely.
+	__declspec( align( 16 ) ) double coefficient[ BLADE_COUNT ];
+
+private:
+
+	void MultiplyByPseudoScalar( double sign );
+
+	//=========================================================================================
+	struct ProductTable
+	{
+		int blade[ BLADE_COUNT ][ BLADE_COUNT ][2];
+		double scale[ BLADE_COUNT ][ BLADE_COUNT ][2];
+	};
+
+	void AssignProduct( const ConformalCoefficients& left, const ConformalCoefficients& right, const ProductTable& productTable );
+
+	static bool BuildProductTables( void );
+	static int ReorderingSign( int leftBlade, int rightBlade );
+	static void OuterProduct( const double* left, const double* right, double* product );
+	static void OrthogonalGeometricProduct( const double* left, const double* right, double* product );
+	static void ChangeBasis( const double* element, const double vectorImage[5][ BLADE_COUNT ], double* image );
+
+	static ProductTable geometricProductTable;
+	static ProductTable outerProductTable;
+	static ProductTable innerProductTable;
+
+	static GeometricAlgebra::SumOfBlades* basisBlade[ BLADE_COUNT ];
+	static GeometricAlgebra::SumOfBlades* reciprocalBasisBlade[ BLADE_COUNT ];
+};
+
+// ConformalCoefficients.h
\ No newline at end of file
@@ -10,15 +10,17 @@
  */
 
 #include "ConformalQuarticGeometry.h"
+#include "../FunctionRegistry.h"
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( ConformalQuarticGeometry, SurfaceGeometry );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar bindConformalQuarticRegistrar( "bind_conformal_quartic", &ConformalQuarticGeometry::Create, GAVisToolBindTarget::DOESNT_MATTER );
+
 //=========================================================================================
 ConformalQuarticGeometry::ConformalQuarticGeometry( BindType bindType ) : SurfaceGeometry( bindType, &conformalQuartic )
 {
-	CalcLib::Calculator calculator( "geoalg" );
-
 	char decompositionCode[ 2*1024 ];
 	strcpy_s( decompositionCode, sizeof( decompositionCode ),
 		"do("
@@ -55,7 +57,7 @@ ConformalQuarticGeometry::ConformalQuarticGeometry( BindType bindType ) : Surfac
 
 		")"
 	);
-	decompositionEvaluator = calculator.CompileEvaluator( decompositionCode );
+	decompositionEvaluator = GAVisToolEvaluatorCache::Lookup( decompositionCode );
 	wxASSERT( decompositionEvaluator != 0 );
 }
 
@@ -75,10 +77,11 @@ ConformalQuarticGeometry::ConformalQuarticGeometry( BindType bindType ) : Surfac
 {
 	SurfaceGeometry::DecomposeFrom( element );
 
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	multivector->AssignFrom( element, gaEnv );
 	gaEnv.StoreVariable( "quartic", *number );
@@ -135,8 +138,6 @@ ConformalQuarticGeometry::ConformalQuarticGeometry( BindType bindType ) : Surfac
 	multivector->AssignTo( conformalQuartic.c23, gaEnv );
 	gaEnv.LookupVariable( "c24", *number );
 	multivector->AssignTo( conformalQuartic.c24, gaEnv );
-
-	delete number;
 }
 
 //=========================================================================================
@@ -10,23 +10,26 @@
  */
 
 #include "FlatGeometry.h"
+#include "../FunctionRegistry.h"
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( ConformalFlatPoint, GAVisToolGeometry );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar bindFlatpointRegistrar( "bind_flatpoint", &ConformalFlatPoint::Create, GAVisToolBindTarget::NORMAL_FORM );
+static GAVisToolFunctionRegistry::Registrar bindDualFlatpointRegistrar( "bind_dual_flatpoint", &ConformalFlatPoint::Create, GAVisToolBindTarget::DUAL_FORM );
+
 //=========================================================================================
 ConformalFlatPoint::ConformalFlatPoint( BindType bindType ) : GAVisToolGeometry( bindType )
 {
 	VectorMath::Zero( center );
 	weight = 1.0;
 
-	CalcLib::Calculator calculator( "geoalg" );
-
 	char decompositionCode[ 512 ];
 	sprintf_s( decompositionCode, sizeof( decompositionCode ),
 		"do("
 		"%s"
-		"w = -( fp^ni )*i,"
+		"w = -( no . ( fp^ni ) )*i,"
 		"fp = fp / w,"
 		"v = ( no . fp )*i,"
 		"x = scalar_part( v, e1 ),"
@@ -35,7 +38,7 @@ ConformalFlatPoint::ConformalFlatPoint( BindType bindType ) : GAVisToolGeometry(
 		")",
 		( bindType == NORMAL_FORM ? "fp = fp*I," : "" )
 	);
-	decompositionEvaluator = calculator.CompileEvaluator( decompositionCode );
+	decompositionEvaluator = GAVisToolEvaluatorCache::Lookup( decompositionCode );
 	wxASSERT( decompositionEvaluator != 0 );
 
 	char compositionCode[ 512 ];
@@ -46,7 +49,7 @@ ConformalFlatPoint::ConformalFlatPoint( BindType bindType ) : GAVisToolGeometry(
 		")",
 		( bindType == NORMAL_FORM ? "*-I" : "" )
 	);
-	compositionEvaluator = calculator.CompileEvaluator( compositionCode );
+	compositionEvaluator = GAVisToolEvaluatorCache::Lookup( compositionCode );
 	wxASSERT( compositionEvaluator != 0 );
 }
 
@@ -62,12 +65,13 @@ ConformalFlatPoint::ConformalFlatPoint( BindType bindType ) : GAVisToolGeometry(
 }
 
 //=========================================================================================
-/*virtual*/ void ConformalFlatPoint::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
+void ConformalFlatPoint::DecomposeWithScript( const GeometricAlgebra::SumOfBlades& element )
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	multivector->AssignFrom( element, gaEnv );
 	gaEnv.StoreVariable( "fp", *number );
@@ -81,17 +85,17 @@ ConformalFlatPoint::ConformalFlatPoint( BindType bindType ) : GAVisToolGeometry(
 	gaEnv.LookupVariable( "y", *number );
 	multivector->AssignTo( center.y, gaEnv );
 	gaEnv.LookupVariable( "z", *number );
-
-	delete number;
+	multivector->AssignTo( center.z, gaEnv );
 }
 
 //=========================================================================================
-/*virtual*/ void ConformalFlatPoint::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
+void ConformalFlatPoint::ComposeWithScript( GeometricAlgebra::SumOfBlades& element ) const
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	number->AssignFrom( weight, gaEnv );
 	gaEnv.StoreVariable( "w", *number );
@@ -106,8 +110,53 @@ ConformalFlatPoint::ConformalFlatPoint( BindType bindType ) : GAVisToolGeometry(
 
 	gaEnv.LookupVariable( "fp", *number );
 	multivector->AssignTo( element, gaEnv );
+}
 
-	delete number;
+//=========================================================================================
+/*virtual*/ void ConformalFlatPoint::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
+{
+	Modified();
+
+	if( useScriptOracle )
+	{
+		DecomposeWithScript( element );
+		return;
+	}
+
+	ConformalCoefficients coefficients;
+	if( !AssignDualFormFrom( coefficients, element, 3 ) )
+		return;
+
+	double w = coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E2 | ConformalCoefficients::E3 ];
+	if( w == 0.0 )
+		return;
+
+	// The coefficients of ei^ej^ni are those of v*i.
+	weight = w;
+	VectorMath::Set( center,
+		coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::E3 | ConformalCoefficients::NI ] / weight,
+		-coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E3 | ConformalCoefficients::NI ] / weight,
+		coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E2 | ConformalCoefficients::NI ] / weight );
+}
+
+//=========================================================================================
+/*virtual*/ void ConformalFlatPoint::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
+{
+	if( useScriptOracle )
+	{
+		ComposeWithScript( element );
+		return;
+	}
+
+	ConformalCoefficients coefficients;
+
+	// fp = w*( i + ( v*i )^ni )
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E2 | ConformalCoefficients::E3 ] = weight;
+	coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::E3 | ConformalCoefficients::NI ] = weight * center.x;
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E3 | ConformalCoefficients::NI ] = -weight * center.y;
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E2 | ConformalCoefficients::NI ] = weight * center.z;
+
+	AssignDualFormTo( coefficients, element );
 }
 
 //=========================================================================================
@@ -152,6 +201,7 @@ ConformalFlatPoint::ConformalFlatPoint( BindType bindType ) : GAVisToolGeometry(
 //=========================================================================================
 /*virtual*/ void ConformalFlatPoint::Translate( const VectorMath::Vector& delta )
 {
+	Modified();
 	VectorMath::Add( center, center, delta );
 }
 
@@ -170,6 +220,10 @@ ConformalFlatPoint::ConformalFlatPoint( BindType bindType ) : GAVisToolGeometry(
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( ConformalLine, GAVisToolGeometry );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar bindLineRegistrar( "bind_line", &ConformalLine::Create, GAVisToolBindTarget::NORMAL_FORM );
+static GAVisToolFunctionRegistry::Registrar bindDualLineRegistrar( "bind_dual_line", &ConformalLine::Create, GAVisToolBindTarget::DUAL_FORM );
+
 //=========================================================================================
 ConformalLine::ConformalLine( BindType bindType ) : GAVisToolGeometry( bindType )
 {
@@ -177,8 +231,6 @@ ConformalLine::ConformalLine( BindType bindType ) : GAVisToolGeometry( bindType
 	VectorMath::Set( unitNormal, 0.0, 0.0, 1.0 );
 	weight = 1.0;
 
-	CalcLib::Calculator calculator( "geoalg" );
-
 	char decompositionCode[ 512 ];
 	sprintf_s( decompositionCode, sizeof( decompositionCode ),
 		"do("
@@ -197,7 +249,7 @@ ConformalLine::ConformalLine( BindType bindType ) : GAVisToolGeometry( bindType
 		")",
 		( bindType == NORMAL_FORM ? "lin = lin*I," : "" )
 	);
-	decompositionEvaluator = calculator.CompileEvaluator( decompositionCode );
+	decompositionEvaluator = GAVisToolEvaluatorCache::Lookup( decompositionCode );
 	wxASSERT( decompositionEvaluator != 0 );
 
 	char compositionCode[ 512 ];
@@ -209,7 +261,7 @@ ConformalLine::ConformalLine( BindType bindType ) : GAVisToolGeometry( bindType
 		")",
 		( bindType == NORMAL_FORM ? "*-I" : "" )
 	);
-	compositionEvaluator = calculator.CompileEvaluator( compositionCode );
+	compositionEvaluator = GAVisToolEvaluatorCache::Lookup( compositionCode );
 	wxASSERT( compositionEvaluator != 0 );
 }
 
@@ -225,12 +277,13 @@ ConformalLine::ConformalLine( BindType bindType ) : GAVisToolGeometry( bindType
 }
 
 //=========================================================================================
-/*virtual*/ void ConformalLine::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
+void ConformalLine::DecomposeWithScript( const GeometricAlgebra::SumOfBlades& element )
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	multivector->AssignFrom( element, gaEnv );
 	gaEnv.StoreVariable( "lin", *number );
@@ -251,17 +304,16 @@ ConformalLine::ConformalLine( BindType bindType ) : GAVisToolGeometry( bindType
 	multivector->AssignTo( unitNormal.y, gaEnv );
 	gaEnv.LookupVariable( "nz", *number );
 	multivector->AssignTo( unitNormal.z, gaEnv );
-
-	delete number;
 }
 
 //=========================================================================================
-/*virtual*/ void ConformalLine::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
+void ConformalLine::ComposeWithScript( GeometricAlgebra::SumOfBlades& element ) const
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	number->AssignFrom( weight, gaEnv );
 	gaEnv.StoreVariable( "w", *number );
@@ -282,8 +334,67 @@ ConformalLine::ConformalLine( BindType bindType ) : GAVisToolGeometry( bindType
 
 	gaEnv.LookupVariable( "lin", *number );
 	multivector->AssignTo( element, gaEnv );
+}
+
+//=========================================================================================
+/*virtual*/ void ConformalLine::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
+{
+	Modified();
+
+	if( useScriptOracle )
+	{
+		DecomposeWithScript( element );
+		return;
+	}
 
-	delete number;
+	ConformalCoefficients coefficients;
+	if( !AssignDualFormFrom( coefficients, element, 2 ) )
+		return;
+
+	// The Euclidean bivector n*i is the dual of the direction of the line.
+	VectorMath::Vector normal;
+	VectorMath::Set( normal,
+		coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::E3 ],
+		-coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E3 ],
+		coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E2 ] );
+	double w = VectorMath::Length( normal );
+	if( w == 0.0 )
+		return;
+
+	weight = w;
+	VectorMath::Scale( unitNormal, normal, 1.0 / weight );
+
+	// The coefficients of ei^ni are those of v x n, which gives us the point on the line closest to the origin.
+	VectorMath::Vector moment;
+	VectorMath::Set( moment,
+		coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::NI ] / weight,
+		coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::NI ] / weight,
+		coefficients.coefficient[ ConformalCoefficients::E3 | ConformalCoefficients::NI ] / weight );
+	VectorMath::Cross( center, unitNormal, moment );
+}
+
+//=========================================================================================
+/*virtual*/ void ConformalLine::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
+{
+	if( useScriptOracle )
+	{
+		ComposeWithScript( element );
+		return;
+	}
+
+	ConformalCoefficients coefficients;
+
+	// lin = w*( n*i - ( v . ( n*i ) )^ni )
+	VectorMath::Vector moment;
+	VectorMath::Cross( moment, center, unitNormal );
+	coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::E3 ] = weight * unitNormal.x;
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E3 ] = -weight * unitNormal.y;
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E2 ] = weight * unitNormal.z;
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::NI ] = weight * moment.x;
+	coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::NI ] = weight * moment.y;
+	coefficients.coefficient[ ConformalCoefficients::E3 | ConformalCoefficients::NI ] = weight * moment.z;
+
+	AssignDualFormTo( coefficients, element );
 }
 
 //=========================================================================================
@@ -352,12 +463,15 @@ ConformalLine::ConformalLine( BindType bindType ) : GAVisToolGeometry( bindType
 //=========================================================================================
 /*virtual*/ void ConformalLine::Translate( const VectorMath::Vector& delta )
 {
+	Modified();
 	VectorMath::Add( center, center, delta );
 }
 
 //=========================================================================================
 /*virtual*/ void ConformalLine::Rotate( const VectorMath::Vector& unitAxis, float angle )
 {
+	Modified();
+
 	VectorMath::Rotate( unitNormal, unitNormal, unitAxis, angle );
 	VectorMath::Normalize( unitNormal, unitNormal );		// Fix round-off error.
 }
@@ -371,6 +485,10 @@ ConformalLine::ConformalLine( BindType bindType ) : GAVisToolGeometry( bindType
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( ConformalPlane, GAVisToolGeometry );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar bindPlaneRegistrar( "bind_plane", &ConformalPlane::Create, GAVisToolBindTarget::NORMAL_FORM );
+static GAVisToolFunctionRegistry::Registrar bindDualPlaneRegistrar( "bind_dual_plane", &ConformalPlane::Create, GAVisToolBindTarget::DUAL_FORM );
+
 //=========================================================================================
 ConformalPlane::ConformalPlane( BindType bindType ) : GAVisToolGeometry( bindType )
 {
@@ -378,8 +496,6 @@ ConformalPlane::ConformalPlane( BindType bindType ) : GAVisToolGeometry( bindTyp
 	VectorMath::Set( unitNormal, 0.0, 0.0, 1.0 );
 	weight = 1.0;
 
-	CalcLib::Calculator calculator( "geoalg" );
-
 	char decompositionCode[ 512 ];
 	sprintf_s( decompositionCode, sizeof( decompositionCode ),
 		"do("
@@ -398,7 +514,7 @@ ConformalPlane::ConformalPlane( BindType bindType ) : GAVisToolGeometry( bindTyp
 		")",
 		( bindType == NORMAL_FORM ? "pln = pln*I," : "" )
 	);
-	decompositionEvaluator = calculator.CompileEvaluator( decompositionCode );
+	decompositionEvaluator = GAVisToolEvaluatorCache::Lookup( decompositionCode );
 	wxASSERT( decompositionEvaluator != 0 );
 
 	char compositionCode[ 512 ];
@@ -410,7 +526,7 @@ ConformalPlane::ConformalPlane( BindType bindType ) : GAVisToolGeometry( bindTyp
 		")",
 		( bindType == NORMAL_FORM ? "*-I" : "" )
 	);
-	compositionEvaluator = calculator.CompileEvaluator( compositionCode );
+	compositionEvaluator = GAVisToolEvaluatorCache::Lookup( compositionCode );
 	wxASSERT( compositionEvaluator != 0 );
 }
 
@@ -426,12 +542,13 @@ ConformalPlane::ConformalPlane( BindType bindType ) : GAVisToolGeometry( bindTyp
 }
 
 //=========================================================================================
-/*virtual*/ void ConformalPlane::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
+void ConformalPlane::DecomposeWithScript( const GeometricAlgebra::SumOfBlades& element )
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	multivector->AssignFrom( element, gaEnv );
 	gaEnv.StoreVariable( "pln", *number );
@@ -452,17 +569,16 @@ ConformalPlane::ConformalPlane( BindType bindType ) : GAVisToolGeometry( bindTyp
 	multivector->AssignTo( unitNormal.y, gaEnv );
 	gaEnv.LookupVariable( "nz", *number );
 	multivector->AssignTo( unitNormal.z, gaEnv );
-
-	delete number;
 }
 
 //=========================================================================================
-/*virtual*/ void ConformalPlane::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
+void ConformalPlane::ComposeWithScript( GeometricAlgebra::SumOfBlades& element ) const
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	number->AssignFrom( weight, gaEnv );
 	gaEnv.StoreVariable( "w", *number );
@@ -483,8 +599,56 @@ ConformalPlane::ConformalPlane( BindType bindType ) : GAVisToolGeometry( bindTyp
 
 	gaEnv.LookupVariable( "pln", *number );
 	multivector->AssignTo( element, gaEnv );
+}
 
-	delete number;
+//=========================================================================================
+/*virtual*/ void ConformalPlane::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
+{
+	Modified();
+
+	if( useScriptOracle )
+	{
+		DecomposeWithScript( element );
+		return;
+	}
+
+	ConformalCoefficients coefficients;
+	if( !AssignDualFormFrom( coefficients, element, 1 ) )
+		return;
+
+	VectorMath::Vector normal;
+	VectorMath::Set( normal,
+		coefficients.coefficient[ ConformalCoefficients::E1 ],
+		coefficients.coefficient[ ConformalCoefficients::E2 ],
+		coefficients.coefficient[ ConformalCoefficients::E3 ] );
+	double w = VectorMath::Length( normal );
+	if( w == 0.0 )
+		return;
+
+	// The coefficient of ni is the distance of the plane from the origin.
+	weight = w;
+	VectorMath::Scale( unitNormal, normal, 1.0 / weight );
+	VectorMath::Scale( center, unitNormal, coefficients.coefficient[ ConformalCoefficients::NI ] / weight );
+}
+
+//=========================================================================================
+/*virtual*/ void ConformalPlane::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
+{
+	if( useScriptOracle )
+	{
+		ComposeWithScript( element );
+		return;
+	}
+
+	ConformalCoefficients coefficients;
+
+	// pln = w*( n + ( v . n )*ni )
+	coefficients.coefficient[ ConformalCoefficients::E1 ] = weight * unitNormal.x;
+	coefficients.coefficient[ ConformalCoefficients::E2 ] = weight * unitNormal.y;
+	coefficients.coefficient[ ConformalCoefficients::E3 ] = weight * unitNormal.z;
+	coefficients.coefficient[ ConformalCoefficients::NI ] = weight * VectorMath::Dot( center, unitNormal );
+
+	AssignDualFormTo( coefficients, element );
 }
 
 //=========================================================================================
@@ -533,12 +697,15 @@ ConformalPlane::ConformalPlane( BindType bindType ) : GAVisToolGeometry( bindTyp
 //=========================================================================================
 /*virtual*/ void ConformalPlane::Translate( const VectorMath::Vector& delta )
 {
+	Modified();
 	VectorMath::Add( center, center, delta );
 }
 
 //=========================================================================================
 /*virtual*/ void ConformalPlane::Rotate( const VectorMath::Vector& unitAxis, float angle )
 {
+	Modified();
+
 	VectorMath::Rotate( unitNormal, unitNormal, unitAxis, angle );
 	VectorMath::Normalize( unitNormal, unitNormal );		// Fix round-off error.
 }
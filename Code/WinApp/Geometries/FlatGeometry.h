@@ -41,6 +41,9 @@ public:
 
 private:
 
+	void DecomposeWithScript( const GeometricAlgebra::SumOfBlades& element );
+	void ComposeWithScript( GeometricAlgebra::SumOfBlades& element ) const;
+
 	VectorMath::Vector center;
 	double weight;
 };
@@ -73,6 +76,9 @@ public:
 
 private:
 
+	void DecomposeWithScript( const GeometricAlgebra::SumOfBlades& element );
+	void ComposeWithScript( GeometricAlgebra::SumOfBlades& element ) const;
+
 	VectorMath::Vector center;
 	VectorMath::Vector unitNormal;
 	double weight;
@@ -106,6 +112,9 @@ public:
 
 private:
 
+	void DecomposeWithScript( const GeometricAlgebra::SumOfBlades& element );
+	void ComposeWithScript( GeometricAlgebra::SumOfBlades& element ) const;
+
 	VectorMath::Vector center;
 	VectorMath::Vector unitNormal;
 	double weight;
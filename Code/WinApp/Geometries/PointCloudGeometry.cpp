@@ -10,10 +10,14 @@
  */
 
 #include "PointCloudGeometry.h"
+#include "../FunctionRegistry.h"
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( PointCloudGeometry, GAVisToolGeometry );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar bindPtCloudRegistrar( "bind_pt_cloud", &PointCloudGeometry::Create, GAVisToolBindTarget::DOESNT_MATTER );
+
 //=========================================================================================
 PointCloudGeometry::PointCloudGeometry( void ) : GAVisToolGeometry( NORMAL_FORM )
 {
@@ -96,6 +100,8 @@ PointCloudGeometry::PointCloudGeometry( void ) : GAVisToolGeometry( NORMAL_FORM
 //=========================================================================================
 /*virtual*/ void PointCloudGeometry::Translate( const VectorMath::Vector& delta )
 {
+	Modified();
+
 	VectorMath::Add( center, center, delta );
 	for( int index = 0; index < convexHull.VertexCount(); index++ )
 		VectorMath::Add( convexHull[ index ], convexHull[ index ], delta );
@@ -104,6 +110,8 @@ PointCloudGeometry::PointCloudGeometry( void ) : GAVisToolGeometry( NORMAL_FORM
 //=========================================================================================
 /*virtual*/ void PointCloudGeometry::Rotate( const VectorMath::Vector& unitAxis, float angle )
 {
+	Modified();
+
 	for( int index = 0; index < convexHull.VertexCount(); index++ )
 	{
 		VectorMath::Vector vec;
@@ -116,6 +124,8 @@ PointCloudGeometry::PointCloudGeometry( void ) : GAVisToolGeometry( NORMAL_FORM
 //=========================================================================================
 /*virtual*/ void PointCloudGeometry::Scale( float scale )
 {
+	Modified();
+
 	for( int index = 0; index < convexHull.VertexCount(); index++ )
 	{
 		VectorMath::Vector vec;
@@ -10,19 +10,24 @@
  */
 
 #include "PointSampledGeometry.h"
+#include "../FunctionRegistry.h"
+#include "../Application.h"
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( PointSampledGeometry, GAVisToolGeometry );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar bindPsgRegistrar( "bind_psg", &PointSampledGeometry::Create, GAVisToolBindTarget::DOESNT_MATTER );
+
 //=========================================================================================
 PointSampledGeometry::PointSampledGeometry( BindType bindType ) : GAVisToolGeometry( bindType )
 {
+	pointCloudValid = false;
 }
 
 //=========================================================================================
 /*virtual*/ PointSampledGeometry::~PointSampledGeometry( void )
 {
-	pointList.RemoveAll( true );
 }
 
 //=========================================================================================
@@ -34,9 +39,13 @@ PointSampledGeometry::PointSampledGeometry( BindType bindType ) : GAVisToolGeome
 //=========================================================================================
 /*virtual*/ void PointSampledGeometry::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
 {
+	Modified();
+
 	surface.element.AssignSumOfBlades( element );
+	surface.Reduce();
 
-	pointList.RemoveAll( true );
+	pointCloud.WipeClean();
+	pointCloudValid = false;
 }
 
 //=========================================================================================
@@ -50,6 +59,16 @@ PointSampledGeometry::PointSampledGeometry( BindType bindType ) : GAVisToolGeome
 {
 }
 
+//=========================================================================================
+// The renderer draws our points straight out of the point cloud, so once we're unbound,
+// the primitive cache has to be regenerated before it draws again.
+/*virtual*/ void PointSampledGeometry::Finalize( void )
+{
+	GAVisToolGeometry::Finalize();
+
+	wxGetApp().canvasFrame->canvas->RedrawNeeded( true );
+}
+
 //=========================================================================================
 /*virtual*/ void PointSampledGeometry::AddInventoryTreeItem( wxTreeCtrl* treeCtrl, wxTreeItemId parentItem ) const
 {
@@ -58,7 +77,7 @@ PointSampledGeometry::PointSampledGeometry( BindType bindType ) : GAVisToolGeome
 //=========================================================================================
 /*virtual*/ void PointSampledGeometry::Draw( GAVisToolRender& render, bool selected )
 {
-	RegeneratePointListIfNeeded();
+	RegeneratePointCloudIfNeeded();
 
 	if( selected )
 		render.Highlight( GAVisToolRender::NORMAL_HIGHLIGHTING );
@@ -67,20 +86,20 @@ PointSampledGeometry::PointSampledGeometry( BindType bindType ) : GAVisToolGeome
 
 	render.Color( color, alpha );
 
-	VectorMath::Vector normal;
-	VectorMath::Set( normal, 0.0, 0.0, 1.0 );
-	for( Point* point = ( Point* )pointList.LeftMost(); point; point = ( Point* )point->Right() )
-		render.DrawPoint( point->point, normal );
+	render.DrawPoints( pointCloud.PointArray(), pointCloud.NormalArray(), pointCloud.PointCount() );
 }
 
 //=========================================================================================
 /*virtual*/ void PointSampledGeometry::CalcCenter( VectorMath::Vector& center ) const
 {
+	const VectorMath::Vector* pointArray = pointCloud.PointArray();
+	int pointCount = pointCloud.PointCount();
+
 	VectorMath::Zero( center );
-	for( Point* point = ( Point* )pointList.LeftMost(); point; point = ( Point* )point->Right() )
-		VectorMath::Add( center, center, point->point );
-	if( pointList.Count() > 0 )
-		VectorMath::Scale( center, center, 1.0 / double( pointList.Count() ) );
+	for( int index = 0; index < pointCount; index++ )
+		VectorMath::Add( center, center, pointArray[ index ] );
+	if( pointCount > 0 )
+		VectorMath::Scale( center, center, 1.0 / double( pointCount ) );
 }
 
 //=========================================================================================
@@ -105,50 +124,34 @@ PointSampledGeometry::PointSampledGeometry( BindType bindType ) : GAVisToolGeome
 }
 
 //=========================================================================================
-void PointSampledGeometry::RegeneratePointListIfNeeded( void )
+// The seeds are spread through the whole box, rather than around a sphere, so that we find
+// every part of the surface in it, and the layers of seeds are spread across our threads.
+// The cached evaluators of the script oracle are shared by everyone and can't be run on
+// more than one thread at a time, though, so with the oracle on, we generate serially.
+void PointSampledGeometry::RegeneratePointCloudIfNeeded( void )
 {
-	if( pointList.Count() > 0 )
+	if( pointCloudValid )
 		return;
 
-	double angleStepCount = 5.0;
-	double deltaTheta = 2.0 * M_PI / angleStepCount;
-	double deltaPhi = M_PI / angleStepCount;
-	double radius = 5.0;
+	VectorMath::ParallelInterface* parallelInterface = wxGetApp().threadPool;
+	if( GAVisToolGeometry::UsingScriptOracle() )
+		parallelInterface = 0;
 
-	for( double theta = 0.0; theta < 2.0 * M_PI; theta += deltaTheta )
-	{
-		double cosTheta = cos( theta );
-		double sinTheta = sin( theta );
-
-		for( double phi = 0.0; phi < M_PI; phi += deltaPhi )
-		{
-			double cosPhi = cos( phi );
-			double sinPhi = sin( phi );
-
-			Point* point = new Point();
-
-			VectorMath::Set( point->point, sinPhi * cosTheta, sinPhi * sinTheta, cosPhi );
-			VectorMath::Scale( point->point, point->point, radius );
-
-			pointList.InsertRightOf( pointList.RightMost(), point );
-		}
-	}
+	genParms.useNewtonSteps = UsingNewtonSteps();
 
 	// TODO: Throw up progress dialog box?
-	double epsilon = 1e-7;
-	Point* rightPoint = 0;
-	for( Point* point = ( Point* )pointList.LeftMost(); point; point = rightPoint )
-	{
-		rightPoint = ( Point* )point->Right();
-		if( !surface.ConvergePointToSurfaceInPlane( 0, point->point, epsilon ) )
-			pointList.Remove( point, true );
-	}
+	pointCloud.Generate( surface, genParms, parallelInterface );
+	pointCloudValid = true;
+
+	VectorMath::Surface::ConvergenceStats convergenceStats;
+	pointCloud.GetConvergenceStats( convergenceStats );
+	AccumulateConvergenceStats( CONVERGE_FOR_SAMPLING, convergenceStats );
 }
 
 //=========================================================================================
-PointSampledGeometry::Surface::Surface( void ) : calculator( "geoalg" )
+PointSampledGeometry::Surface::Surface( void )
 {
-	char code[512];
+	char code[4096];
 	
 	sprintf_s( code, sizeof( code ),
 		"do"
@@ -168,7 +171,7 @@ PointSampledGeometry::Surface::Surface( void ) : calculator( "geoalg" )
 			") . E,"
 			"result = grade_part( 0, dot * dot ),"
 		")" );
-	functionEvaluator = calculator.CompileEvaluator( code );
+	functionEvaluator = GAVisToolEvaluatorCache::Lookup( code );
 	wxASSERT( functionEvaluator != 0 );
 
 	sprintf_s( code, sizeof( code ),
@@ -196,7 +199,7 @@ PointSampledGeometry::Surface::Surface( void ) : calculator( "geoalg" )
 			") . E,"
 			"result = 2 * grade_part( 0, dot * partial_dot ),"
 		")" );
-	functionPartialXEvaluator = calculator.CompileEvaluator( code );
+	functionPartialXEvaluator = GAVisToolEvaluatorCache::Lookup( code );
 	wxASSERT( functionPartialXEvaluator != 0 );
 
 	sprintf_s( code, sizeof( code ),
@@ -224,7 +227,7 @@ PointSampledGeometry::Surface::Surface( void ) : calculator( "geoalg" )
 			") . E,"
 			"result = 2 * grade_part( 0, dot * partial_dot ),"
 		")" );
-	functionPartialYEvaluator = calculator.CompileEvaluator( code );
+	functionPartialYEvaluator = GAVisToolEvaluatorCache::Lookup( code );
 	wxASSERT( functionPartialYEvaluator != 0 );
 
 	sprintf_s( code, sizeof( code ),
@@ -252,67 +255,205 @@ PointSampledGeometry::Surface::Surface( void ) : calculator( "geoalg" )
 			") . E,"
 			"result = 2 * grade_part( 0, dot * partial_dot ),"
 		")" );
-	functionPartialZEvaluator = calculator.CompileEvaluator( code );
+	functionPartialZEvaluator = GAVisToolEvaluatorCache::Lookup( code );
 	wxASSERT( functionPartialZEvaluator != 0 );
 
-	CalcLib::GeometricAlgebraEnvironment* gaEnv = ( CalcLib::GeometricAlgebraEnvironment* )calculator.GetEnvironment();
-	number = gaEnv->CreateNumber();
+	// The reduction is the one script that still runs once we're bound, and only when E changes.
+	int length = sprintf_s( code, sizeof( code ), "do(" );
+	for( int i = 0; i < MONOMIAL_COUNT; i++ )
+		length += sprintf_s( code + length, sizeof( code ) - length, "b%d = e%d . E,", i, i );
+	for( int i = 0; i < MONOMIAL_COUNT; i++ )
+		for( int j = i; j < MONOMIAL_COUNT; j++ )
+			length += sprintf_s( code + length, sizeof( code ) - length, "g_%d_%d = grade_part( 0, b%d * b%d ),", i, j, i, j );
+	sprintf_s( code + length, sizeof( code ) - length, ")" );
+	reductionEvaluator = GAVisToolEvaluatorCache::Lookup( code );
+	wxASSERT( reductionEvaluator != 0 );
+
+	for( int i = 0; i < MONOMIAL_COUNT; i++ )
+		for( int j = 0; j < MONOMIAL_COUNT; j++ )
+			gramMatrix[i][j] = 0.0;
 }
 
 //=========================================================================================
 /*virtual*/ PointSampledGeometry::Surface::~Surface( void )
 {
-	delete functionEvaluator;
-	delete functionPartialXEvaluator;
-	delete functionPartialYEvaluator;
-	delete functionPartialZEvaluator;
-	delete number;
+}
+
+//=========================================================================================
+// The scalar part of a product doesn't depend on the order of its factors, so G is symmetric
+// and we only need to evaluate its upper triangle.
+void PointSampledGeometry::Surface::Reduce( void )
+{
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
+
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
+
+	multivector->AssignFrom( element, gaEnv );
+	gaEnv.StoreVariable( "E", *number );
+
+	reductionEvaluator->EvaluateResult( *number, gaEnv );
+
+	char name[32];
+	for( int i = 0; i < MONOMIAL_COUNT; i++ )
+	{
+		for( int j = i; j < MONOMIAL_COUNT; j++ )
+		{
+			sprintf_s( name, sizeof( name ), "g_%d_%d", i, j );
+			gaEnv.LookupVariable( name, *number );
+			multivector->AssignTo( gramMatrix[i][j], gaEnv );
+			gramMatrix[j][i] = gramMatrix[i][j];
+		}
+	}
+}
+
+//=========================================================================================
+// This gives back m and G m at the given point; everything we evaluate is built from those.
+void PointSampledGeometry::Surface::MultiplyGramMatrix( const VectorMath::Vector& point, double* monomial, double* product ) const
+{
+	monomial[0] = 1.0;
+	monomial[1] = point.x;
+	monomial[2] = point.y;
+	monomial[3] = point.z;
+	monomial[4] = point.y * point.z;
+	monomial[5] = point.z * point.x;
+	monomial[6] = point.x * point.y;
+	monomial[7] = point.x * point.x;
+	monomial[8] = point.y * point.y;
+	monomial[9] = point.z * point.z;
+
+	for( int i = 0; i < MONOMIAL_COUNT; i++ )
+	{
+		const double* row = gramMatrix[i];
+		double sum = 0.0;
+		for( int j = 0; j < MONOMIAL_COUNT; j++ )
+			sum += row[j] * monomial[j];
+		product[i] = sum;
+	}
 }
 
 //=========================================================================================
 /*virtual*/ double PointSampledGeometry::Surface::EvaluateAt( const VectorMath::Vector& point ) const
 {
-	return EvaluateWith( functionEvaluator, point );
+	if( GAVisToolGeometry::UsingScriptOracle() )
+		return EvaluateWith( functionEvaluator, point );
+
+	double monomial[ MONOMIAL_COUNT ], product[ MONOMIAL_COUNT ];
+	MultiplyGramMatrix( point, monomial, product );
+
+	double result = 0.0;
+	for( int i = 0; i < MONOMIAL_COUNT; i++ )
+		result += monomial[i] * product[i];
+	return result;
 }
 
 //=========================================================================================
+// Each partial is 2 ( dm/dx )^T G m, and only four of the monomials vary with any one coordinate.
 /*virtual*/ double PointSampledGeometry::Surface::EvaluatePartialX( const VectorMath::Vector& point ) const
 {
-	return EvaluateWith( functionPartialXEvaluator, point );
+	if( GAVisToolGeometry::UsingScriptOracle() )
+		return EvaluateWith( functionPartialXEvaluator, point );
+
+	double monomial[ MONOMIAL_COUNT ], product[ MONOMIAL_COUNT ];
+	MultiplyGramMatrix( point, monomial, product );
+
+	return 2.0 * ( product[1] + point.z * product[5] + point.y * product[6] + 2.0 * point.x * product[7] );
 }
 
 //=========================================================================================
 /*virtual*/ double PointSampledGeometry::Surface::EvaluatePartialY( const VectorMath::Vector& point ) const
 {
-	return EvaluateWith( functionPartialYEvaluator, point );
+	if( GAVisToolGeometry::UsingScriptOracle() )
+		return EvaluateWith( functionPartialYEvaluator, point );
+
+	double monomial[ MONOMIAL_COUNT ], product[ MONOMIAL_COUNT ];
+	MultiplyGramMatrix( point, monomial, product );
+
+	return 2.0 * ( product[2] + point.z * product[4] + point.x * product[6] + 2.0 * point.y * product[8] );
 }
 
 //=========================================================================================
 /*virtual*/ double PointSampledGeometry::Surface::EvaluatePartialZ( const VectorMath::Vector& point ) const
 {
-	return EvaluateWith( functionPartialZEvaluator, point );
+	if( GAVisToolGeometry::UsingScriptOracle() )
+		return EvaluateWith( functionPartialZEvaluator, point );
+
+	double monomial[ MONOMIAL_COUNT ], product[ MONOMIAL_COUNT ];
+	MultiplyGramMatrix( point, monomial, product );
+
+	return 2.0 * ( product[3] + point.y * product[4] + point.x * product[5] + 2.0 * point.z * product[9] );
+}
+
+//=========================================================================================
+// The base class would find G m three times over, so we do it once for all three partials.
+/*virtual*/ void PointSampledGeometry::Surface::EvaluateGradientAt( const VectorMath::Vector& point, VectorMath::Vector& gradient ) const
+{
+	if( GAVisToolGeometry::UsingScriptOracle() )
+	{
+		VectorMath::Surface::EvaluateGradientAt( point, gradient );
+		return;
+	}
+
+	double value;
+	EvaluateBatch( &point, 1, &value, &gradient );
+}
+
+//=========================================================================================
+/*virtual*/ void PointSampledGeometry::Surface::EvaluateBatch( const VectorMath::Vector* points, int count, double* values, VectorMath::Vector* gradients ) const
+{
+	if( GAVisToolGeometry::UsingScriptOracle() )
+	{
+		VectorMath::Surface::EvaluateBatch( points, count, values, gradients );
+		return;
+	}
+
+	double monomial[ MONOMIAL_COUNT ], product[ MONOMIAL_COUNT ];
+
+	for( int index = 0; index < count; index++ )
+	{
+		const VectorMath::Vector& point = points[ index ];
+		MultiplyGramMatrix( point, monomial, product );
+
+		double value = 0.0;
+		for( int i = 0; i < MONOMIAL_COUNT; i++ )
+			value += monomial[i] * product[i];
+		values[ index ] = value;
+
+		if( gradients )
+		{
+			VectorMath::Vector& gradient = gradients[ index ];
+			gradient.x = 2.0 * ( product[1] + point.z * product[5] + point.y * product[6] + 2.0 * point.x * product[7] );
+			gradient.y = 2.0 * ( product[2] + point.z * product[4] + point.x * product[6] + 2.0 * point.y * product[8] );
+			gradient.z = 2.0 * ( product[3] + point.y * product[4] + point.x * product[5] + 2.0 * point.z * product[9] );
+		}
+	}
 }
 
 //=========================================================================================
+// This is the way the surface used to be evaluated, and is kept to check the reduction against.
 double PointSampledGeometry::Surface::EvaluateWith( CalcLib::Evaluator* evaluator, const VectorMath::Vector& point ) const
 {
-	CalcLib::GeometricAlgebraEnvironment* gaEnv = ( CalcLib::GeometricAlgebraEnvironment* )calculator.GetEnvironment();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
-
-	multivector->AssignFrom( element, *gaEnv );
-	gaEnv->StoreVariable( "E", *number );
-	multivector->AssignFrom( point.x, *gaEnv );
-	gaEnv->StoreVariable( "x", *number );
-	multivector->AssignFrom( point.y, *gaEnv );
-	gaEnv->StoreVariable( "y", *number );
-	multivector->AssignFrom( point.z, *gaEnv );
-	gaEnv->StoreVariable( "z", *number );
-
-	evaluator->EvaluateResult( *number, *gaEnv );
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
+
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
+
+	multivector->AssignFrom( element, gaEnv );
+	gaEnv.StoreVariable( "E", *number );
+	multivector->AssignFrom( point.x, gaEnv );
+	gaEnv.StoreVariable( "x", *number );
+	multivector->AssignFrom( point.y, gaEnv );
+	gaEnv.StoreVariable( "y", *number );
+	multivector->AssignFrom( point.z, gaEnv );
+	gaEnv.StoreVariable( "z", *number );
+
+	evaluator->EvaluateResult( *number, gaEnv );
 	
 	double result;
-	gaEnv->LookupVariable( "result", *number );
-	multivector->AssignTo( result, *gaEnv );
+	gaEnv.LookupVariable( "result", *number );
+	multivector->AssignTo( result, gaEnv );
 	return result;
 }
 
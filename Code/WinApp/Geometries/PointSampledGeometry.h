@@ -13,6 +13,7 @@
 
 #include "../Geometry.h"
 #include "../VectorMath/Surface.h"
+#include "../VectorMath/PointCloud.h"
 
 //=========================================================================================
 class PointSampledGeometry : public GAVisToolGeometry
@@ -31,6 +32,8 @@ public:
 
 	virtual void DumpInfo( char* printBuffer, int printBufferSize ) const override;
 
+	virtual void Finalize( void ) override;
+
 	virtual void AddInventoryTreeItem( wxTreeCtrl* treeCtrl, wxTreeItemId parentItem ) const override;
 
 	virtual void Draw( GAVisToolRender& render, bool selected ) override;
@@ -55,12 +58,23 @@ private:
 		virtual double EvaluatePartialX( const VectorMath::Vector& point ) const override;
 		virtual double EvaluatePartialY( const VectorMath::Vector& point ) const override;
 		virtual double EvaluatePartialZ( const VectorMath::Vector& point ) const override;
+		virtual void EvaluateGradientAt( const VectorMath::Vector& point, VectorMath::Vector& gradient ) const override;
+		virtual void EvaluateBatch( const VectorMath::Vector* points, int count, double* values, VectorMath::Vector* gradients ) const override;
 
 		double EvaluateWith( CalcLib::Evaluator* evaluator, const VectorMath::Vector& point ) const;
 
-		mutable CalcLib::Calculator calculator;
-		CalcLib::Number* number;
+		// The scripts dot E with a vector whose coefficients are the monomials 1, x, y, z, yz, zx, xy,
+		// x^2, y^2 and z^2.  Calling that vector of monomials m, the surface is f = m^T G m, where
+		// G_ij = <( e_i . E )( e_j . E )>_0 depends only on E.  We find G once per decomposition,
+		// and from then on, the function and its partials are evaluated without the scripts.
+		enum { MONOMIAL_COUNT = 10 };
+
+		void Reduce( void );
+		void MultiplyGramMatrix( const VectorMath::Vector& point, double* monomial, double* product ) const;
 
+		double gramMatrix[ MONOMIAL_COUNT ][ MONOMIAL_COUNT ];
+
+		CalcLib::Evaluator* reductionEvaluator;
 		CalcLib::Evaluator* functionEvaluator;
 		CalcLib::Evaluator* functionPartialXEvaluator;
 		CalcLib::Evaluator* functionPartialYEvaluator;
@@ -71,16 +85,11 @@ private:
 
 	Surface surface;
 
-	//=========================================================================================
-	class Point : public Utilities::List::Item
-	{
-	public:
-		VectorMath::Vector point;
-	};
-
-	Utilities::List pointList;
+	VectorMath::PointCloud pointCloud;
+	VectorMath::PointCloud::GenerationParameters genParms;
+	bool pointCloudValid;
 
-	void RegeneratePointListIfNeeded( void );
+	void RegeneratePointCloudIfNeeded( void );
 };
 
 // PointSampledGeometry.h
\ No newline at end of file
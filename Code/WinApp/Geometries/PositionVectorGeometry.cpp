@@ -10,17 +10,19 @@
  */
 
 #include "PositionVectorGeometry.h"
+#include "../FunctionRegistry.h"
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( PositionVector, GAVisToolGeometry );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar bindPosvecRegistrar( "bind_posvec", &PositionVector::Create, GAVisToolBindTarget::DOESNT_MATTER );
+
 //=========================================================================================
 PositionVector::PositionVector( BindType bindType ) : GAVisToolGeometry( bindType )
 {
 	VectorMath::Set( position, 0.0, 0.0, 0.0 );
 
-	CalcLib::Calculator calculator( "geoalg" );
-
 	char decompositionCode[ 512 ];
 	sprintf_s( decompositionCode, sizeof( decompositionCode ),
 		"do("
@@ -29,14 +31,14 @@ PositionVector::PositionVector( BindType bindType ) : GAVisToolGeometry( bindTyp
 		"z = scalar_part( v, e3 ),"
 		")"
 	);
-	decompositionEvaluator = calculator.CompileEvaluator( decompositionCode );
+	decompositionEvaluator = GAVisToolEvaluatorCache::Lookup( decompositionCode );
 	wxASSERT( decompositionEvaluator != 0 );
 
 	char compositionCode[ 512 ];
 	sprintf_s( compositionCode, sizeof( compositionCode ),
 		"v = x*e1 + y*e2 + z*e3"
 	);
-	compositionEvaluator = calculator.CompileEvaluator( compositionCode );
+	compositionEvaluator = GAVisToolEvaluatorCache::Lookup( compositionCode );
 	wxASSERT( compositionEvaluator != 0 );
 }
 
@@ -54,10 +56,13 @@ PositionVector::PositionVector( BindType bindType ) : GAVisToolGeometry( bindTyp
 //=========================================================================================
 /*virtual*/ void PositionVector::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	Modified();
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
+
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	multivector->AssignFrom( element, gaEnv );
 	gaEnv.StoreVariable( "v", *number );
@@ -70,17 +75,16 @@ PositionVector::PositionVector( BindType bindType ) : GAVisToolGeometry( bindTyp
 	multivector->AssignTo( position.y, gaEnv );
 	gaEnv.LookupVariable( "z", *number );
 	multivector->AssignTo( position.z, gaEnv );
-
-	delete number;
 }
 
 //=========================================================================================
 /*virtual*/ void PositionVector::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	number->AssignFrom( position.x, gaEnv );
 	gaEnv.StoreVariable( "x", *number );
@@ -93,8 +97,6 @@ PositionVector::PositionVector( BindType bindType ) : GAVisToolGeometry( bindTyp
 
 	gaEnv.LookupVariable( "v", *number );
 	multivector->AssignTo( element, gaEnv );
-
-	delete number;
 }
 
 //=========================================================================================
@@ -135,6 +137,7 @@ PositionVector::PositionVector( BindType bindType ) : GAVisToolGeometry( bindTyp
 //=========================================================================================
 /*virtual*/ void PositionVector::Translate( const VectorMath::Vector& delta )
 {
+	Modified();
 	VectorMath::Add( position, position, delta );
 }
 
@@ -10,18 +10,20 @@
  */
 
 #include "ProjectiveGeometry.h"
+#include "../FunctionRegistry.h"
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( ProjectivePoint, GAVisToolGeometry );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar bindProjPointRegistrar( "bind_proj_point", &ProjectivePoint::Create, GAVisToolBindTarget::DOESNT_MATTER );
+
 //=========================================================================================
 ProjectivePoint::ProjectivePoint( BindType bindType ) : GAVisToolGeometry( bindType )
 {
 	VectorMath::Zero( center );
 	weight = 1.0;
 
-	CalcLib::Calculator calculator( "geoalg" );
-
 	char decompositionCode[ 512 ];
 	sprintf_s( decompositionCode, sizeof( decompositionCode ),
 		"do("
@@ -32,7 +34,7 @@ ProjectivePoint::ProjectivePoint( BindType bindType ) : GAVisToolGeometry( bindT
 		"z = scalar_part( pt, e3 ),"
 		")"
 	);
-	decompositionEvaluator = calculator.CompileEvaluator( decompositionCode );
+	decompositionEvaluator = GAVisToolEvaluatorCache::Lookup( decompositionCode );
 	wxASSERT( decompositionEvaluator != 0 );
 
 	char compositionCode[ 512 ];
@@ -42,7 +44,7 @@ ProjectivePoint::ProjectivePoint( BindType bindType ) : GAVisToolGeometry( bindT
 		"pt = w*(c + e0),"
 		")"
 	);
-	compositionEvaluator = calculator.CompileEvaluator( compositionCode );
+	compositionEvaluator = GAVisToolEvaluatorCache::Lookup( compositionCode );
 	wxASSERT( compositionEvaluator != 0 );
 }
 
@@ -60,10 +62,13 @@ ProjectivePoint::ProjectivePoint( BindType bindType ) : GAVisToolGeometry( bindT
 //=========================================================================================
 /*virtual*/ void ProjectivePoint::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	Modified();
+
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 	
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = number->Cast< CalcLib::MultivectorNumber >();
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	multivector->AssignFrom( element, gaEnv );
 	gaEnv.StoreVariable( "pt", *number );
@@ -78,17 +83,16 @@ ProjectivePoint::ProjectivePoint( BindType bindType ) : GAVisToolGeometry( bindT
 	multivector->AssignTo( center.y, gaEnv );
 	gaEnv.LookupVariable( "z", *number );
 	multivector->AssignTo( center.z, gaEnv );
-
-	delete number;
 }
 
 //=========================================================================================
 /*virtual*/ void ProjectivePoint::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = number->Cast< CalcLib::MultivectorNumber >();
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	number->AssignFrom( weight, gaEnv );
 	gaEnv.StoreVariable( "w", *number );
@@ -103,8 +107,6 @@ ProjectivePoint::ProjectivePoint( BindType bindType ) : GAVisToolGeometry( bindT
 
 	gaEnv.LookupVariable( "pt", *number );
 	multivector->AssignTo( element, gaEnv );
-
-	delete number;
 }
 
 //=========================================================================================
@@ -148,6 +150,7 @@ ProjectivePoint::ProjectivePoint( BindType bindType ) : GAVisToolGeometry( bindT
 //=========================================================================================
 /*virtual*/ void ProjectivePoint::Translate( const VectorMath::Vector& delta )
 {
+	Modified();
 	VectorMath::Add( center, center, delta );
 }
 
@@ -172,6 +175,9 @@ ProjectivePoint::ProjectivePoint( BindType bindType ) : GAVisToolGeometry( bindT
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( ProjectiveLine, GAVisToolGeometry );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar bindProjLineRegistrar( "bind_proj_line", &ProjectiveLine::Create, GAVisToolBindTarget::DOESNT_MATTER );
+
 //=========================================================================================
 ProjectiveLine::ProjectiveLine( BindType bindType ) : GAVisToolGeometry( bindType )
 {
@@ -179,8 +185,6 @@ ProjectiveLine::ProjectiveLine( BindType bindType ) : GAVisToolGeometry( bindTyp
 	VectorMath::Set( unitNormal, 0.0, 0.0, 1.0 );
 	weight = 1.0;
 
-	CalcLib::Calculator calculator( "geoalg" );
-
 	char decompositionCode[ 512 ];
 	sprintf_s( decompositionCode, sizeof( decompositionCode ),
 		"do("
@@ -197,7 +201,7 @@ ProjectiveLine::ProjectiveLine( BindType bindType ) : GAVisToolGeometry( bindTyp
 		"nz = scalar_part( n, e3 ),"
 		")"
 	);
-	decompositionEvaluator = calculator.CompileEvaluator( decompositionCode );
+	decompositionEvaluator = GAVisToolEvaluatorCache::Lookup( decompositionCode );
 	wxASSERT( decompositionEvaluator != 0 );
 
 	char compositionCode[ 512 ];
@@ -208,7 +212,7 @@ ProjectiveLine::ProjectiveLine( BindType bindType ) : GAVisToolGeometry( bindTyp
 		"lin = w*(c + e0)^n,"
 		")"
 	);
-	compositionEvaluator = calculator.CompileEvaluator( compositionCode );
+	compositionEvaluator = GAVisToolEvaluatorCache::Lookup( compositionCode );
 	wxASSERT( compositionEvaluator != 0 );
 }
 
@@ -226,10 +230,13 @@ ProjectiveLine::ProjectiveLine( BindType bindType ) : GAVisToolGeometry( bindTyp
 //=========================================================================================
 /*virtual*/ void ProjectiveLine::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	Modified();
+
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	multivector->AssignFrom( element, gaEnv );
 	gaEnv.StoreVariable( "lin", *number );
@@ -250,17 +257,16 @@ ProjectiveLine::ProjectiveLine( BindType bindType ) : GAVisToolGeometry( bindTyp
 	multivector->AssignTo( unitNormal.y, gaEnv );
 	gaEnv.LookupVariable( "nz", *number );
 	multivector->AssignTo( unitNormal.z, gaEnv );
-
-	delete number;
 }
 
 //=========================================================================================
 /*virtual*/ void ProjectiveLine::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	number->AssignFrom( weight, gaEnv );
 	gaEnv.StoreVariable( "w", *number );
@@ -281,8 +287,6 @@ ProjectiveLine::ProjectiveLine( BindType bindType ) : GAVisToolGeometry( bindTyp
 
 	gaEnv.LookupVariable( "lin", *number );
 	multivector->AssignTo( element, gaEnv );
-
-	delete number;
 }
 
 //=========================================================================================
@@ -334,12 +338,14 @@ ProjectiveLine::ProjectiveLine( BindType bindType ) : GAVisToolGeometry( bindTyp
 //=========================================================================================
 /*virtual*/ void ProjectiveLine::Translate( const VectorMath::Vector& delta )
 {
+	Modified();
 	VectorMath::Add( center, center, delta );
 }
 
 //=========================================================================================
 /*virtual*/ void ProjectiveLine::Rotate( const VectorMath::Vector& unitAxis, float angle )
 {
+	Modified();
 	VectorMath::Rotate( unitNormal, unitNormal, unitAxis, angle );
 }
 
@@ -358,6 +364,9 @@ ProjectiveLine::ProjectiveLine( BindType bindType ) : GAVisToolGeometry( bindTyp
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( ProjectivePlane, GAVisToolGeometry );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar bindProjPlaneRegistrar( "bind_proj_plane", &ProjectivePlane::Create, GAVisToolBindTarget::DOESNT_MATTER );
+
 //=========================================================================================
 ProjectivePlane::ProjectivePlane( BindType bindType ) : GAVisToolGeometry( bindType )
 {
@@ -365,8 +374,6 @@ ProjectivePlane::ProjectivePlane( BindType bindType ) : GAVisToolGeometry( bindT
 	VectorMath::Set( unitNormal, 0.0, 0.0, 1.0 );
 	weight = 1.0;
 
-	CalcLib::Calculator calculator( "geoalg" );
-
 	char decompositionCode[ 512 ];
 	sprintf_s( decompositionCode, sizeof( decompositionCode ),
 		"do("
@@ -383,7 +390,7 @@ ProjectivePlane::ProjectivePlane( BindType bindType ) : GAVisToolGeometry( bindT
 		"nz = scalar_part( n, e3 ),"
 		")"
 	);
-	decompositionEvaluator = calculator.CompileEvaluator( decompositionCode );
+	decompositionEvaluator = GAVisToolEvaluatorCache::Lookup( decompositionCode );
 	wxASSERT( decompositionEvaluator != 0 );
 
 	char compositionCode[ 512 ];
@@ -394,7 +401,7 @@ ProjectivePlane::ProjectivePlane( BindType bindType ) : GAVisToolGeometry( bindT
 		"pln = w*(c + e0)^( -n*( e1^e2^e3 ) ),"
 		")"
 	);
-	compositionEvaluator = calculator.CompileEvaluator( compositionCode );
+	compositionEvaluator = GAVisToolEvaluatorCache::Lookup( compositionCode );
 	wxASSERT( compositionEvaluator != 0 );
 }
 
@@ -412,10 +419,13 @@ ProjectivePlane::ProjectivePlane( BindType bindType ) : GAVisToolGeometry( bindT
 //=========================================================================================
 /*virtual*/ void ProjectivePlane::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	Modified();
+
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	multivector->AssignFrom( element, gaEnv );
 	gaEnv.StoreVariable( "pln", *number );
@@ -436,17 +446,16 @@ ProjectivePlane::ProjectivePlane( BindType bindType ) : GAVisToolGeometry( bindT
 	multivector->AssignTo( unitNormal.y, gaEnv );
 	gaEnv.LookupVariable( "nz", *number );
 	multivector->AssignTo( unitNormal.z, gaEnv );
-
-	delete number;
 }
 
 //=========================================================================================
 /*virtual*/ void ProjectivePlane::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	number->AssignFrom( weight, gaEnv );
 	gaEnv.StoreVariable( "w", *number );
@@ -467,8 +476,6 @@ ProjectivePlane::ProjectivePlane( BindType bindType ) : GAVisToolGeometry( bindT
 
 	gaEnv.LookupVariable( "pln", *number );
 	multivector->AssignTo( element, gaEnv );
-
-	delete number;
 }
 
 //=========================================================================================
@@ -516,12 +523,14 @@ ProjectivePlane::ProjectivePlane( BindType bindType ) : GAVisToolGeometry( bindT
 //=========================================================================================
 /*virtual*/ void ProjectivePlane::Translate( const VectorMath::Vector& delta )
 {
+	Modified();
 	VectorMath::Add( center, center, delta );
 }
 
 //=========================================================================================
 /*virtual*/ void ProjectivePlane::Rotate( const VectorMath::Vector& unitAxis, float angle )
 {
+	Modified();
 	VectorMath::Rotate( unitNormal, unitNormal, unitAxis, angle );
 }
 
@@ -10,15 +10,17 @@
  */
 
 #include "QuadricGeometry.h"
+#include "../FunctionRegistry.h"
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( QuadricGeometry, SurfaceGeometry );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar bindQuadricRegistrar( "bind_quadric", &QuadricGeometry::Create, GAVisToolBindTarget::DOESNT_MATTER );
+
 //=========================================================================================
 QuadricGeometry::QuadricGeometry( BindType bindType ) : SurfaceGeometry( bindType, &quadric )
 {
-	CalcLib::Calculator calculator( "geoalg" );
-
 	// ( no + x*e1 + y*e2 + z*e3 )^( nob + x*e1b + y*e2b + z*e3b )
 	// = 1*( no^nob )
 	// + x*( no^e1b + e1^nob )
@@ -48,8 +50,11 @@ QuadricGeometry::QuadricGeometry( BindType bindType ) : SurfaceGeometry( bindTyp
 		"quadric_J = -scalar_part( quadric, ni^nib ),"
 		")"
 	);
-	decompositionEvaluator = calculator.CompileEvaluator( decompositionCode );
+	decompositionEvaluator = GAVisToolEvaluatorCache::Lookup( decompositionCode );
 	wxASSERT( decompositionEvaluator != 0 );
+
+	VectorMath::QuadricMesh::Classify( quadric, classification );
+	quadricMeshValid = false;
 }
 
 //=========================================================================================
@@ -68,10 +73,11 @@ QuadricGeometry::QuadricGeometry( BindType bindType ) : SurfaceGeometry( bindTyp
 {
 	SurfaceGeometry::DecomposeFrom( element );
 
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	multivector->AssignFrom( element, gaEnv );
 	gaEnv.StoreVariable( "quadric", *number );
@@ -99,13 +105,38 @@ QuadricGeometry::QuadricGeometry( BindType bindType ) : SurfaceGeometry( bindTyp
 	gaEnv.LookupVariable( "quadric_J", *number );
 	multivector->AssignTo( quadric.J, gaEnv );
 
-	delete number;
+	VectorMath::QuadricMesh::Classify( quadric, classification );
+}
+
+//=========================================================================================
+/*virtual*/ void QuadricGeometry::RegenerateSurfaceGeometry( void )
+{
+	quadricMeshValid = false;
+
+	if( renderAs == RENDER_AS_TRIANGLE_MESH )
+	{
+		VectorMath::QuadricMesh::GenerationParameters genParms;
+		quadricMeshValid = quadricMesh.Generate( quadric, classification, genParms );
+		if( quadricMeshValid )
+			return;
+	}
+
+	SurfaceGeometry::RegenerateSurfaceGeometry();
+}
+
+//=========================================================================================
+/*virtual*/ void QuadricGeometry::RenderMesh( VectorMath::SurfaceMesh::RenderInterface& renderInterface )
+{
+	if( renderAs == RENDER_AS_TRIANGLE_MESH && quadricMeshValid )
+		quadricMesh.Render( renderInterface, color, alpha );
+	else
+		SurfaceGeometry::RenderMesh( renderInterface );
 }
 
 //=========================================================================================
 /*virtual*/ void QuadricGeometry::DumpInfo( char* printBuffer, int printBufferSize ) const
 {
-	sprintf_s( printBuffer, printBufferSize, "The variable \"%s\" is being interpreted as a quadric.\n", name );
+	sprintf_s( printBuffer, printBufferSize, "The variable \"%s\" is being interpreted as a quadric.\nIt is a %s.\n", name, VectorMath::QuadricMesh::TypeName( classification.type ) );
 }
 
 //=========================================================================================
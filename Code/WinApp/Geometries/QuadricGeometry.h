@@ -14,13 +14,13 @@
 #include "SurfaceGeometry.h"
 #include "../VectorMath/Surface.h"
 #include "../VectorMath/ConvexHull.h"
+#include "../VectorMath/QuadricMesh.h"
 
 //=========================================================================================
-// This bind target can interpret any quadric geometry.  It may be
-// worth creating specific bind targets for specific quadric geometries,
-// so that those geometries can be rendered using a triangle mesh.
-// To render general quadrics using a triangle mesh would require
-// a fairly sufisticated skinning algorithm.
+// This bind target can interpret any quadric geometry.  Rather than
+// search for the surface, its triangle mesh is made by classifying the
+// quadric and tessellating the canonical surface it turns out to be.
+// Only the degenerate quadrics fall back to the general skinning algorithm.
 class QuadricGeometry : public SurfaceGeometry
 {
 	DECLARE_CALCLIB_CLASS( QuadricGeometry );
@@ -39,9 +39,15 @@ public:
 
 private:
 
+	virtual void RegenerateSurfaceGeometry( void ) override;
+	virtual void RenderMesh( VectorMath::SurfaceMesh::RenderInterface& renderInterface ) override;
+
 	void DrawTrace( VectorMath::Quadric::Trace* trace, GAVisToolRender& render );
 
 	VectorMath::Quadric quadric;
+	VectorMath::QuadricMesh quadricMesh;
+	VectorMath::QuadricMesh::Classification classification;
+	bool quadricMeshValid;
 };
 
 // QuadricGeometry.h
\ No newline at end of file
@@ -10,18 +10,22 @@
  */
 
 #include "RoundGeometry.h"
+#include "ConformalBlades.h"
+#include "../FunctionRegistry.h"
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( ConformalPoint, GAVisToolGeometry );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar bindPointRegistrar( "bind_point", &ConformalPoint::Create, GAVisToolBindTarget::NORMAL_FORM );
+static GAVisToolFunctionRegistry::Registrar bindDualPointRegistrar( "bind_dual_point", &ConformalPoint::Create, GAVisToolBindTarget::DUAL_FORM );
+
 //=========================================================================================
 ConformalPoint::ConformalPoint( BindType bindType ) : GAVisToolGeometry( bindType )
 {
 	VectorMath::Zero( center );
 	weight = 1.0;
 
-	CalcLib::Calculator calculator( "geoalg" );
-
 	char decompositionCode[ 512 ];
 	sprintf_s( decompositionCode, sizeof( decompositionCode ),
 		"do("
@@ -34,7 +38,7 @@ ConformalPoint::ConformalPoint( BindType bindType ) : GAVisToolGeometry( bindTyp
 		")",
 		( bindType == NORMAL_FORM ? "pt = pt*I," : "" )
 	);
-	decompositionEvaluator = calculator.CompileEvaluator( decompositionCode );
+	decompositionEvaluator = GAVisToolEvaluatorCache::Lookup( decompositionCode );
 	wxASSERT( decompositionEvaluator != 0 );
 
 	char compositionCode[ 512 ];
@@ -45,7 +49,7 @@ ConformalPoint::ConformalPoint( BindType bindType ) : GAVisToolGeometry( bindTyp
 		")",
 		( bindType == NORMAL_FORM ? "*-I" : "" )
 	);
-	compositionEvaluator = calculator.CompileEvaluator( compositionCode );
+	compositionEvaluator = GAVisToolEvaluatorCache::Lookup( compositionCode );
 	wxASSERT( compositionEvaluator != 0 );
 }
 
@@ -61,14 +65,15 @@ ConformalPoint::ConformalPoint( BindType bindType ) : GAVisToolGeometry( bindTyp
 }
 
 //=========================================================================================
-/*virtual*/ void ConformalPoint::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
+void ConformalPoint::DecomposeWithScript( const GeometricAlgebra::SumOfBlades& element )
 {
-	// Use a locally scoped environment so that we don't pollute the name-space in the user's GA environment.
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	// Borrow a scratch environment so that we don't pollute the name-space in the user's GA environment.
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 	
-	// Create a number we can use.
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	// It comes with a number we can use.
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	// Stuff the given element into a variable as input to our decomposition script.
 	multivector->AssignFrom( element, gaEnv );
@@ -86,20 +91,18 @@ ConformalPoint::ConformalPoint( BindType bindType ) : GAVisToolGeometry( bindTyp
 	multivector->AssignTo( center.y, gaEnv );
 	gaEnv.LookupVariable( "z", *number );
 	multivector->AssignTo( center.z, gaEnv );
-
-	// We're done with this.
-	delete number;
 }
 
 //=========================================================================================
-/*virtual*/ void ConformalPoint::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
+void ConformalPoint::ComposeWithScript( GeometricAlgebra::SumOfBlades& element ) const
 {
-	// Use a locally scoped environment so that we don't pollute the name-space in the user's GA environment.
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	// Borrow a scratch environment so that we don't pollute the name-space in the user's GA environment.
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	// Create a number we can use.
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	// It comes with a number we can use.
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	// Stuff our internal representation into the environment as input to our composition script.
 	number->AssignFrom( weight, gaEnv );
@@ -117,9 +120,46 @@ ConformalPoint::ConformalPoint( BindType bindType ) : GAVisToolGeometry( bindTyp
 	// Collect the output result of the script.
 	gaEnv.LookupVariable( "pt", *number );
 	multivector->AssignTo( element, gaEnv );
+}
+
+//=========================================================================================
+/*virtual*/ void ConformalPoint::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
+{
+	Modified();
+
+	if( useScriptOracle )
+	{
+		DecomposeWithScript( element );
+		return;
+	}
+
+	ConformalCoefficients coefficients;
+	if( !AssignDualFormFrom( coefficients, element, 1 ) )
+		return;
+
+	double w = coefficients.coefficient[ ConformalCoefficients::NO ];
+	if( w == 0.0 )
+		return;
 
-	// We're done with this.
-	delete number;
+	weight = w;
+	VectorMath::Set( center,
+		coefficients.coefficient[ ConformalCoefficients::E1 ] / weight,
+		coefficients.coefficient[ ConformalCoefficients::E2 ] / weight,
+		coefficients.coefficient[ ConformalCoefficients::E3 ] / weight );
+}
+
+//=========================================================================================
+/*virtual*/ void ConformalPoint::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
+{
+	if( useScriptOracle )
+	{
+		ComposeWithScript( element );
+		return;
+	}
+
+	ConformalCoefficients coefficients;
+	ConformalPointVector( center, weight ).AssignTo( coefficients );
+	AssignDualFormTo( coefficients, element );
 }
 
 //=========================================================================================
@@ -170,6 +210,7 @@ ConformalPoint::ConformalPoint( BindType bindType ) : GAVisToolGeometry( bindTyp
 //=========================================================================================
 /*virtual*/ void ConformalPoint::Translate( const VectorMath::Vector& delta )
 {
+	Modified();
 	VectorMath::Add( center, center, delta );
 }
 
@@ -188,6 +229,10 @@ ConformalPoint::ConformalPoint( BindType bindType ) : GAVisToolGeometry( bindTyp
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( ConformalSphere, GAVisToolGeometry );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar bindSphereRegistrar( "bind_sphere", &ConformalSphere::Create, GAVisToolBindTarget::NORMAL_FORM );
+static GAVisToolFunctionRegistry::Registrar bindDualSphereRegistrar( "bind_dual_sphere", &ConformalSphere::Create, GAVisToolBindTarget::DUAL_FORM );
+
 //=========================================================================================
 ConformalSphere::ConformalSphere( BindType bindType ) : GAVisToolGeometry( bindType )
 {
@@ -196,8 +241,6 @@ ConformalSphere::ConformalSphere( BindType bindType ) : GAVisToolGeometry( bindT
 	weight = 1.0;
 	imaginary = false;
 
-	CalcLib::Calculator calculator( "geoalg" );
-
 	char decompositionCode[ 512 ];
 	sprintf_s( decompositionCode, sizeof( decompositionCode ),
 		"do("
@@ -213,7 +256,7 @@ ConformalSphere::ConformalSphere( BindType bindType ) : GAVisToolGeometry( bindT
 		")",
 		( bindType == NORMAL_FORM ? "sph = sph*I," : "" )
 	);
-	decompositionEvaluator = calculator.CompileEvaluator( decompositionCode );
+	decompositionEvaluator = GAVisToolEvaluatorCache::Lookup( decompositionCode );
 	wxASSERT( decompositionEvaluator != 0 );
 
 	char compositionCode[ 512 ];
@@ -224,7 +267,7 @@ ConformalSphere::ConformalSphere( BindType bindType ) : GAVisToolGeometry( bindT
 		")",
 		( bindType == NORMAL_FORM ? "*-I" : "" )
 	);
-	compositionEvaluator = calculator.CompileEvaluator( compositionCode );
+	compositionEvaluator = GAVisToolEvaluatorCache::Lookup( compositionCode );
 	wxASSERT( compositionEvaluator != 0 );
 }
 
@@ -240,12 +283,13 @@ ConformalSphere::ConformalSphere( BindType bindType ) : GAVisToolGeometry( bindT
 }
 
 //=========================================================================================
-/*virtual*/ void ConformalSphere::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
+void ConformalSphere::DecomposeWithScript( const GeometricAlgebra::SumOfBlades& element )
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	multivector->AssignFrom( element, gaEnv );
 	gaEnv.StoreVariable( "sph", *number );
@@ -270,17 +314,16 @@ ConformalSphere::ConformalSphere( BindType bindType ) : GAVisToolGeometry( bindT
 		imaginary = true;
 	else
 		imaginary = false;
-
-	delete number;
 }
 
 //=========================================================================================
-/*virtual*/ void ConformalSphere::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
+void ConformalSphere::ComposeWithScript( GeometricAlgebra::SumOfBlades& element ) const
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	double scalar = 1.0;
 	if( imaginary )
@@ -303,8 +346,65 @@ ConformalSphere::ConformalSphere( BindType bindType ) : GAVisToolGeometry( bindT
 
 	gaEnv.LookupVariable( "sph", *number );
 	multivector->AssignTo( element, gaEnv );
+}
 
-	delete number;
+//=========================================================================================
+/*virtual*/ void ConformalSphere::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
+{
+	Modified();
+
+	if( useScriptOracle )
+	{
+		DecomposeWithScript( element );
+		return;
+	}
+
+	ConformalCoefficients coefficients;
+	if( !AssignDualFormFrom( coefficients, element, 1 ) )
+		return;
+
+	double w = coefficients.coefficient[ ConformalCoefficients::NO ];
+	if( w == 0.0 )
+		return;
+
+	weight = w;
+	VectorMath::Set( center,
+		coefficients.coefficient[ ConformalCoefficients::E1 ] / weight,
+		coefficients.coefficient[ ConformalCoefficients::E2 ] / weight,
+		coefficients.coefficient[ ConformalCoefficients::E3 ] / weight );
+
+	// The coefficient of ni is 0.5*( v . v - r2 ) once the weight is divided out.
+	double r2 = VectorMath::Dot( center, center ) - 2.0 * coefficients.coefficient[ ConformalCoefficients::NI ] / weight;
+	radius = sqrt( fabs( r2 ) );
+	if( r2 < 0.0 )
+		imaginary = true;
+	else
+		imaginary = false;
+}
+
+//=========================================================================================
+/*virtual*/ void ConformalSphere::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
+{
+	if( useScriptOracle )
+	{
+		ComposeWithScript( element );
+		return;
+	}
+
+	ConformalCoefficients coefficients;
+
+	double scalar = 1.0;
+	if( imaginary )
+		scalar = -1.0;
+
+	// sph = w*( no + v + 0.5*( v . v - scale*r*r )*ni )
+	coefficients.coefficient[ ConformalCoefficients::NO ] = weight;
+	coefficients.coefficient[ ConformalCoefficients::E1 ] = weight * center.x;
+	coefficients.coefficient[ ConformalCoefficients::E2 ] = weight * center.y;
+	coefficients.coefficient[ ConformalCoefficients::E3 ] = weight * center.z;
+	coefficients.coefficient[ ConformalCoefficients::NI ] = weight * 0.5 * ( VectorMath::Dot( center, center ) - scalar * radius * radius );
+
+	AssignDualFormTo( coefficients, element );
 }
 
 //=========================================================================================
@@ -394,6 +494,7 @@ ConformalSphere::ConformalSphere( BindType bindType ) : GAVisToolGeometry( bindT
 //=========================================================================================
 /*virtual*/ void ConformalSphere::Translate( const VectorMath::Vector& delta )
 {
+	Modified();
 	VectorMath::Add( center, center, delta );
 }
 
@@ -406,12 +507,17 @@ ConformalSphere::ConformalSphere( BindType bindType ) : GAVisToolGeometry( bindT
 //=========================================================================================
 /*virtual*/ void ConformalSphere::Scale( float scale )
 {
+	Modified();
 	radius *= scale;
 }
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( ConformalCircle, GAVisToolGeometry );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar bindCircleRegistrar( "bind_circle", &ConformalCircle::Create, GAVisToolBindTarget::NORMAL_FORM );
+static GAVisToolFunctionRegistry::Registrar bindDualCircleRegistrar( "bind_dual_circle", &ConformalCircle::Create, GAVisToolBindTarget::DUAL_FORM );
+
 //=========================================================================================
 ConformalCircle::ConformalCircle( BindType bindType ) : GAVisToolGeometry( bindType )
 {
@@ -421,8 +527,6 @@ ConformalCircle::ConformalCircle( BindType bindType ) : GAVisToolGeometry( bindT
 	weight = 1.0;
 	imaginary = false;
 
-	CalcLib::Calculator calculator( "geoalg" );
-
 	char decompositionCode[ 512 ];
 	sprintf_s( decompositionCode, sizeof( decompositionCode ),
 		"do("
@@ -443,7 +547,7 @@ ConformalCircle::ConformalCircle( BindType bindType ) : GAVisToolGeometry( bindT
 		")",
 		( bindType == NORMAL_FORM ? "cir = cir*I," : "" )
 	);
-	decompositionEvaluator = calculator.CompileEvaluator( decompositionCode );
+	decompositionEvaluator = GAVisToolEvaluatorCache::Lookup( decompositionCode );
 	wxASSERT( decompositionEvaluator != 0 );
 
 	char compositionCode[ 512 ];
@@ -455,7 +559,7 @@ ConformalCircle::ConformalCircle( BindType bindType ) : GAVisToolGeometry( bindT
 		")",
 		( bindType == NORMAL_FORM ? "*-I" : "" )
 	);
-	compositionEvaluator = calculator.CompileEvaluator( compositionCode );
+	compositionEvaluator = GAVisToolEvaluatorCache::Lookup( compositionCode );
 	wxASSERT( compositionEvaluator != 0 );
 }
 
@@ -471,12 +575,13 @@ ConformalCircle::ConformalCircle( BindType bindType ) : GAVisToolGeometry( bindT
 }
 
 //=========================================================================================
-/*virtual*/ void ConformalCircle::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
+void ConformalCircle::DecomposeWithScript( const GeometricAlgebra::SumOfBlades& element )
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	multivector->AssignFrom( element, gaEnv );
 	gaEnv.StoreVariable( "cir", *number );
@@ -507,17 +612,16 @@ ConformalCircle::ConformalCircle( BindType bindType ) : GAVisToolGeometry( bindT
 		imaginary = true;
 	else
 		imaginary = false;
-
-	delete number;
 }
 
 //=========================================================================================
-/*virtual*/ void ConformalCircle::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
+void ConformalCircle::ComposeWithScript( GeometricAlgebra::SumOfBlades& element ) const
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	double scalar = 1.0;
 	if( imaginary )
@@ -546,8 +650,91 @@ ConformalCircle::ConformalCircle( BindType bindType ) : GAVisToolGeometry( bindT
 
 	gaEnv.LookupVariable( "cir", *number );
 	multivector->AssignTo( element, gaEnv );
+}
+
+//=========================================================================================
+/*virtual*/ void ConformalCircle::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
+{
+	Modified();
 
-	delete number;
+	if( useScriptOracle )
+	{
+		DecomposeWithScript( element );
+		return;
+	}
+
+	ConformalCoefficients coefficients;
+	if( !AssignDualFormFrom( coefficients, element, 2 ) )
+		return;
+
+	VectorMath::Vector normal;
+	VectorMath::Set( normal,
+		coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::NO ],
+		coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::NO ],
+		coefficients.coefficient[ ConformalCoefficients::E3 | ConformalCoefficients::NO ] );
+	double w = VectorMath::Length( normal );
+	if( w == 0.0 )
+		return;
+
+	weight = w;
+	VectorMath::Scale( unitNormal, normal, 1.0 / weight );
+
+	// The coefficients of no^ni and the Euclidean bivector give us the
+	// parts of the center that are parallel and orthogonal to the normal.
+	double distance = -coefficients.coefficient[ ConformalCoefficients::NO | ConformalCoefficients::NI ] / weight;
+	double b12 = coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E2 ] / weight;
+	double b13 = coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E3 ] / weight;
+	double b23 = coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::E3 ] / weight;
+	VectorMath::Set( center,
+		-unitNormal.y * b12 - unitNormal.z * b13 + distance * unitNormal.x,
+		unitNormal.x * b12 - unitNormal.z * b23 + distance * unitNormal.y,
+		unitNormal.x * b13 + unitNormal.y * b23 + distance * unitNormal.z );
+
+	// The coefficients of ei^ni are those of ( 0.5*( v . v - r2 ) )*n - ( v . n )*v.
+	VectorMath::Vector niPart;
+	VectorMath::Set( niPart,
+		coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::NI ] / weight,
+		coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::NI ] / weight,
+		coefficients.coefficient[ ConformalCoefficients::E3 | ConformalCoefficients::NI ] / weight );
+	double halfSphere = VectorMath::Dot( unitNormal, niPart ) + distance * distance;
+	double r2 = VectorMath::Dot( center, center ) - 2.0 * halfSphere;
+	radius = sqrt( fabs( r2 ) );
+	if( r2 < 0.0 )
+		imaginary = true;
+	else
+		imaginary = false;
+}
+
+//=========================================================================================
+/*virtual*/ void ConformalCircle::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
+{
+	if( useScriptOracle )
+	{
+		ComposeWithScript( element );
+		return;
+	}
+
+	ConformalCoefficients coefficients;
+
+	double scalar = 1.0;
+	if( imaginary )
+		scalar = -1.0;
+
+	// cir = w*( ( n + ( v . n )*ni )^( no + v + 0.5*( v . v - scale*r*r )*ni ) )
+	double distance = VectorMath::Dot( center, unitNormal );
+	double halfSphere = 0.5 * ( VectorMath::Dot( center, center ) - scalar * radius * radius );
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::NO ] = weight * unitNormal.x;
+	coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::NO ] = weight * unitNormal.y;
+	coefficients.coefficient[ ConformalCoefficients::E3 | ConformalCoefficients::NO ] = weight * unitNormal.z;
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E2 ] = weight * ( unitNormal.x * center.y - unitNormal.y * center.x );
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E3 ] = weight * ( unitNormal.x * center.z - unitNormal.z * center.x );
+	coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::E3 ] = weight * ( unitNormal.y * center.z - unitNormal.z * center.y );
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::NI ] = weight * ( halfSphere * unitNormal.x - distance * center.x );
+	coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::NI ] = weight * ( halfSphere * unitNormal.y - distance * center.y );
+	coefficients.coefficient[ ConformalCoefficients::E3 | ConformalCoefficients::NI ] = weight * ( halfSphere * unitNormal.z - distance * center.z );
+	coefficients.coefficient[ ConformalCoefficients::NO | ConformalCoefficients::NI ] = -weight * distance;
+
+	AssignDualFormTo( coefficients, element );
 }
 
 //=========================================================================================
@@ -607,12 +794,15 @@ ConformalCircle::ConformalCircle( BindType bindType ) : GAVisToolGeometry( bindT
 //=========================================================================================
 /*virtual*/ void ConformalCircle::Translate( const VectorMath::Vector& delta )
 {
+	Modified();
 	VectorMath::Add( center, center, delta );
 }
 
 //=========================================================================================
 /*virtual*/ void ConformalCircle::Rotate( const VectorMath::Vector& unitAxis, float angle )
 {
+	Modified();
+
 	VectorMath::Rotate( unitNormal, unitNormal, unitAxis, angle );
 	VectorMath::Normalize( unitNormal, unitNormal );		// Re-normalize to fix round-off error.
 }
@@ -620,12 +810,17 @@ ConformalCircle::ConformalCircle( BindType bindType ) : GAVisToolGeometry( bindT
 //=========================================================================================
 /*virtual*/ void ConformalCircle::Scale( float scale )
 {
+	Modified();
 	radius *= scale;
 }
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( ConformalPointPair, GAVisToolGeometry );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar bindPointpairRegistrar( "bind_pointpair", &ConformalPointPair::Create, GAVisToolBindTarget::NORMAL_FORM );
+static GAVisToolFunctionRegistry::Registrar bindDualPointpairRegistrar( "bind_dual_pointpair", &ConformalPointPair::Create, GAVisToolBindTarget::DUAL_FORM );
+
 //=========================================================================================
 ConformalPointPair::ConformalPointPair( BindType bindType ) : GAVisToolGeometry( bindType )
 {
@@ -635,8 +830,6 @@ ConformalPointPair::ConformalPointPair( BindType bindType ) : GAVisToolGeometry(
 	weight = 1.0;
 	imaginary = false;
 
-	CalcLib::Calculator calculator( "geoalg" );
-
 	char decompositionCode[ 512 ];
 	sprintf_s( decompositionCode, sizeof( decompositionCode ),
 		"do("
@@ -658,7 +851,7 @@ ConformalPointPair::ConformalPointPair( BindType bindType ) : GAVisToolGeometry(
 		")",
 		( bindType == NORMAL_FORM ? "ppr = ppr*I," : "" )
 	);
-	decompositionEvaluator = calculator.CompileEvaluator( decompositionCode );
+	decompositionEvaluator = GAVisToolEvaluatorCache::Lookup( decompositionCode );
 	wxASSERT( decompositionEvaluator != 0 );
 
 	char compositionCode[ 512 ];
@@ -670,7 +863,7 @@ ConformalPointPair::ConformalPointPair( BindType bindType ) : GAVisToolGeometry(
 		")",
 		( bindType == NORMAL_FORM ? "*-I" : "" )
 	);
-	compositionEvaluator = calculator.CompileEvaluator( compositionCode );
+	compositionEvaluator = GAVisToolEvaluatorCache::Lookup( compositionCode );
 	wxASSERT( compositionEvaluator != 0 );
 }
 
@@ -686,12 +879,13 @@ ConformalPointPair::ConformalPointPair( BindType bindType ) : GAVisToolGeometry(
 }
 
 //=========================================================================================
-/*virtual*/ void ConformalPointPair::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
+void ConformalPointPair::DecomposeWithScript( const GeometricAlgebra::SumOfBlades& element )
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	multivector->AssignFrom( element, gaEnv );
 	gaEnv.StoreVariable( "ppr", *number );
@@ -722,17 +916,16 @@ ConformalPointPair::ConformalPointPair( BindType bindType ) : GAVisToolGeometry(
 		imaginary = true;
 	else
 		imaginary = false;
-
-	delete number;
 }
 
 //=========================================================================================
-/*virtual*/ void ConformalPointPair::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
+void ConformalPointPair::ComposeWithScript( GeometricAlgebra::SumOfBlades& element ) const
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	double scalar = 1.0;
 	if( imaginary )
@@ -761,8 +954,94 @@ ConformalPointPair::ConformalPointPair( BindType bindType ) : GAVisToolGeometry(
 
 	gaEnv.LookupVariable( "ppr", *number );
 	multivector->AssignTo( element, gaEnv );
+}
+
+//=========================================================================================
+/*virtual*/ void ConformalPointPair::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
+{
+	Modified();
+
+	if( useScriptOracle )
+	{
+		DecomposeWithScript( element );
+		return;
+	}
+
+	ConformalCoefficients coefficients;
+	if( !AssignDualFormFrom( coefficients, element, 3 ) )
+		return;
+
+	// The Euclidean bivector n*i is the dual of the normal.
+	VectorMath::Vector normal;
+	VectorMath::Set( normal,
+		coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::E3 | ConformalCoefficients::NO ],
+		-coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E3 | ConformalCoefficients::NO ],
+		coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E2 | ConformalCoefficients::NO ] );
+	double w = VectorMath::Length( normal );
+	if( w == 0.0 )
+		return;
+
+	weight = w;
+	VectorMath::Scale( unitNormal, normal, 1.0 / weight );
+
+	// The coefficient of e1^e2^e3 is v . n, and those of ei^no^ni are n x v.
+	double distance = coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E2 | ConformalCoefficients::E3 ] / weight;
+	VectorMath::Vector moment, rejection;
+	VectorMath::Set( moment,
+		coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::NO | ConformalCoefficients::NI ] / weight,
+		coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::NO | ConformalCoefficients::NI ] / weight,
+		coefficients.coefficient[ ConformalCoefficients::E3 | ConformalCoefficients::NO | ConformalCoefficients::NI ] / weight );
+	VectorMath::Cross( rejection, moment, unitNormal );
+	VectorMath::AddScale( center, rejection, unitNormal, distance );
+
+	// The coefficients of ei^ej^ni are those of ( 0.5*( v . v - r2 ) )*n*i + ( n x v )^v.
+	VectorMath::Vector niPart, momentWedgeCenter;
+	VectorMath::Set( niPart,
+		coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::E3 | ConformalCoefficients::NI ] / weight,
+		-coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E3 | ConformalCoefficients::NI ] / weight,
+		coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E2 | ConformalCoefficients::NI ] / weight );
+	VectorMath::Cross( momentWedgeCenter, moment, center );
+	double halfSphere = VectorMath::Dot( niPart, unitNormal ) - VectorMath::Dot( momentWedgeCenter, unitNormal );
+	double r2 = VectorMath::Dot( center, center ) - 2.0 * halfSphere;
+	radius = sqrt( fabs( r2 ) );
+	if( r2 < 0.0 )
+		imaginary = true;
+	else
+		imaginary = false;
+}
 
-	delete number;
+//=========================================================================================
+/*virtual*/ void ConformalPointPair::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
+{
+	if( useScriptOracle )
+	{
+		ComposeWithScript( element );
+		return;
+	}
+
+	ConformalCoefficients coefficients;
+
+	double scalar = 1.0;
+	if( imaginary )
+		scalar = -1.0;
+
+	// ppr = w*( ( n*i - ( v . ( n*i ) )*ni )^( no + v + 0.5*( v*v - scale*r*r )*ni ) )
+	double distance = VectorMath::Dot( center, unitNormal );
+	double halfSphere = 0.5 * ( VectorMath::Dot( center, center ) - scalar * radius * radius );
+	VectorMath::Vector moment;
+	VectorMath::Cross( moment, unitNormal, center );
+	coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::E3 | ConformalCoefficients::NO ] = weight * unitNormal.x;
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E3 | ConformalCoefficients::NO ] = -weight * unitNormal.y;
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E2 | ConformalCoefficients::NO ] = weight * unitNormal.z;
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E2 | ConformalCoefficients::E3 ] = weight * distance;
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::NO | ConformalCoefficients::NI ] = weight * moment.x;
+	coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::NO | ConformalCoefficients::NI ] = weight * moment.y;
+	coefficients.coefficient[ ConformalCoefficients::E3 | ConformalCoefficients::NO | ConformalCoefficients::NI ] = weight * moment.z;
+	coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::E3 | ConformalCoefficients::NI ] = weight * ( halfSphere * unitNormal.x + moment.y * center.z - moment.z * center.y );
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E3 | ConformalCoefficients::NI ] = weight * ( -halfSphere * unitNormal.y + moment.x * center.z - moment.z * center.x );
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E2 | ConformalCoefficients::NI ] = weight * ( halfSphere * unitNormal.z + moment.x * center.y - moment.y * center.x );
+
+	AssignDualFormTo( coefficients, element );
 }
 
 //=========================================================================================
@@ -831,12 +1110,15 @@ ConformalPointPair::ConformalPointPair( BindType bindType ) : GAVisToolGeometry(
 //=========================================================================================
 /*virtual*/ void ConformalPointPair::Translate( const VectorMath::Vector& delta )
 {
+	Modified();
 	VectorMath::Add( center, center, delta );
 }
 
 //=========================================================================================
 /*virtual*/ void ConformalPointPair::Rotate( const VectorMath::Vector& unitAxis, float angle )
 {
+	Modified();
+
 	VectorMath::Rotate( unitNormal, unitNormal, unitAxis, angle );
 	VectorMath::Normalize( unitNormal, unitNormal );		// Fix any round-off error.
 }
@@ -844,6 +1126,7 @@ ConformalPointPair::ConformalPointPair( BindType bindType ) : GAVisToolGeometry(
 //=========================================================================================
 /*virtual*/ void ConformalPointPair::Scale( float scale )
 {
+	Modified();
 	radius *= scale;
 }
 
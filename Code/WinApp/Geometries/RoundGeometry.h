@@ -43,6 +43,9 @@ public:
 
 private:
 
+	void DecomposeWithScript( const GeometricAlgebra::SumOfBlades& element );
+	void ComposeWithScript( GeometricAlgebra::SumOfBlades& element ) const;
+
 	VectorMath::Vector center;
 	double weight;
 };
@@ -75,6 +78,9 @@ public:
 
 private:
 
+	void DecomposeWithScript( const GeometricAlgebra::SumOfBlades& element );
+	void ComposeWithScript( GeometricAlgebra::SumOfBlades& element ) const;
+
 	VectorMath::Vector center;
 	double radius, weight;
 	bool imaginary;
@@ -108,6 +114,9 @@ public:
 
 private:
 
+	void DecomposeWithScript( const GeometricAlgebra::SumOfBlades& element );
+	void ComposeWithScript( GeometricAlgebra::SumOfBlades& element ) const;
+
 	VectorMath::Vector center;
 	VectorMath::Vector unitNormal;
 	double radius, weight;
@@ -142,6 +151,9 @@ public:
 
 private:
 
+	void DecomposeWithScript( const GeometricAlgebra::SumOfBlades& element );
+	void ComposeWithScript( GeometricAlgebra::SumOfBlades& element ) const;
+
 	VectorMath::Vector center;
 	VectorMath::Vector unitNormal;
 	double radius, weight;
@@ -33,6 +33,8 @@ SurfaceGeometry::SurfaceGeometry( BindType bindType, VectorMath::Surface* surfac
 //=========================================================================================
 /*virtual*/ void SurfaceGeometry::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
 {
+	Modified();
+
 	this->element.AssignSumOfBlades( element );
 	surfaceGeometryValid = false;
 }
@@ -44,37 +46,36 @@ SurfaceGeometry::SurfaceGeometry( BindType bindType, VectorMath::Surface* surfac
 }
 
 //=========================================================================================
-void SurfaceGeometry::RegenerateSurfaceGeometry( void )
+/*virtual*/ void SurfaceGeometry::RegenerateSurfaceGeometry( void )
 {
 	if( renderAs == RENDER_AS_SET_OF_TRACES )
 	{
 		// Kill the old trace list.
 		traceList.RemoveAll( true );
 
-		VectorMath::Surface::TraceParameters traceParameters;
-
-		// A better center would be that of the surface, if we knew how to calculate that.
-		VectorMath::Zero( traceParameters.center );
-
-		traceParameters.range = 15.0;
-		traceParameters.extent = 8.0;
-		traceParameters.planeCount = 14;
-
-		VectorMath::Vector axis[3];
+		VectorMath::Surface::TraceParameters traceParameters[3];
 		int axisCount = 3;
-		VectorMath::Set( axis[0], 1.0, 0.0, 0.0 );
-		VectorMath::Set( axis[1], 0.0, 1.0, 0.0 );
-		VectorMath::Set( axis[2], 0.0, 0.0, 1.0 );
 
-		// Create the new trace list.
 		for( int index = 0; index < axisCount; index++ )
 		{
-			VectorMath::Copy( traceParameters.axis, axis[ index ] );
+			// A better center would be that of the surface, if we knew how to calculate that.
+			VectorMath::Zero( traceParameters[ index ].center );
 
-			// Append to the trace list all traces along this axis.
-			// TODO: Use the progress bar here too.
-			surface->GenerateTracesAlongAxis( traceParameters, traceList );
+			traceParameters[ index ].range = 15.0;
+			traceParameters[ index ].extent = 8.0;
+			traceParameters[ index ].planeCount = 14;
+			traceParameters[ index ].useNewtonSteps = UsingNewtonSteps();
 		}
+
+		VectorMath::Set( traceParameters[0].axis, 1.0, 0.0, 0.0 );
+		VectorMath::Set( traceParameters[1].axis, 0.0, 1.0, 0.0 );
+		VectorMath::Set( traceParameters[2].axis, 0.0, 0.0, 1.0 );
+
+		// Create the new trace list, with the planes of all three axes spread across our threads.
+		// TODO: Use the progress bar here too.
+		VectorMath::Surface::ConvergenceStats convergenceStats;
+		surface->GenerateTracesAlongAxes( traceParameters, axisCount, traceList, wxGetApp().threadPool, &convergenceStats );
+		AccumulateConvergenceStats( CONVERGE_FOR_TRACING, convergenceStats );
 	}
 	else if( renderAs == RENDER_AS_TRIANGLE_MESH )
 	{
@@ -84,14 +85,29 @@ void SurfaceGeometry::RegenerateSurfaceGeometry( void )
 		VectorMath::SurfaceMesh::GenerationParameters genParms;
 		genParms.maxIterations = 12000;
 		genParms.walkDistance = 0.5;
-		//genParms.walkDistance = 0.25;
-		//genParms.walkDistance = 0.15;
+
+		// Take longer steps where the surface is flat, and shorter ones where it curves.
+		genParms.chordTolerance = 0.01;
+		genParms.minWalkDistance = 0.1;
+		genParms.maxWalkDistance = 1.5;
+
+		genParms.useNewtonSteps = UsingNewtonSteps();
 #if 0
 		GAVisToolProgressBar progressBar;
 		surfaceMesh.Generate( *surface, genParms, &progressBar );
 #else
 		surfaceMesh.Generate( *surface, genParms );
 #endif
+
+		VectorMath::Surface::ConvergenceStats convergenceStats;
+		surfaceMesh.GetConvergenceStats( convergenceStats );
+		AccumulateConvergenceStats( CONVERGE_FOR_MESHING, convergenceStats );
+	}
+	else if( renderAs == RENDER_AS_LATTICE_MESH )
+	{
+		// The lattice covers the same box as the advancing front, block by block across our threads.
+		VectorMath::LatticeMesh::GenerationParameters genParms;
+		latticeMesh.Generate( *surface, genParms, wxGetApp().threadPool );
 	}
 }
 
@@ -121,7 +137,7 @@ void SurfaceGeometry::RegenerateSurfaceGeometry( void )
 			trace = ( VectorMath::Surface::Trace* )trace->Right();
 		}
 	}
-	else if( renderAs == RENDER_AS_TRIANGLE_MESH )
+	else
 	{
 		class RenderInterface : public VectorMath::SurfaceMesh::RenderInterface
 		{
@@ -156,10 +172,19 @@ void SurfaceGeometry::RegenerateSurfaceGeometry( void )
 		};
 
 		RenderInterface renderInterface( &render );
-		surfaceMesh.Render( renderInterface, color, alpha );
+		RenderMesh( renderInterface );
 	}
 }
 
+//=========================================================================================
+/*virtual*/ void SurfaceGeometry::RenderMesh( VectorMath::SurfaceMesh::RenderInterface& renderInterface )
+{
+	if( renderAs == RENDER_AS_TRIANGLE_MESH )
+		surfaceMesh.Render( renderInterface, color, alpha );
+	else if( renderAs == RENDER_AS_LATTICE_MESH )
+		latticeMesh.Render( renderInterface, color, alpha );
+}
+
 //=========================================================================================
 void SurfaceGeometry::DrawTrace( VectorMath::Surface::Trace* trace, GAVisToolRender& render )
 {
@@ -182,11 +207,13 @@ void SurfaceGeometry::DrawTrace( VectorMath::Surface::Trace* trace, GAVisToolRen
 
 	treeCtrl->Bind( wxEVT_COMMAND_MENU_SELECTED, &SurfaceGeometry::OnRenderTraces, this, itemID++ );
 	treeCtrl->Bind( wxEVT_COMMAND_MENU_SELECTED, &SurfaceGeometry::OnRenderMeshes, this, itemID++ );
+	treeCtrl->Bind( wxEVT_COMMAND_MENU_SELECTED, &SurfaceGeometry::OnRenderLatticeMeshes, this, itemID++ );
 
 	itemID = highestUnusedID;
 
 	menu->Append( itemID++, wxT( "Render Traces" ) );
 	menu->Append( itemID++, wxT( "Render Meshes" ) );
+	menu->Append( itemID++, wxT( "Render Lattice Meshes" ) );
 
 	return true;
 }
@@ -213,6 +240,17 @@ void SurfaceGeometry::OnRenderMeshes( wxCommandEvent& event )
 	}
 }
 
+//=========================================================================================
+void SurfaceGeometry::OnRenderLatticeMeshes( wxCommandEvent& event )
+{
+	if( renderAs != RENDER_AS_LATTICE_MESH )
+	{
+		renderAs = RENDER_AS_LATTICE_MESH;
+		surfaceGeometryValid = false;
+		wxGetApp().canvasFrame->canvas->RedrawNeeded( true );
+	}
+}
+
 //=========================================================================================
 /*virtual*/ void SurfaceGeometry::CalcCenter( VectorMath::Vector& center ) const
 {
@@ -14,6 +14,7 @@
 #include "../Geometry.h"
 #include "../VectorMath/Surface.h"
 #include "../VectorMath/SurfaceMesh.h"
+#include "../VectorMath/LatticeMesh.h"
 
 //=========================================================================================
 class SurfaceGeometry : public GAVisToolGeometry
@@ -39,22 +40,26 @@ public:
 
 	void OnRenderTraces( wxCommandEvent& event );
 	void OnRenderMeshes( wxCommandEvent& event );
+	void OnRenderLatticeMeshes( wxCommandEvent& event );
 
 protected:
 
-	void RegenerateSurfaceGeometry( void );
+	virtual void RegenerateSurfaceGeometry( void );
+	virtual void RenderMesh( VectorMath::SurfaceMesh::RenderInterface& renderInterface );
 	void DrawTrace( VectorMath::Quadric::Trace* trace, GAVisToolRender& render );
 
 	enum RenderAs
 	{
 		RENDER_AS_SET_OF_TRACES,
 		RENDER_AS_TRIANGLE_MESH,
+		RENDER_AS_LATTICE_MESH,
 	};
 
 	RenderAs renderAs;
 	VectorMath::Surface* surface;
 	Utilities::List traceList;
 	VectorMath::SurfaceMesh surfaceMesh;
+	VectorMath::LatticeMesh latticeMesh;
 	bool surfaceGeometryValid;
 
 	GeometricAlgebra::SumOfBlades element;
@@ -10,10 +10,14 @@
  */
 
 #include "TransformGeometry.h"
+#include "../FunctionRegistry.h"
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( ConformalTransformGeometry, GAVisToolGeometry );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar bindTransformRegistrar( "bind_transform", &ConformalTransformGeometry::Create, GAVisToolBindTarget::DOESNT_MATTER );
+
 //=========================================================================================
 ConformalTransformGeometry::ConformalTransformGeometry( BindType bindType ) : GAVisToolGeometry( bindType )
 {
@@ -22,8 +26,6 @@ ConformalTransformGeometry::ConformalTransformGeometry( BindType bindType ) : GA
 	VectorMath::Set( unitAxis, 1.0, 0.0, 0.0 );
 	VectorMath::Zero( translation );
 
-	CalcLib::Calculator calculator( "geoalg" );
-
 	char decompositionCode[ 512 ];
 	sprintf_s( decompositionCode, sizeof( decompositionCode ),
 		"do("
@@ -46,7 +48,7 @@ ConformalTransformGeometry::ConformalTransformGeometry( BindType bindType ) : GA
 		"tz = scalar_part( t, e3 )"
 		")"
 	);
-	decompositionEvaluator = calculator.CompileEvaluator( decompositionCode );
+	decompositionEvaluator = GAVisToolEvaluatorCache::Lookup( decompositionCode );
 	wxASSERT( decompositionEvaluator != 0 );
 
 	char compositionCode[ 512 ];
@@ -58,7 +60,7 @@ ConformalTransformGeometry::ConformalTransformGeometry( BindType bindType ) : GA
 		"V = w*( 1 - 0.5*t*ni )*( cos( half_theta ) - a*i*sin( half_theta ) )"
 		")"
 	);
-	compositionEvaluator = calculator.CompileEvaluator( compositionCode );
+	compositionEvaluator = GAVisToolEvaluatorCache::Lookup( compositionCode );
 	wxASSERT( compositionEvaluator != 0 );
 }
 
@@ -76,10 +78,190 @@ ConformalTransformGeometry::ConformalTransformGeometry( BindType bindType ) : GA
 //=========================================================================================
 /*virtual*/ void ConformalTransformGeometry::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	Modified();
+
+	if( useScriptOracle )
+	{
+		DecomposeWithScript( element );
+		return;
+	}
+
+	ConformalCoefficients scalarPart, bivectorPart, quadvectorPart;
+	if( !scalarPart.AssignFrom( element, 0 ) || !bivectorPart.AssignFrom( element, 2 ) || !quadvectorPart.AssignFrom( element, 4 ) )
+		return;
+
+	// V = w*( R - 0.5*t*R*ni ), where R = c - b*i, c = cos( theta/2 ) and b = sin( theta/2 )*a.
+	// The Euclidean part of V is w*R, and |R| = 1 gives us the weight.
+	double c = scalarPart.coefficient[0];
+	VectorMath::Vector b;
+	VectorMath::Set( b,
+		-bivectorPart.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::E3 ],
+		bivectorPart.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E3 ],
+		-bivectorPart.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E2 ] );
+
+	double w = sqrt( c*c + VectorMath::Dot( b, b ) );
+	if( w == 0.0 )
+		return;
+
+	scale = w;
+	c /= w;
+	VectorMath::Scale( b, b, 1.0 / w );
+
+	// The rest of V is -0.5*w*( p + q*i )*ni, where p + q*i = t*R.
+	VectorMath::Vector p;
+	VectorMath::Set( p,
+		bivectorPart.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::NI ],
+		bivectorPart.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::NI ],
+		bivectorPart.coefficient[ ConformalCoefficients::E3 | ConformalCoefficients::NI ] );
+	VectorMath::Scale( p, p, -2.0 / w );
+	double q = -2.0 * quadvectorPart.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E2 | ConformalCoefficients::E3 | ConformalCoefficients::NI ] / w;
+
+	// t = ( p + q*i )*~R = c*p - p x b - q*b
+	VectorMath::Vector pCrossB;
+	VectorMath::Cross( pCrossB, p, b );
+	VectorMath::Scale( translation, p, c );
+	VectorMath::Sub( translation, translation, pCrossB );
+	VectorMath::AddScale( translation, translation, b, -q );
+
+	// Round-off can put the cosine just outside of its range.
+	if( c > 1.0 )
+		c = 1.0;
+	else if( c < -1.0 )
+		c = -1.0;
+
+	double halfAngle = acos( c );
+	angle = 2.0 * halfAngle;
+
+	// Without any rotation, the axis is whatever it was.
+	double sinHalfAngle = sin( halfAngle );
+	if( sinHalfAngle != 0.0 )
+		VectorMath::Scale( unitAxis, b, 1.0 / sinHalfAngle );
+}
+
+//=========================================================================================
+/*virtual*/ void ConformalTransformGeometry::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
+{
+	if( useScriptOracle )
+	{
+		ComposeWithScript( element );
+		return;
+	}
+
+	ConformalCoefficients coefficients;
+	AssignMotorTo( coefficients, scale );
+	coefficients.AssignTo( element );
+}
+
+//=========================================================================================
+// V = w*( 1 - 0.5*t*ni )*( cos( theta/2 ) - a*i*sin( theta/2 ) )
+void ConformalTransformGeometry::AssignMotorTo( ConformalCoefficients& coefficients, double weight ) const
+{
+	double halfAngle = 0.5 * angle;
+	double c = cos( halfAngle );
+	VectorMath::Vector b;
+	VectorMath::Scale( b, unitAxis, sin( halfAngle ) );
+
+	// With R = c - b*i, t*R = p + q*i.
+	VectorMath::Vector p, tCrossB;
+	VectorMath::Cross( tCrossB, translation, b );
+	VectorMath::Scale( p, translation, c );
+	VectorMath::Add( p, p, tCrossB );
+	double q = -VectorMath::Dot( translation, b );
+
+	coefficients.Zero();
+
+	coefficients.coefficient[0] = weight * c;
+	coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::E3 ] = -weight * b.x;
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E3 ] = weight * b.y;
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E2 ] = -weight * b.z;
+
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::NI ] = -0.5 * weight * p.x;
+	coefficients.coefficient[ ConformalCoefficients::E2 | ConformalCoefficients::NI ] = -0.5 * weight * p.y;
+	coefficients.coefficient[ ConformalCoefficients::E3 | ConformalCoefficients::NI ] = -0.5 * weight * p.z;
+	coefficients.coefficient[ ConformalCoefficients::E1 | ConformalCoefficients::E2 | ConformalCoefficients::E3 | ConformalCoefficients::NI ] = -0.5 * weight * q;
+}
+
+//=========================================================================================
+void ConformalTransformGeometry::TransformPoints( const VectorMath::Vector* points, VectorMath::Vector* transformedPoints, int pointCount ) const
+{
+	ConformalCoefficients coefficients;
+	AssignMotorTo( coefficients, 1.0 );
+
+	ConformalEvenVersor motor;
+	motor.AssignFrom( coefficients );
+
+	// The images of the origin and of the points at the tips of the basis vectors give us the
+	// columns of the matrix.  This is the only place the motor is actually applied.
+	VectorMath::Vector column[4];
+	VectorMath::Zero( column[0] );
+	VectorMath::Set( column[1], 1.0, 0.0, 0.0 );
+	VectorMath::Set( column[2], 0.0, 1.0, 0.0 );
+	VectorMath::Set( column[3], 0.0, 0.0, 1.0 );
+	for( int index = 0; index < 4; index++ )
+	{
+		Sandwich( motor, ConformalPointVector( column[ index ], 1.0 ) ).AssignTo( coefficients );
+		double weight = coefficients.coefficient[ ConformalCoefficients::NO ];
+		VectorMath::Set( column[ index ],
+			coefficients.coefficient[ ConformalCoefficients::E1 ] / weight,
+			coefficients.coefficient[ ConformalCoefficients::E2 ] / weight,
+			coefficients.coefficient[ ConformalCoefficients::E3 ] / weight );
+		if( index > 0 )
+			VectorMath::Sub( column[ index ], column[ index ], column[0] );
+	}
+
+	double m00 = column[1].x, m01 = column[2].x, m02 = column[3].x, m03 = column[0].x;
+	double m10 = column[1].y, m11 = column[2].y, m12 = column[3].y, m13 = column[0].y;
+	double m20 = column[1].z, m21 = column[2].z, m22 = column[3].z, m23 = column[0].z;
+
+	int index = 0;
+
+#ifdef VECTORMATH_SSE2
+	// Each pass transforms two points, one in each lane.
+	__m128d a00 = _mm_set1_pd( m00 ), a01 = _mm_set1_pd( m01 ), a02 = _mm_set1_pd( m02 ), a03 = _mm_set1_pd( m03 );
+	__m128d a10 = _mm_set1_pd( m10 ), a11 = _mm_set1_pd( m11 ), a12 = _mm_set1_pd( m12 ), a13 = _mm_set1_pd( m13 );
+	__m128d a20 = _mm_set1_pd( m20 ), a21 = _mm_set1_pd( m21 ), a22 = _mm_set1_pd( m22 ), a23 = _mm_set1_pd( m23 );
+
+	for( ; index + 1 < pointCount; index += 2 )
+	{
+		const VectorMath::Vector* point = &points[ index ];
+		__m128d x = _mm_set_pd( point[1].x, point[0].x );
+		__m128d y = _mm_set_pd( point[1].y, point[0].y );
+		__m128d z = _mm_set_pd( point[1].z, point[0].z );
+
+		__m128d tx = _mm_add_pd( _mm_add_pd( _mm_mul_pd( a00, x ), _mm_mul_pd( a01, y ) ), _mm_add_pd( _mm_mul_pd( a02, z ), a03 ) );
+		__m128d ty = _mm_add_pd( _mm_add_pd( _mm_mul_pd( a10, x ), _mm_mul_pd( a11, y ) ), _mm_add_pd( _mm_mul_pd( a12, z ), a13 ) );
+		__m128d tz = _mm_add_pd( _mm_add_pd( _mm_mul_pd( a20, x ), _mm_mul_pd( a21, y ) ), _mm_add_pd( _mm_mul_pd( a22, z ), a23 ) );
+
+		VectorMath::Vector* transformedPoint = &transformedPoints[ index ];
+		_mm_storel_pd( &transformedPoint[0].x, tx );
+		_mm_storeh_pd( &transformedPoint[1].x, tx );
+		_mm_storel_pd( &transformedPoint[0].y, ty );
+		_mm_storeh_pd( &transformedPoint[1].y, ty );
+		_mm_storel_pd( &transformedPoint[0].z, tz );
+		_mm_storeh_pd( &transformedPoint[1].z, tz );
+	}
+#endif
+
+	for( ; index < pointCount; index++ )
+	{
+		double x = points[ index ].x;
+		double y = points[ index ].y;
+		double z = points[ index ].z;
+
+		transformedPoints[ index ].x = m00*x + m01*y + m02*z + m03;
+		transformedPoints[ index ].y = m10*x + m11*y + m12*z + m13;
+		transformedPoints[ index ].z = m20*x + m21*y + m22*z + m23;
+	}
+}
+
+//=========================================================================================
+void ConformalTransformGeometry::DecomposeWithScript( const GeometricAlgebra::SumOfBlades& element )
+{
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	multivector->AssignFrom( element, gaEnv );
 	gaEnv.StoreVariable( "V", *number );
@@ -102,17 +284,16 @@ ConformalTransformGeometry::ConformalTransformGeometry( BindType bindType ) : GA
 	multivector->AssignTo( translation.y, gaEnv );
 	gaEnv.LookupVariable( "tz", *number );
 	multivector->AssignTo( translation.z, gaEnv );
-
-	delete number;
 }
 
 //=========================================================================================
-/*virtual*/ void ConformalTransformGeometry::ComposeTo( GeometricAlgebra::SumOfBlades& element ) const
+void ConformalTransformGeometry::ComposeWithScript( GeometricAlgebra::SumOfBlades& element ) const
 {
-	CalcLib::GeometricAlgebraEnvironment gaEnv;
+	GAVisToolScratchEnvironment::Loan loan;
+	GAVisToolScratchEnvironment& gaEnv = *loan.scratchEnv;
 
-	CalcLib::Number* number = gaEnv.CreateNumber();
-	CalcLib::MultivectorNumber* multivector = ( CalcLib::MultivectorNumber* )number;
+	CalcLib::Number* number = gaEnv.number;
+	CalcLib::MultivectorNumber* multivector = gaEnv.multivector;
 
 	number->AssignFrom( scale, gaEnv );
 	gaEnv.StoreVariable( "w", *number );
@@ -135,8 +316,6 @@ ConformalTransformGeometry::ConformalTransformGeometry( BindType bindType ) : GA
 
 	gaEnv.LookupVariable( "V", *number );
 	multivector->AssignTo( element, gaEnv );
-
-	delete number;
 }
 
 //=========================================================================================
@@ -190,18 +369,21 @@ ConformalTransformGeometry::ConformalTransformGeometry( BindType bindType ) : GA
 //=========================================================================================
 /*virtual*/ void ConformalTransformGeometry::Translate( const VectorMath::Vector& delta )
 {
+	Modified();
 	VectorMath::Add( translation, translation, delta );
 }
 
 //=========================================================================================
 /*virtual*/ void ConformalTransformGeometry::Rotate( const VectorMath::Vector& unitAxis, float angle )
 {
+	Modified();
 	VectorMath::Rotate( this->unitAxis, this->unitAxis, unitAxis, angle );
 }
 
 //=========================================================================================
 /*virtual*/ void ConformalTransformGeometry::Scale( float scale )
 {
+	Modified();
 	this->scale *= scale;
 }
 
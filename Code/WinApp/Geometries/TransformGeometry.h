@@ -12,6 +12,7 @@
 #pragma once
 
 #include "../Geometry.h"
+#include "ConformalBlades.h"
 
 //=========================================================================================
 // What I'm calling here a conformal transform is the geometric product of a translation
@@ -48,8 +49,19 @@ public:
 
 	virtual void NameCenterOffset( VectorMath::Vector& offsetDelta );
 
+	// This applies the transform to each of the given points the way V*X*~V would apply it to
+	// their conformal representations.  The scale only weights a conformal point, so it doesn't
+	// move it.  The motor is reduced to a 3x4 matrix up front, and the points are then done two
+	// at a time with SSE2 where we have it.  The two arrays must not overlap.
+	void TransformPoints( const VectorMath::Vector* points, VectorMath::Vector* transformedPoints, int pointCount ) const;
+
 private:
 
+	void DecomposeWithScript( const GeometricAlgebra::SumOfBlades& element );
+	void ComposeWithScript( GeometricAlgebra::SumOfBlades& element ) const;
+
+	void AssignMotorTo( ConformalCoefficients& coefficients, double weight ) const;
+
 	VectorMath::Vector translation;
 	VectorMath::Vector unitAxis;
 	double angle;
@@ -15,6 +15,11 @@
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( GAVisToolGeometry, GAVisToolBindTarget );
 
+//=========================================================================================
+/*static*/ bool GAVisToolGeometry::useScriptOracle = false;
+/*static*/ bool GAVisToolGeometry::useNewtonSteps = true;
+/*static*/ VectorMath::Surface::ConvergenceStats GAVisToolGeometry::convergenceStats[ CONVERGENCE_PURPOSE_COUNT ];
+
 //=========================================================================================
 GAVisToolGeometry::GAVisToolGeometry( BindType bindType ) : GAVisToolBindTarget( bindType )
 {
@@ -30,11 +35,6 @@ GAVisToolGeometry::GAVisToolGeometry( BindType bindType ) : GAVisToolBindTarget(
 //=========================================================================================
 /*virtual*/ GAVisToolGeometry::~GAVisToolGeometry( void )
 {
-	if( decompositionEvaluator )
-		delete decompositionEvaluator;
-	if( compositionEvaluator )
-		delete compositionEvaluator;
-
 	if( nameTexture != GL_INVALID_VALUE )
 		glDeleteTextures( 1, &nameTexture );
 }
@@ -219,6 +219,75 @@ bool GAVisToolGeometry::IsOpaque( void ) const
 	return false;
 }
 
+//=========================================================================================
+/*static*/ void GAVisToolGeometry::UseScriptOracle( bool useScriptOracle )
+{
+	GAVisToolGeometry::useScriptOracle = useScriptOracle;
+}
+
+//=========================================================================================
+/*static*/ bool GAVisToolGeometry::UsingScriptOracle( void )
+{
+	return useScriptOracle;
+}
+
+//=========================================================================================
+/*static*/ void GAVisToolGeometry::UseNewtonSteps( bool useNewtonSteps )
+{
+	GAVisToolGeometry::useNewtonSteps = useNewtonSteps;
+}
+
+//=========================================================================================
+/*static*/ bool GAVisToolGeometry::UsingNewtonSteps( void )
+{
+	return useNewtonSteps;
+}
+
+//=========================================================================================
+/*static*/ void GAVisToolGeometry::AccumulateConvergenceStats( ConvergencePurpose purpose, const VectorMath::Surface::ConvergenceStats& stats )
+{
+	convergenceStats[ purpose ].Accumulate( stats );
+}
+
+//=========================================================================================
+/*static*/ void GAVisToolGeometry::GetConvergenceStats( ConvergencePurpose purpose, VectorMath::Surface::ConvergenceStats& stats )
+{
+	stats = convergenceStats[ purpose ];
+}
+
+//=========================================================================================
+/*static*/ void GAVisToolGeometry::ResetConvergenceStats( void )
+{
+	for( int purpose = 0; purpose < CONVERGENCE_PURPOSE_COUNT; purpose++ )
+		convergenceStats[ purpose ] = VectorMath::Surface::ConvergenceStats();
+}
+
+//=========================================================================================
+// The native code works with the dual form of a geometry.  Its normal form is the dual
+// form times -I, so the grade of the normal form is the complement of the given grade.
+bool GAVisToolGeometry::AssignDualFormFrom( ConformalCoefficients& coefficients, const GeometricAlgebra::SumOfBlades& element, int grade ) const
+{
+	if( bindType == NORMAL_FORM )
+	{
+		if( !coefficients.AssignFrom( element, 5 - grade ) )
+			return false;
+
+		coefficients.MultiplyByPseudoScalar();
+		return true;
+	}
+
+	return coefficients.AssignFrom( element, grade );
+}
+
+//=========================================================================================
+void GAVisToolGeometry::AssignDualFormTo( ConformalCoefficients& coefficients, GeometricAlgebra::SumOfBlades& element ) const
+{
+	if( bindType == NORMAL_FORM )
+		coefficients.MultiplyByNegativePseudoScalar();
+
+	coefficients.AssignTo( element );
+}
+
 //=========================================================================================
 TestGeometry::TestGeometry( int nameIndex ) : GAVisToolGeometry( NORMAL_FORM )
 {
@@ -285,6 +354,8 @@ TestGeometry::TestGeometry( int nameIndex ) : GAVisToolGeometry( NORMAL_FORM )
 //=========================================================================================
 /*virtual*/ void TestGeometry::Translate( const VectorMath::Vector& delta )
 {
+	Modified();
+
 	VectorMath::Add( triangle.vertex[0], triangle.vertex[0], delta );
 	VectorMath::Add( triangle.vertex[1], triangle.vertex[1], delta );
 	VectorMath::Add( triangle.vertex[2], triangle.vertex[2], delta );
@@ -293,6 +364,8 @@ TestGeometry::TestGeometry( int nameIndex ) : GAVisToolGeometry( NORMAL_FORM )
 //=========================================================================================
 /*virtual*/ void TestGeometry::Rotate( const VectorMath::Vector& unitAxis, float angle )
 {
+	Modified();
+
 	VectorMath::Rotate( triangle.vertex[0], triangle.vertex[0], unitAxis, angle );
 	VectorMath::Rotate( triangle.vertex[1], triangle.vertex[1], unitAxis, angle );
 	VectorMath::Rotate( triangle.vertex[2], triangle.vertex[2], unitAxis, angle );
@@ -301,6 +374,8 @@ TestGeometry::TestGeometry( int nameIndex ) : GAVisToolGeometry( NORMAL_FORM )
 //=========================================================================================
 /*virtual*/ void TestGeometry::Scale( float scale )
 {
+	Modified();
+
 	VectorMath::Vector center;
 	VectorMath::CalcCenter( triangle, center );
 
@@ -13,9 +13,13 @@
 
 #include "Calculator/CalcLib.h"
 #include "VectorMath/Vector.h"
+#include "VectorMath/Surface.h"
 #include "wxAll.h"
 #include "Render.h"
 #include "BindTarget.h"
+#include "Geometries/ConformalCoefficients.h"
+#include "EvaluatorCache.h"
+#include "ScratchEnvironment.h"
 
 //=========================================================================================
 class GAVisToolGeometry : public GAVisToolBindTarget
@@ -48,8 +52,37 @@ public:
 	double GetAlpha( void ) const;
 	bool IsOpaque( void ) const;
 
+	// The conformal geometries decompose and compose their elements natively, but they
+	// still have their scripts.  These are kept as a reference against which the native
+	// code can be checked, and they are used instead while this flag is set.
+	static void UseScriptOracle( bool useScriptOracle );
+	static bool UsingScriptOracle( void );
+
+	// Geometries regenerate on the main thread, passing this choice along to the generators
+	// and adding what it took them to converge points to their surfaces to the tallies here.
+	enum ConvergencePurpose
+	{
+		CONVERGE_FOR_TRACING,
+		CONVERGE_FOR_MESHING,
+		CONVERGE_FOR_SAMPLING,
+		CONVERGENCE_PURPOSE_COUNT,
+	};
+
+	static void UseNewtonSteps( bool useNewtonSteps );
+	static bool UsingNewtonSteps( void );
+	static void AccumulateConvergenceStats( ConvergencePurpose purpose, const VectorMath::Surface::ConvergenceStats& stats );
+	static void GetConvergenceStats( ConvergencePurpose purpose, VectorMath::Surface::ConvergenceStats& stats );
+	static void ResetConvergenceStats( void );
+
 protected:
 
+	bool AssignDualFormFrom( ConformalCoefficients& coefficients, const GeometricAlgebra::SumOfBlades& element, int grade ) const;
+	void AssignDualFormTo( ConformalCoefficients& coefficients, GeometricAlgebra::SumOfBlades& element ) const;
+
+	static bool useScriptOracle;
+	static bool useNewtonSteps;
+	static VectorMath::Surface::ConvergenceStats convergenceStats[ CONVERGENCE_PURPOSE_COUNT ];
+
 	GLuint nameTexture;
 	VectorMath::Vector color;
 	double alpha;
@@ -60,6 +93,9 @@ protected:
 	// from a script rather than long drawn out lines
 	// of code, especially when it's easy to make a
 	// mis-calculation.
+	// These come from the evaluator cache and are shared
+	// by all geometries compiled from the same scripts,
+	// so they are not ours to delete.
 	CalcLib::Evaluator* decompositionEvaluator;
 	CalcLib::Evaluator* compositionEvaluator;
 };
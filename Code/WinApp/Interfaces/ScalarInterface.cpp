@@ -10,11 +10,15 @@
  */
 
 #include "ScalarInterface.h"
+#include "../FunctionRegistry.h"
 #include "../Application.h"
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( ScalarInterface, GAVisToolInterface );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar bindScalarIfaceRegistrar( "bind_scalar_iface", &ScalarInterface::Create, GAVisToolBindTarget::DOESNT_MATTER );
+
 //=========================================================================================
 ScalarInterface::ScalarInterface( BindType bindType ) : GAVisToolInterface( bindType )
 {
@@ -44,6 +48,8 @@ ScalarInterface::ScalarInterface( BindType bindType ) : GAVisToolInterface( bind
 //=========================================================================================
 /*virtual*/ void ScalarInterface::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
 {
+	Modified();
+
 	if( !element.AssignScalarTo( scalar ) )
 	{
 		// We should probably complain to the user in this case.  Be silent for now.
@@ -114,6 +120,7 @@ void ScalarInterface::PullDataFromInterface( void )
 	double v = double( panel->slider->GetValue() );
 	double t = v / double( Panel::SliderResolution );
 	scalar = min + t * ( max - min );
+	Modified();
 }
 
 //=========================================================================================
@@ -123,6 +130,7 @@ void ScalarInterface::AdjustScalarAgainstBounds( void )
 		scalar = min;
 	if( scalar > max )
 		scalar = max;
+	Modified();
 }
 
 //=========================================================================================
@@ -166,6 +174,37 @@ double ScalarInterface::GetMax( void )
 	return max;
 }
 
+//=========================================================================================
+/*static*/ bool ScalarInterface::EvaluateScalarArgument( CalcLib::FunctionArgumentEvaluator* argumentEvaluator, int index, double& scalar, CalcLib::Environment& environment )
+{
+	bool success = false;
+	CalcLib::Number* argumentResult = 0;
+
+	do
+	{
+		argumentResult = environment.CreateNumber( argumentEvaluator );
+		if( !argumentEvaluator->EvaluateResult( *argumentResult, environment ) )
+			break;
+
+		CalcLib::MultivectorNumber* multivectorNumber = argumentResult->Cast< CalcLib::MultivectorNumber >();
+		GeometricAlgebra::SumOfBlades multivector;
+		GeometricAlgebra::Scalar argumentScalar;
+		if( !multivectorNumber || !multivectorNumber->AssignTo( multivector, environment ) || !multivector.AssignScalarTo( argumentScalar ) )
+		{
+			environment.AddError( "Argument %d was expected to be a scalar.", index + 1 );
+			break;
+		}
+
+		scalar = argumentScalar;
+		success = true;
+	}
+	while( false );
+
+	delete argumentResult;
+
+	return success;
+}
+
 //=========================================================================================
 BEGIN_EVENT_TABLE( ScalarInterface::Panel, wxPanel )
 	EVT_COMMAND_SCROLL( ID_Slider, OnSlider )
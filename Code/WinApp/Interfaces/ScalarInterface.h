@@ -41,6 +41,10 @@ public:
 	double GetMin( void );
 	double GetMax( void );
 
+	// Functions that take scalars as arguments read them in with this.  The index is
+	// only used to tell the user which argument wasn't a scalar.
+	static bool EvaluateScalarArgument( CalcLib::FunctionArgumentEvaluator* argumentEvaluator, int index, double& scalar, CalcLib::Environment& environment );
+
 private:
 
 	void AdjustScalarAgainstBounds( void );
@@ -58,6 +58,7 @@ GAVisToolInventoryTree::GAVisToolInventoryTree( wxWindow* parent ) : wxTreeCtrl(
 {
 	contextItem = 0;
 	needsRegen = false;
+	needsProfileRefresh = false;
 }
 
 //=========================================================================================
@@ -78,7 +79,27 @@ void GAVisToolInventoryTree::RegenerateTreeIfNeeded( void )
 	{
 		RegenerateTree();
 		needsRegen = false;
+		needsProfileRefresh = false;
 	}
+	else if( needsProfileRefresh )
+	{
+		RefreshProfiles();
+		needsProfileRefresh = false;
+	}
+}
+
+//=========================================================================================
+void GAVisToolInventoryTree::ProfileRefreshNeeded( void )
+{
+	needsProfileRefresh = true;
+}
+
+//=========================================================================================
+void GAVisToolInventoryTree::RefreshProfiles( void )
+{
+	const Utilities::List& constraintList = wxGetApp().environment->ConstraintList();
+	for( const GAVisToolConstraint* constraint = ( const GAVisToolConstraint* )constraintList.LeftMost(); constraint; constraint = ( const GAVisToolConstraint* )constraint->Right() )
+		constraint->RefreshProfileTreeItems( this );
 }
 
 //=========================================================================================
@@ -65,11 +65,17 @@ public:
 	void RegenerateTreeIfNeeded( void );
 	void RegenerateTree( void );
 
+	// Constraint profiles change with every solve, which shouldn't cost a whole regeneration.
+	void ProfileRefreshNeeded( void );
+
 private:
 
+	void RefreshProfiles( void );
+
 	Item* LookupInventoryItem( wxTreeEvent& event );
 	Item* contextItem;
 	bool needsRegen;
+	bool needsProfileRefresh;
 
 	DECLARE_EVENT_TABLE()
 };
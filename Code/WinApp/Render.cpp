@@ -17,9 +17,9 @@
 
 //=============================================================================
 GAVisToolRender::GAVisToolRender( void ) :
-			selectionPrimitiveCache( 1024, 1024, 128, 0 ),
-			noAlphaBlendingPrimitiveCache( 1024 * 8, 1024 * 8, 1024 * 16, 0 ),
-			alphaBlendingPrimitiveCache( 1024 * 64, 1024 * 16, 1024 * 16, 1024 * 16 )
+			selectionPrimitiveCache( 1024, 1024, 128, 16, 0 ),
+			noAlphaBlendingPrimitiveCache( 1024 * 8, 1024 * 8, 1024 * 16, 128, 0 ),
+			alphaBlendingPrimitiveCache( 1024 * 64, 1024 * 16, 1024 * 16, 128, 1024 * 16 )
 {
 	SetRenderMode( RENDER_MODE_NO_ALPHA_SORTING );
 	userResolution = RES_MEDIUM;
@@ -246,10 +246,12 @@ GAVisToolRender::PrimitiveCache::PrimitiveCache(
 				int triangleHeapSize,
 				int lineHeapSize,
 				int pointHeapSize,
+				int pointBatchHeapSize,
 				int bspNodeHeapSize ) :
 				triangleHeap( triangleHeapSize ),
 				lineHeap( lineHeapSize ),
-				pointHeap( pointHeapSize )
+				pointHeap( pointHeapSize ),
+				pointBatchHeap( pointBatchHeapSize )
 {
 	if( bspNodeHeapSize > 0 )
 		bspTree = new BspTree( bspNodeHeapSize );
@@ -294,6 +296,15 @@ GAVisToolRender::Point* GAVisToolRender::PrimitiveCache::AllocatePoint( void )
 	return point;
 }
 
+//=============================================================================
+GAVisToolRender::PointBatch* GAVisToolRender::PrimitiveCache::AllocatePointBatch( void )
+{
+	PointBatch* pointBatch = pointBatchHeap.AllocateFresh();
+	if( pointBatch )
+		pointBatchList.InsertRightOf( pointBatchList.RightMost(), pointBatch );
+	return pointBatch;
+}
+
 //=============================================================================
 void GAVisToolRender::PrimitiveCache::Draw( GAVisToolRender& render )
 {
@@ -311,6 +322,13 @@ void GAVisToolRender::PrimitiveCache::Draw( GAVisToolRender& render )
 			point->Draw( render.GetDoLighting(), true, cameraFrame );
 	}
 
+	if( pointBatchList.Count() > 0 )
+	{
+		glPointSize( 3.f );
+		for( PointBatch* pointBatch = ( PointBatch* )pointBatchList.LeftMost(); pointBatch; pointBatch = ( PointBatch* )pointBatch->Right() )
+			pointBatch->Draw( render.GetDoLighting() );
+	}
+
 	// Now go draw all the lines and triangles.
 	if( optimizedForAlphaSorting )
 	{
@@ -340,6 +358,8 @@ void GAVisToolRender::PrimitiveCache::Wipe( void )
 	lineHeap.FreeAll();
 	pointList.RemoveAll( false );
 	pointHeap.FreeAll();
+	pointBatchList.RemoveAll( false );
+	pointBatchHeap.FreeAll();
 }
 
 //=============================================================================
@@ -693,6 +713,51 @@ void GAVisToolRender::Point::Draw( bool doLighting, bool asPoint, VectorMath::Co
 	VectorMath::Copy( center, vertex );
 }
 
+//=============================================================================
+GAVisToolRender::PointBatch::PointBatch( void )
+{
+	Reset();
+}
+
+//=============================================================================
+/*virtual*/ GAVisToolRender::PointBatch::~PointBatch( void )
+{
+}
+
+//=============================================================================
+void GAVisToolRender::PointBatch::Reset( void )
+{
+	vertexArray = 0;
+	normalArray = 0;
+	pointCount = 0;
+}
+
+//=============================================================================
+// The points of a batch all have the same color, so it only has to be specified once,
+// and then the vertices and normals go to OpenGL straight from the caller's arrays.
+void GAVisToolRender::PointBatch::Draw( bool doLighting )
+{
+	Color( doLighting, false );
+
+	glEnableClientState( GL_VERTEX_ARRAY );
+	glEnableClientState( GL_NORMAL_ARRAY );
+	glVertexPointer( 3, GL_DOUBLE, sizeof( VectorMath::Vector ), vertexArray );
+	glNormalPointer( GL_DOUBLE, sizeof( VectorMath::Vector ), normalArray );
+	glDrawArrays( GL_POINTS, 0, pointCount );
+	glDisableClientState( GL_NORMAL_ARRAY );
+	glDisableClientState( GL_VERTEX_ARRAY );
+}
+
+//=============================================================================
+/*virtual*/ void GAVisToolRender::PointBatch::CalcCenter( VectorMath::Vector& center )
+{
+	VectorMath::Zero( center );
+	for( int index = 0; index < pointCount; index++ )
+		VectorMath::Add( center, center, vertexArray[ index ] );
+	if( pointCount > 0 )
+		VectorMath::Scale( center, center, 1.0 / double( pointCount ) );
+}
+
 //=============================================================================
 void GAVisToolRender::Highlight( HighlightMethod highlightMethod )
 {
@@ -781,6 +846,28 @@ void GAVisToolRender::DrawPoint( const VectorMath::Vector& pos, const VectorMath
 		activePrimitiveCache->Flush( *this );
 }
 
+//=============================================================================
+void GAVisToolRender::DrawPoints( const VectorMath::Vector* posArray, const VectorMath::Vector* normalArray, int pointCount )
+{
+	if( pointCount <= 0 )
+		return;
+
+	PointBatch* pointBatch = activePrimitiveCache->AllocatePointBatch();
+	if( !pointBatch )
+		return;
+
+	VectorMath::Copy( pointBatch->color, currentColor );
+	pointBatch->alpha = currentAlpha;
+	pointBatch->highlightMethod = currentHighlightMethod;
+
+	pointBatch->vertexArray = posArray;
+	pointBatch->normalArray = normalArray;
+	pointBatch->pointCount = pointCount;
+
+	if( renderMode == RENDER_MODE_SELECTION )
+		activePrimitiveCache->Flush( *this );
+}
+
 //=============================================================================
 void GAVisToolRender::DrawTriangle( const VectorMath::Triangle& triangleGeometry, const VectorMath::TriangleNormals* triangleNormals /*= 0*/ )
 {
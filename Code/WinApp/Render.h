@@ -85,6 +85,7 @@ public:
 
 	// This is the main API for drawing stuff using the renderer.
 	void DrawPoint( const VectorMath::Vector& pos, const VectorMath::Vector& normal );
+	void DrawPoints( const VectorMath::Vector* posArray, const VectorMath::Vector* normalArray, int pointCount );
 	void DrawTriangle( const VectorMath::Triangle& triangleGeometry, const VectorMath::TriangleNormals* triangleNormals = 0 );
 	void DrawLine( const VectorMath::Vector& pos0, const VectorMath::Vector& pos1 );
 	void DrawTube( const VectorMath::Vector& pos0, const VectorMath::Vector& pos1, double tubeRadius, Resolution resolution = RES_USER );
@@ -259,17 +260,40 @@ private:
 		VectorMath::Vector vertex;
 	};
 
+	// Thousands of points can be drawn in one go this way, where each
+	// would otherwise take a primitive of its own from the point heap.
+	// A batch doesn't copy the points.  It draws straight from the
+	// caller's arrays, which must hold unit normals and stay put until
+	// the cache is next wiped.
+	class PointBatch : public Primitive
+	{
+	public:
+
+		PointBatch( void );
+		virtual ~PointBatch( void );
+
+		void Draw( bool doLighting );
+		void Reset( void );
+
+		virtual void CalcCenter( VectorMath::Vector& center );
+
+		const VectorMath::Vector* vertexArray;
+		const VectorMath::Vector* normalArray;
+		int pointCount;
+	};
+
 	class BspTree;
 
 	class PrimitiveCache
 	{
 	public:
-		PrimitiveCache( int triangleHeapSize, int lineHeapSize, int pointHeapSize, int bspNodeHeapSize );
+		PrimitiveCache( int triangleHeapSize, int lineHeapSize, int pointHeapSize, int pointBatchHeapSize, int bspNodeHeapSize );
 		virtual ~PrimitiveCache( void );
 
 		Triangle* AllocateTriangle( void );
 		Line* AllocateLine( void );
 		Point* AllocatePoint( void );
+		PointBatch* AllocatePointBatch( void );
 		void Draw( GAVisToolRender& render );		// Draw all primitives in this cache.
 		void Wipe( void );							// Reset this cache to empty.
 		void Flush( GAVisToolRender& render );		// Draw all primitives in this cache, then reset it to empty.
@@ -285,9 +309,11 @@ private:
 		Utilities::List triangleList;
 		Utilities::List lineList;
 		Utilities::List pointList;
+		Utilities::List pointBatchList;
 		ObjectHeap< Triangle > triangleHeap;
 		ObjectHeap< Line > lineHeap;
 		ObjectHeap< Point > pointHeap;
+		ObjectHeap< PointBatch > pointBatchHeap;
 		BspTree* bspTree;
 	};
 
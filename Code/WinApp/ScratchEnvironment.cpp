@@ -0,0 +1,207 @@
+// ScratchEnvironment.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "ScratchEnvironment.h"
+
+//=========================================================================================
+IMPLEMENT_CALCLIB_CLASS1( GAVisToolScratchEnvironment, GeometricAlgebraEnvironment );
+
+//=========================================================================================
+/*static*/ __declspec( thread ) GAVisToolScratchEnvironment::Pool* GAVisToolScratchEnvironment::threadPool = 0;
+/*static*/ wxCriticalSection GAVisToolScratchEnvironment::criticalSection;
+/*static*/ Utilities::List* GAVisToolScratchEnvironment::poolList = 0;
+
+//=========================================================================================
+GAVisToolScratchEnvironment::Loan::Loan( void )
+{
+	Pool* pool = ThreadPool();
+	pool->stats.loanCount++;
+
+	scratchEnv = ( GAVisToolScratchEnvironment* )pool->freeList.LeftMost();
+	if( scratchEnv )
+		pool->freeList.Remove( scratchEnv, false );
+	else
+	{
+		scratchEnv = new GAVisToolScratchEnvironment();
+		scratchEnv->pool = pool;
+		pool->stats.environmentCount++;
+		pool->stats.numberCount++;
+	}
+}
+
+//=========================================================================================
+GAVisToolScratchEnvironment::Loan::~Loan( void )
+{
+	if( scratchEnv->Reset() )
+		scratchEnv->pool->freeList.InsertRightOf( scratchEnv->pool->freeList.RightMost(), scratchEnv );
+	else
+		delete scratchEnv;
+}
+
+//=========================================================================================
+GAVisToolScratchEnvironment::Variable::Variable( const char* name )
+{
+	int len = strlen( name ) + 1;
+	this->name = new char[ len ];
+	strcpy_s( this->name, len, name );
+	defined = false;
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolScratchEnvironment::Variable::~Variable( void )
+{
+	delete[] name;
+}
+
+//=========================================================================================
+GAVisToolScratchEnvironment::Pool::Pool( void )
+{
+	stats.loanCount = 0;
+	stats.environmentCount = 0;
+	stats.numberCount = 0;
+	stats.variableCount = 0;
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolScratchEnvironment::Pool::~Pool( void )
+{
+	freeList.RemoveAll( true );
+}
+
+//=========================================================================================
+GAVisToolScratchEnvironment::GAVisToolScratchEnvironment( void )
+{
+	pool = 0;
+	storedInBase = false;
+	number = CreateNumber();
+	multivector = ( CalcLib::MultivectorNumber* )number;
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolScratchEnvironment::~GAVisToolScratchEnvironment( void )
+{
+	delete number;
+	variableList.RemoveAll( true );
+}
+
+//=========================================================================================
+/*static*/ GAVisToolScratchEnvironment::Pool* GAVisToolScratchEnvironment::ThreadPool( void )
+{
+	if( !threadPool )
+	{
+		threadPool = new Pool();
+
+		// We keep track of every pool so that they can all be freed at shutdown.
+		wxCriticalSectionLocker locker( criticalSection );
+		if( !poolList )
+			poolList = new Utilities::List();
+		poolList->InsertRightOf( poolList->RightMost(), threadPool );
+	}
+
+	return threadPool;
+}
+
+//=========================================================================================
+// Forget the values of all variables, but hang on to their storage.  If anything was
+// stored in the base environment, we can't forget it, so the environment is thrown away
+// rather than letting it leak into the next use.  The scripts only ever store multivectors,
+// so this shouldn't happen.
+bool GAVisToolScratchEnvironment::Reset( void )
+{
+	for( Variable* variable = ( Variable* )variableList.LeftMost(); variable; variable = ( Variable* )variable->Right() )
+		variable->defined = false;
+
+	return !storedInBase;
+}
+
+//=========================================================================================
+/*virtual*/ bool GAVisToolScratchEnvironment::LookupVariable( const char* variableName, CalcLib::Number& variableValue )
+{
+	Variable* variable = 0;
+	if( variableMap.Lookup( variableName, &variable ) && variable->defined )
+	{
+		if( variableValue.IsTypeOf( CalcLib::MultivectorNumber::ClassName() ) )
+		{
+			CalcLib::MultivectorNumber* multivectorNumber = ( CalcLib::MultivectorNumber* )&variableValue;
+			return multivectorNumber->AssignFrom( variable->value, *this );
+		}
+	}
+
+	// Constants, like the basis vectors, are still resolved the usual way.
+	return GeometricAlgebraEnvironment::LookupVariable( variableName, variableValue );
+}
+
+//=========================================================================================
+/*virtual*/ bool GAVisToolScratchEnvironment::StoreVariable( const char* variableName, const CalcLib::Number& variableValue )
+{
+	if( !variableValue.IsTypeOf( CalcLib::MultivectorNumber::ClassName() ) )
+	{
+		storedInBase = true;
+		return GeometricAlgebraEnvironment::StoreVariable( variableName, variableValue );
+	}
+
+	CalcLib::MultivectorNumber* multivectorNumber = ( CalcLib::MultivectorNumber* )&variableValue;
+
+	Variable* variable = 0;
+	if( !variableMap.Lookup( variableName, &variable ) )
+	{
+		variable = new Variable( variableName );
+		variableList.InsertRightOf( variableList.RightMost(), variable );
+		variableMap.Insert( variable->name, variable );
+		pool->stats.variableCount++;
+	}
+
+	if( !multivectorNumber->AssignTo( variable->value, *this ) )
+		return false;
+
+	variable->defined = true;
+	return true;
+}
+
+//=========================================================================================
+// The counts of other threads may be a little behind while they're running scripts.
+/*static*/ void GAVisToolScratchEnvironment::GetStats( Stats& stats )
+{
+	stats.loanCount = 0;
+	stats.environmentCount = 0;
+	stats.numberCount = 0;
+	stats.variableCount = 0;
+
+	wxCriticalSectionLocker locker( criticalSection );
+
+	if( !poolList )
+		return;
+
+	for( const Pool* pool = ( const Pool* )poolList->LeftMost(); pool; pool = ( const Pool* )pool->Right() )
+	{
+		stats.loanCount += pool->stats.loanCount;
+		stats.environmentCount += pool->stats.environmentCount;
+		stats.numberCount += pool->stats.numberCount;
+		stats.variableCount += pool->stats.variableCount;
+	}
+}
+
+//=========================================================================================
+/*static*/ void GAVisToolScratchEnvironment::Shutdown( void )
+{
+	wxCriticalSectionLocker locker( criticalSection );
+
+	if( poolList )
+		poolList->RemoveAll( true );
+	delete poolList;
+	poolList = 0;
+
+	// Only the thread calling this can forget its pool.  Any other thread
+	// still holding on to one has no business running scripts anymore.
+	threadPool = 0;
+}
+
+// ScratchEnvironment.cpp
\ No newline at end of file
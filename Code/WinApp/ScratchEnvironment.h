@@ -0,0 +1,113 @@
+// ScratchEnvironment.h
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#pragma once
+
+#include "Calculator/CalcLib.h"
+#include "wxAll.h"
+
+//=========================================================================================
+// The geometries run their scripts in a scratch environment, and they do so every time a
+// bound variable is stored or looked up, so building one from scratch every time adds up.
+// Instead, scratch environments are pooled per thread and reset between uses.  A reset
+// environment forgets the values of its variables, but keeps the storage for them, as well
+// as the number that every script evaluates into, so that after the first few uses, a
+// script run allocates nothing on our end.  Use a loan to borrow one.
+class GAVisToolScratchEnvironment : public CalcLib::GeometricAlgebraEnvironment, public Utilities::List::Item
+{
+	DECLARE_CALCLIB_CLASS( GAVisToolScratchEnvironment );
+
+public:
+
+	//=========================================================================================
+	class Loan
+	{
+	public:
+
+		Loan( void );
+		~Loan( void );
+
+		GAVisToolScratchEnvironment* scratchEnv;
+	};
+
+	virtual bool LookupVariable( const char* variableName, CalcLib::Number& variableValue ) override;
+	virtual bool StoreVariable( const char* variableName, const CalcLib::Number& variableValue ) override;
+
+	// The number and multivector are the same object.
+	CalcLib::Number* number;
+	CalcLib::MultivectorNumber* multivector;
+
+	// These counts are summed over the pools of all threads.
+	struct Stats
+	{
+		int loanCount;
+		int environmentCount;
+		int numberCount;
+		int variableCount;
+	};
+
+	static void GetStats( Stats& stats );
+
+	// All loans must have been returned before this is called.
+	static void Shutdown( void );
+
+private:
+
+	GAVisToolScratchEnvironment( void );
+	virtual ~GAVisToolScratchEnvironment( void );
+
+	// Return false if the environment can't be reused.
+	bool Reset( void );
+
+	//=========================================================================================
+	class Variable : public Utilities::List::Item
+	{
+	public:
+
+		Variable( const char* name );
+		virtual ~Variable( void );
+
+		char* name;
+		GeometricAlgebra::SumOfBlades value;
+		bool defined;
+	};
+
+	//=========================================================================================
+	class Pool : public Utilities::List::Item
+	{
+	public:
+
+		Pool( void );
+		virtual ~Pool( void );
+
+		Utilities::List freeList;
+		Stats stats;
+	};
+
+	static Pool* ThreadPool( void );
+
+	Utilities::List variableList;
+	Utilities::Map< Variable* > variableMap;
+	Pool* pool;
+
+	// We only keep multivectors ourselves.  Anything else goes to the base environment,
+	// which has no way to forget it.
+	bool storedInBase;
+
+	static __declspec( thread ) Pool* threadPool;
+
+	// This protects the list of pools, but not the pools themselves, which are only ever
+	// touched by the thread that owns them.
+	static wxCriticalSection criticalSection;
+	static Utilities::List* poolList;
+};
+
+// ScratchEnvironment.h
\ No newline at end of file
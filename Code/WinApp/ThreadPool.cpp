@@ -0,0 +1,173 @@
+// ThreadPool.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "ThreadPool.h"
+
+//=========================================================================================
+GAVisToolThreadPool::GAVisToolThreadPool( void )
+{
+	taskArray = 0;
+	taskCount = 0;
+	nextTaskIndex = 0;
+	busy = false;
+	shutdown = false;
+
+	// The CPU count is -1 when it can't be determined, in which case we go without workers.
+	int cpuCount = wxThread::GetCPUCount();
+	int maxWorkerCount = cpuCount > 1 ? cpuCount - 1 : 0;
+
+	workerArray = new Worker*[ maxWorkerCount > 0 ? maxWorkerCount : 1 ];
+	workerCount = 0;
+
+	for( int index = 0; index < maxWorkerCount; index++ )
+	{
+		Worker* worker = new Worker( this );
+		if( worker->Create() != wxTHREAD_NO_ERROR || worker->Run() != wxTHREAD_NO_ERROR )
+		{
+			delete worker;
+			break;
+		}
+
+		workerArray[ workerCount++ ] = worker;
+	}
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolThreadPool::~GAVisToolThreadPool( void )
+{
+	Shutdown();
+
+	delete[] workerArray;
+}
+
+//=========================================================================================
+int GAVisToolThreadPool::WorkerCount( void ) const
+{
+	return workerCount;
+}
+
+//=========================================================================================
+void GAVisToolThreadPool::Shutdown( void )
+{
+	{
+		wxCriticalSectionLocker locker( criticalSection );
+
+		shutdown = true;
+	}
+
+	for( int index = 0; index < workerCount; index++ )
+		workSemaphore.Post();
+
+	for( int index = 0; index < workerCount; index++ )
+	{
+		workerArray[ index ]->Wait();
+		delete workerArray[ index ];
+	}
+
+	workerCount = 0;
+}
+
+//=========================================================================================
+/*virtual*/ void GAVisToolThreadPool::ExecuteTasks( Task** taskArray, int taskCount )
+{
+	bool executeAlone = false;
+
+	{
+		wxCriticalSectionLocker locker( criticalSection );
+
+		if( busy || shutdown || workerCount == 0 || taskCount < 2 )
+			executeAlone = true;
+		else
+		{
+			busy = true;
+			this->taskArray = taskArray;
+			this->taskCount = taskCount;
+			nextTaskIndex = 0;
+		}
+	}
+
+	if( executeAlone )
+	{
+		for( int index = 0; index < taskCount; index++ )
+			taskArray[ index ]->Execute();
+		return;
+	}
+
+	// There's no sense in waking a worker that won't find a task to take.  A worker may
+	// take more than its share of the posts, but each post gets exactly one done post back.
+	int wakeCount = workerCount < taskCount - 1 ? workerCount : taskCount - 1;
+	for( int index = 0; index < wakeCount; index++ )
+		workSemaphore.Post();
+
+	ExecuteTakenTasks();
+
+	for( int index = 0; index < wakeCount; index++ )
+		doneSemaphore.Wait();
+
+	wxCriticalSectionLocker locker( criticalSection );
+
+	this->taskArray = 0;
+	this->taskCount = 0;
+	busy = false;
+}
+
+//=========================================================================================
+GAVisToolThreadPool::Task* GAVisToolThreadPool::TakeTask( void )
+{
+	wxCriticalSectionLocker locker( criticalSection );
+
+	if( nextTaskIndex >= taskCount )
+		return 0;
+
+	return taskArray[ nextTaskIndex++ ];
+}
+
+//=========================================================================================
+void GAVisToolThreadPool::ExecuteTakenTasks( void )
+{
+	Task* task = 0;
+	while( ( task = TakeTask() ) != 0 )
+		task->Execute();
+}
+
+//=========================================================================================
+GAVisToolThreadPool::Worker::Worker( GAVisToolThreadPool* threadPool ) : wxThread( wxTHREAD_JOINABLE )
+{
+	this->threadPool = threadPool;
+}
+
+//=========================================================================================
+/*virtual*/ GAVisToolThreadPool::Worker::~Worker( void )
+{
+}
+
+//=========================================================================================
+/*virtual*/ wxThread::ExitCode GAVisToolThreadPool::Worker::Entry( void )
+{
+	while( true )
+	{
+		threadPool->workSemaphore.Wait();
+
+		{
+			wxCriticalSectionLocker locker( threadPool->criticalSection );
+
+			if( threadPool->shutdown )
+				break;
+		}
+
+		threadPool->ExecuteTakenTasks();
+		threadPool->doneSemaphore.Post();
+	}
+
+	return 0;
+}
+
+// ThreadPool.cpp
\ No newline at end of file
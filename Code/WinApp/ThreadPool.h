@@ -0,0 +1,72 @@
+// ThreadPool.h
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#pragma once
+
+#include "wxAll.h"
+#include "VectorMath/ParallelInterface.h"
+
+//=========================================================================================
+// The workers are started once, up front, one for every core but the main thread's, and
+// then sleep until there are tasks.  The thread handing out the tasks executes them too,
+// and when it's done, waits for whatever tasks the workers took.  Only one set of tasks is
+// executed at a time; should a second set show up in the meantime, be it from another
+// thread or from one of the tasks, whoever brought it executes it alone.
+class GAVisToolThreadPool : public VectorMath::ParallelInterface
+{
+public:
+
+	GAVisToolThreadPool( void );
+	virtual ~GAVisToolThreadPool( void );
+
+	virtual void ExecuteTasks( Task** taskArray, int taskCount ) override;
+
+	void Shutdown( void );
+
+	int WorkerCount( void ) const;
+
+private:
+
+	//=========================================================================================
+	class Worker : public wxThread
+	{
+	public:
+
+		Worker( GAVisToolThreadPool* threadPool );
+		virtual ~Worker( void );
+
+	private:
+
+		virtual ExitCode Entry( void ) override;
+
+		GAVisToolThreadPool* threadPool;
+	};
+
+	// Zero is returned once all tasks have been taken.
+	Task* TakeTask( void );
+	void ExecuteTakenTasks( void );
+
+	Worker** workerArray;
+	int workerCount;
+
+	// This protects everything below it.
+	wxCriticalSection criticalSection;
+	Task** taskArray;
+	int taskCount;
+	int nextTaskIndex;
+	bool busy;
+	bool shutdown;
+
+	wxSemaphore workSemaphore;
+	wxSemaphore doneSemaphore;
+};
+
+// ThreadPool.h
\ No newline at end of file
@@ -39,6 +39,17 @@ void VectorMath::MakeAabb( Aabb& aabb, const Vector& center, const Vector& delta
 	Add( aabb.max, center, delta );
 }
 
+//=============================================================================
+// Not all surfaces fit in a finite volume, so unless told otherwise,
+// the meshers and samplers confine themselves to this box.
+void VectorMath::MakeDefaultAabb( Aabb& aabb )
+{
+	Vector center, delta;
+	Zero( center );
+	Set( delta, 10.0, 10.0, 10.0 );
+	MakeAabb( aabb, center, delta );
+}
+
 //=============================================================================
 void VectorMath::CopyAabb( Aabb& dstAabb, const Aabb& srcAabb )
 {
@@ -56,17 +67,17 @@ void VectorMath::MakeZeroAabb( Aabb& aabb, const Vector& center )
 //=============================================================================
 void VectorMath::ExpandAabb( Aabb& aabb, const Vector& pos )
 {
-	if( aabb.min.x < pos.x )
+	if( pos.x < aabb.min.x )
 		aabb.min.x = pos.x;
 	else if( aabb.max.x < pos.x )
 		aabb.max.x = pos.x;
 
-	if( aabb.min.y < pos.y )
+	if( pos.y < aabb.min.y )
 		aabb.min.y = pos.y;
 	else if( aabb.max.y < pos.y )
 		aabb.max.y = pos.y;
 
-	if( aabb.min.z < pos.z )
+	if( pos.z < aabb.min.z )
 		aabb.min.z = pos.z;
 	else if( aabb.max.z < pos.z )
 		aabb.max.z = pos.z;
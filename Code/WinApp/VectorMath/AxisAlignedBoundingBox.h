@@ -38,6 +38,7 @@ namespace VectorMath
 	bool IsValidAabb( const Aabb& aabb );
 	void MakeAabbMinMax( Aabb& aabb, const Vector& min, const Vector& max );
 	void MakeAabb( Aabb& aabb, const Vector& center, const Vector& delta );
+	void MakeDefaultAabb( Aabb& aabb );
 	void CopyAabb( Aabb& dstAabb, const Aabb& srcAabb );
 	void MakeZeroAabb( Aabb& aabb, const Vector& center );
 	void ExpandAabb( Aabb& aabb, const Vector& pos );
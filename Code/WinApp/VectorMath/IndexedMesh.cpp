@@ -0,0 +1,66 @@
+// IndexedMesh.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "IndexedMesh.h"
+
+using namespace VectorMath;
+
+//=============================================================================
+IndexedMesh::IndexedMesh( void )
+{
+	vertexArray = 0;
+	normalArray = 0;
+	vertexCount = 0;
+
+	indexArray = 0;
+	triangleCount = 0;
+}
+
+//=============================================================================
+/*virtual*/ IndexedMesh::~IndexedMesh( void )
+{
+	IndexedMesh::WipeClean();
+}
+
+//=============================================================================
+/*virtual*/ void IndexedMesh::WipeClean( void )
+{
+	delete[] vertexArray;
+	delete[] normalArray;
+	vertexArray = 0;
+	normalArray = 0;
+	vertexCount = 0;
+
+	delete[] indexArray;
+	indexArray = 0;
+	triangleCount = 0;
+}
+
+//=============================================================================
+void IndexedMesh::Render( SurfaceMesh::RenderInterface& renderInterface, const Vector& color, double alpha ) const
+{
+	for( int index = 0; index < triangleCount; index++ )
+	{
+		const int* triangleIndex = &indexArray[ index * 3 ];
+
+		VectorMath::Triangle triangle;
+		VectorMath::TriangleNormals triangleNormals;
+		for( int corner = 0; corner < 3; corner++ )
+		{
+			Copy( triangle.vertex[ corner ], vertexArray[ triangleIndex[ corner ] ] );
+			Copy( triangleNormals.normal[ corner ], normalArray[ triangleIndex[ corner ] ] );
+		}
+
+		renderInterface.RenderTriangle( triangle, &triangleNormals, color, alpha );
+	}
+}
+
+// IndexedMesh.cpp
\ No newline at end of file
@@ -0,0 +1,49 @@
+// IndexedMesh.h
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#pragma once
+
+#include "SurfaceMesh.h"
+
+namespace VectorMath
+{
+	//=============================================================================
+	// Meshers that produce all of their triangles at once keep them here, as a
+	// list of vertices with normals and a list of triangles indexing into it.
+	class IndexedMesh
+	{
+	public:
+
+		IndexedMesh( void );
+		virtual ~IndexedMesh( void );
+
+		virtual void WipeClean( void );
+
+		// Provide what might be a convenient way to render the mesh.
+		void Render( SurfaceMesh::RenderInterface& renderInterface, const Vector& color, double alpha ) const;
+
+		int VertexCount( void ) const { return vertexCount; }
+		int TriangleCount( void ) const { return triangleCount; }
+
+	protected:
+
+		Vector* vertexArray;
+		Vector* normalArray;
+		int vertexCount;
+
+		// Every three of these make a triangle whose vertices are counter clock-wise
+		// when seen from the side of the surface that its gradient points toward.
+		int* indexArray;
+		int triangleCount;
+	};
+}
+
+// IndexedMesh.h
\ No newline at end of file
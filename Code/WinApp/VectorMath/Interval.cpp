@@ -0,0 +1,110 @@
+// Interval.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "Interval.h"
+
+//=============================================================================
+void VectorMath::MakeInterval( Interval& interval, double min, double max )
+{
+	interval.min = min;
+	interval.max = max;
+}
+
+//=============================================================================
+void VectorMath::MakeInterval( Interval& interval, double value )
+{
+	interval.min = value;
+	interval.max = value;
+}
+
+//=============================================================================
+void VectorMath::AddInterval( Interval& dst, const Interval& leftSrc, const Interval& rightSrc )
+{
+	dst.min = leftSrc.min + rightSrc.min;
+	dst.max = leftSrc.max + rightSrc.max;
+}
+
+//=============================================================================
+void VectorMath::ScaleInterval( Interval& dst, const Interval& src, double scalar )
+{
+	double min = src.min * scalar;
+	double max = src.max * scalar;
+	if( scalar < 0.0 )
+	{
+		dst.min = max;
+		dst.max = min;
+	}
+	else
+	{
+		dst.min = min;
+		dst.max = max;
+	}
+}
+
+//=============================================================================
+void VectorMath::AddScaleInterval( Interval& dst, const Interval& leftSrc, const Interval& rightSrc, double scalar )
+{
+	Interval scaled;
+	ScaleInterval( scaled, rightSrc, scalar );
+	AddInterval( dst, leftSrc, scaled );
+}
+
+//=============================================================================
+void VectorMath::MultiplyInterval( Interval& dst, const Interval& leftSrc, const Interval& rightSrc )
+{
+	double product[4];
+	product[0] = leftSrc.min * rightSrc.min;
+	product[1] = leftSrc.min * rightSrc.max;
+	product[2] = leftSrc.max * rightSrc.min;
+	product[3] = leftSrc.max * rightSrc.max;
+
+	dst.min = product[0];
+	dst.max = product[0];
+	for( int index = 1; index < 4; index++ )
+	{
+		if( product[ index ] < dst.min )
+			dst.min = product[ index ];
+		if( product[ index ] > dst.max )
+			dst.max = product[ index ];
+	}
+}
+
+//=============================================================================
+// This is tighter than multiplying the interval by itself, because both
+// factors are always the same value, so the result is never negative.
+void VectorMath::SquareInterval( Interval& dst, const Interval& src )
+{
+	double minSquared = src.min * src.min;
+	double maxSquared = src.max * src.max;
+	if( src.min >= 0.0 )
+	{
+		dst.min = minSquared;
+		dst.max = maxSquared;
+	}
+	else if( src.max <= 0.0 )
+	{
+		dst.min = maxSquared;
+		dst.max = minSquared;
+	}
+	else
+	{
+		dst.min = 0.0;
+		dst.max = minSquared > maxSquared ? minSquared : maxSquared;
+	}
+}
+
+//=============================================================================
+bool VectorMath::IntervalContains( const Interval& interval, double value )
+{
+	return interval.min <= value && value <= interval.max;
+}
+
+// Interval.cpp
\ No newline at end of file
@@ -0,0 +1,33 @@
+// Interval.h
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#pragma once
+
+// Provide basic interval arithmetic support.  The result of each operation
+// contains every value the operation can take on over the given intervals.
+namespace VectorMath
+{
+	struct Interval
+	{
+		double min, max;
+	};
+
+	void MakeInterval( Interval& interval, double min, double max );
+	void MakeInterval( Interval& interval, double value );
+	void AddInterval( Interval& dst, const Interval& leftSrc, const Interval& rightSrc );
+	void ScaleInterval( Interval& dst, const Interval& src, double scalar );
+	void AddScaleInterval( Interval& dst, const Interval& leftSrc, const Interval& rightSrc, double scalar );
+	void MultiplyInterval( Interval& dst, const Interval& leftSrc, const Interval& rightSrc );
+	void SquareInterval( Interval& dst, const Interval& src );
+	bool IntervalContains( const Interval& interval, double value );
+}
+
+// Interval.h
\ No newline at end of file
@@ -0,0 +1,524 @@
+// LatticeMesh.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "LatticeMesh.h"
+#include "Assert.h"
+#include <math.h>
+
+using namespace VectorMath;
+
+//=============================================================================
+LatticeMesh::LatticeMesh( void )
+{
+	blockArray = 0;
+	blockArraySize = 0;
+}
+
+//=============================================================================
+/*virtual*/ LatticeMesh::~LatticeMesh( void )
+{
+	delete[] blockArray;
+}
+
+//=============================================================================
+/*virtual*/ void LatticeMesh::WipeClean( void )
+{
+	IndexedMesh::WipeClean();
+
+	delete[] blockArray;
+	blockArray = 0;
+	blockArraySize = 0;
+}
+
+//=============================================================================
+// Setup reasonable defaults here.
+LatticeMesh::GenerationParameters::GenerationParameters( void )
+{
+	MakeDefaultAabb( aabb );
+
+	// Features of the surface smaller than this are lost.
+	cellSize = 0.25;
+
+	// This makes for a few hundred tasks in the default box, with each
+	// task evaluating the surface at a few hundred points in one batch.
+	blockSize = 8;
+}
+
+//=============================================================================
+/*virtual*/ LatticeMesh::GenerationParameters::~GenerationParameters( void )
+{
+}
+
+//=============================================================================
+LatticeMesh::Block::Block( void )
+{
+	valueArray = 0;
+	vertexIndexArray = 0;
+	vertexArray = 0;
+	normalArray = 0;
+	vertexCount = 0;
+	vertexOffset = 0;
+	indexArray = 0;
+	triangleCount = 0;
+}
+
+//=============================================================================
+/*virtual*/ LatticeMesh::Block::~Block( void )
+{
+	WipeClean();
+}
+
+//=============================================================================
+void LatticeMesh::Block::WipeClean( void )
+{
+	delete[] valueArray;
+	delete[] vertexIndexArray;
+	delete[] vertexArray;
+	delete[] normalArray;
+	delete[] indexArray;
+
+	valueArray = 0;
+	vertexIndexArray = 0;
+	vertexArray = 0;
+	normalArray = 0;
+	vertexCount = 0;
+	indexArray = 0;
+	triangleCount = 0;
+}
+
+//=============================================================================
+int LatticeMesh::Block::LatticePointOffset( int i, int j, int k ) const
+{
+	return ( i * ( cellCount[1] + 1 ) + j ) * ( cellCount[2] + 1 ) + k;
+}
+
+//=============================================================================
+int LatticeMesh::Block::CellOffset( int i, int j, int k ) const
+{
+	return ( i * cellCount[1] + j ) * cellCount[2] + k;
+}
+
+//=============================================================================
+static double ClampToRange( double value, double min, double max )
+{
+	if( value < min )
+		return min;
+	if( value > max )
+		return max;
+	return value;
+}
+
+//=============================================================================
+LatticeMesh::VertexTask::VertexTask( void )
+{
+	surface = 0;
+	lattice = 0;
+	block = 0;
+}
+
+//=============================================================================
+/*virtual*/ LatticeMesh::VertexTask::~VertexTask( void )
+{
+}
+
+//=============================================================================
+/*virtual*/ void LatticeMesh::VertexTask::Execute( void )
+{
+	int latticePointCount = ( block->cellCount[0] + 1 ) * ( block->cellCount[1] + 1 ) * ( block->cellCount[2] + 1 );
+	Vector* latticePointArray = new Vector[ latticePointCount ];
+	block->valueArray = new double[ latticePointCount ];
+
+	int i, j, k;
+	for( i = 0; i <= block->cellCount[0]; i++ )
+	{
+		for( j = 0; j <= block->cellCount[1]; j++ )
+		{
+			for( k = 0; k <= block->cellCount[2]; k++ )
+			{
+				Set( latticePointArray[ block->LatticePointOffset( i, j, k ) ],
+						lattice->origin[0] + double( block->cellOrigin[0] + i ) * lattice->cellDelta[0],
+						lattice->origin[1] + double( block->cellOrigin[1] + j ) * lattice->cellDelta[1],
+						lattice->origin[2] + double( block->cellOrigin[2] + k ) * lattice->cellDelta[2] );
+			}
+		}
+	}
+
+	surface->EvaluateBatch( latticePointArray, latticePointCount, block->valueArray, 0 );
+	delete[] latticePointArray;
+
+	// If the surface doesn't pass through the block, we're done with it.
+	int negativeCount = 0;
+	for( int index = 0; index < latticePointCount; index++ )
+		if( block->valueArray[ index ] < 0.0 )
+			negativeCount++;
+	if( negativeCount == 0 || negativeCount == latticePointCount )
+	{
+		block->WipeClean();
+		return;
+	}
+
+	int cellCount = block->cellCount[0] * block->cellCount[1] * block->cellCount[2];
+	block->vertexIndexArray = new int[ cellCount ];
+	block->vertexArray = new Vector[ cellCount ];
+	Vector* cellMinArray = new Vector[ cellCount ];
+
+	for( i = 0; i < block->cellCount[0]; i++ )
+	{
+		for( j = 0; j < block->cellCount[1]; j++ )
+		{
+			for( k = 0; k < block->cellCount[2]; k++ )
+			{
+				// Corner N of the cell is offset from its minimum corner along axis A when bit A of N is set.
+				double cornerValue[8];
+				int cornerNegativeCount = 0;
+				for( int corner = 0; corner < 8; corner++ )
+				{
+					cornerValue[ corner ] = block->valueArray[ block->LatticePointOffset( i + ( corner & 1 ), j + ( ( corner >> 1 ) & 1 ), k + ( ( corner >> 2 ) & 1 ) ) ];
+					if( cornerValue[ corner ] < 0.0 )
+						cornerNegativeCount++;
+				}
+
+				int* vertexIndex = &block->vertexIndexArray[ block->CellOffset( i, j, k ) ];
+				if( cornerNegativeCount == 0 || cornerNegativeCount == 8 )
+				{
+					*vertexIndex = -1;
+					continue;
+				}
+
+				// Place the vertex at the average of where the surface crosses the edges of the cell.
+				// This is done in the unit cube and then mapped into the cell.
+				double crossing[3] = { 0.0, 0.0, 0.0 };
+				int crossingCount = 0;
+				for( int corner = 0; corner < 8; corner++ )
+				{
+					for( int axis = 0; axis < 3; axis++ )
+					{
+						int otherCorner = corner | ( 1 << axis );
+						if( otherCorner == corner || ( cornerValue[ corner ] < 0.0 ) == ( cornerValue[ otherCorner ] < 0.0 ) )
+							continue;
+
+						double lerp = cornerValue[ corner ] / ( cornerValue[ corner ] - cornerValue[ otherCorner ] );
+						for( int component = 0; component < 3; component++ )
+						{
+							if( component == axis )
+								crossing[ component ] += lerp;
+							else
+								crossing[ component ] += double( ( corner >> component ) & 1 );
+						}
+						crossingCount++;
+					}
+				}
+
+				*vertexIndex = block->vertexCount++;
+				Vector* cellMin = &cellMinArray[ *vertexIndex ];
+				Set( *cellMin,
+						lattice->origin[0] + double( block->cellOrigin[0] + i ) * lattice->cellDelta[0],
+						lattice->origin[1] + double( block->cellOrigin[1] + j ) * lattice->cellDelta[1],
+						lattice->origin[2] + double( block->cellOrigin[2] + k ) * lattice->cellDelta[2] );
+				Set( block->vertexArray[ *vertexIndex ],
+						cellMin->x + crossing[0] / double( crossingCount ) * lattice->cellDelta[0],
+						cellMin->y + crossing[1] / double( crossingCount ) * lattice->cellDelta[1],
+						cellMin->z + crossing[2] / double( crossingCount ) * lattice->cellDelta[2] );
+			}
+		}
+	}
+
+	// The averaged crossings are only near the surface, so take a Newton step toward it,
+	// keeping each vertex in its cell so that the quads stay well behaved.  The gradient
+	// at the final position of each vertex is its normal.
+	double* valueArray = new double[ block->vertexCount ];
+	double* projectedValueArray = new double[ block->vertexCount ];
+	Vector* gradientArray = new Vector[ block->vertexCount ];
+	Vector* averageArray = new Vector[ block->vertexCount ];
+	block->normalArray = new Vector[ block->vertexCount ];
+
+	surface->EvaluateBatch( block->vertexArray, block->vertexCount, valueArray, gradientArray );
+
+	for( int index = 0; index < block->vertexCount; index++ )
+	{
+		Vector* vertex = &block->vertexArray[ index ];
+		Copy( averageArray[ index ], *vertex );
+
+		double squareLength = Dot( gradientArray[ index ], gradientArray[ index ] );
+		if( squareLength == 0.0 )
+			continue;
+
+		AddScale( *vertex, *vertex, gradientArray[ index ], -valueArray[ index ] / squareLength );
+
+		const Vector* cellMin = &cellMinArray[ index ];
+		vertex->x = ClampToRange( vertex->x, cellMin->x, cellMin->x + lattice->cellDelta[0] );
+		vertex->y = ClampToRange( vertex->y, cellMin->y, cellMin->y + lattice->cellDelta[1] );
+		vertex->z = ClampToRange( vertex->z, cellMin->z, cellMin->z + lattice->cellDelta[2] );
+	}
+
+	surface->EvaluateBatch( block->vertexArray, block->vertexCount, projectedValueArray, block->normalArray );
+
+	for( int index = 0; index < block->vertexCount; index++ )
+	{
+		// Don't keep a step that made matters worse.
+		if( fabs( projectedValueArray[ index ] ) > fabs( valueArray[ index ] ) )
+		{
+			Copy( block->vertexArray[ index ], averageArray[ index ] );
+			Copy( block->normalArray[ index ], gradientArray[ index ] );
+		}
+
+		if( Dot( block->normalArray[ index ], block->normalArray[ index ] ) > 0.0 )
+			Normalize( block->normalArray[ index ], block->normalArray[ index ] );
+	}
+
+	delete[] valueArray;
+	delete[] projectedValueArray;
+	delete[] gradientArray;
+	delete[] averageArray;
+	delete[] cellMinArray;
+}
+
+//=============================================================================
+LatticeMesh::FaceTask::FaceTask( void )
+{
+	latticeMesh = 0;
+	block = 0;
+}
+
+//=============================================================================
+/*virtual*/ LatticeMesh::FaceTask::~FaceTask( void )
+{
+}
+
+//=============================================================================
+// Each lattice edge crossed by the surface is handled by the block of the cell
+// at its minimum end, which has both ends of the edge among its lattice points.
+// Edges on the sides of the lattice lack the four cells needed to make a quad.
+/*virtual*/ void LatticeMesh::FaceTask::Execute( void )
+{
+	if( !block->vertexIndexArray )
+		return;
+
+	// The first pass counts the triangles and the second makes them.
+	for( int pass = 0; pass < 2; pass++ )
+	{
+		if( pass == 1 )
+		{
+			if( block->triangleCount == 0 )
+				break;
+			block->indexArray = new int[ block->triangleCount * 3 ];
+			block->triangleCount = 0;
+		}
+
+		for( int i = 0; i < block->cellCount[0]; i++ )
+		{
+			for( int j = 0; j < block->cellCount[1]; j++ )
+			{
+				for( int k = 0; k < block->cellCount[2]; k++ )
+				{
+					int cell[3] = { block->cellOrigin[0] + i, block->cellOrigin[1] + j, block->cellOrigin[2] + k };
+					double value = block->valueArray[ block->LatticePointOffset( i, j, k ) ];
+
+					for( int axis = 0; axis < 3; axis++ )
+					{
+						int nextAxis = ( axis + 1 ) % 3;
+						int lastAxis = ( axis + 2 ) % 3;
+						if( cell[ nextAxis ] == 0 || cell[ lastAxis ] == 0 )
+							continue;
+
+						double otherValue = block->valueArray[ block->LatticePointOffset( i + ( axis == 0 ? 1 : 0 ), j + ( axis == 1 ? 1 : 0 ), k + ( axis == 2 ? 1 : 0 ) ) ];
+						if( ( value < 0.0 ) == ( otherValue < 0.0 ) )
+							continue;
+
+						// Going around the edge through these cells is counter clock-wise when
+						// looking down the edge from its far end.
+						int quadCell[4][3];
+						for( int corner = 0; corner < 4; corner++ )
+						{
+							quadCell[ corner ][0] = cell[0];
+							quadCell[ corner ][1] = cell[1];
+							quadCell[ corner ][2] = cell[2];
+						}
+						quadCell[1][ nextAxis ]--;
+						quadCell[2][ nextAxis ]--;
+						quadCell[2][ lastAxis ]--;
+						quadCell[3][ lastAxis ]--;
+
+						int quadVertex[4];
+						int corner;
+						for( corner = 0; corner < 4; corner++ )
+						{
+							quadVertex[ corner ] = latticeMesh->FindVertex( quadCell[ corner ][0], quadCell[ corner ][1], quadCell[ corner ][2] );
+							if( quadVertex[ corner ] == -1 )
+								break;
+						}
+
+						// Every cell around a crossed edge straddles the surface, so this shouldn't happen.
+						assert->Condition( corner == 4, "A cell around a crossed edge has no vertex." );
+						if( corner < 4 )
+							continue;
+
+						if( pass == 1 )
+						{
+							// Face the quad in the direction the surface increases across the edge.
+							int* index = &block->indexArray[ block->triangleCount * 3 ];
+							if( value < 0.0 )
+							{
+								index[0] = quadVertex[0]; index[1] = quadVertex[1]; index[2] = quadVertex[2];
+								index[3] = quadVertex[0]; index[4] = quadVertex[2]; index[5] = quadVertex[3];
+							}
+							else
+							{
+								index[0] = quadVertex[0]; index[1] = quadVertex[2]; index[2] = quadVertex[1];
+								index[3] = quadVertex[0]; index[4] = quadVertex[3]; index[5] = quadVertex[2];
+							}
+						}
+
+						block->triangleCount += 2;
+					}
+				}
+			}
+		}
+	}
+}
+
+//=============================================================================
+// The given cell is in lattice coordinates, and the returned vertex index is
+// the one the vertex will have in the mesh once the blocks are gathered up.
+int LatticeMesh::FindVertex( int i, int j, int k ) const
+{
+	int blockIndex = ( ( i / lattice.blockSize ) * lattice.blockCount[1] + ( j / lattice.blockSize ) ) * lattice.blockCount[2] + ( k / lattice.blockSize );
+	const Block* block = &blockArray[ blockIndex ];
+	if( !block->vertexIndexArray )
+		return -1;
+
+	int vertexIndex = block->vertexIndexArray[ block->CellOffset( i - block->cellOrigin[0], j - block->cellOrigin[1], k - block->cellOrigin[2] ) ];
+	if( vertexIndex == -1 )
+		return -1;
+
+	return block->vertexOffset + vertexIndex;
+}
+
+//=============================================================================
+bool LatticeMesh::Generate( const Surface& surface, const GenerationParameters& genParms, ParallelInterface* parallelInterface /*= 0*/ )
+{
+	WipeClean();
+
+	if( !IsValidAabb( genParms.aabb ) || genParms.cellSize <= 0.0 || genParms.blockSize < 1 )
+		return false;
+
+	double boxMin[3] = { genParms.aabb.min.x, genParms.aabb.min.y, genParms.aabb.min.z };
+	double boxMax[3] = { genParms.aabb.max.x, genParms.aabb.max.y, genParms.aabb.max.z };
+
+	lattice.blockSize = genParms.blockSize;
+	for( int axis = 0; axis < 3; axis++ )
+	{
+		double extent = boxMax[ axis ] - boxMin[ axis ];
+		lattice.cellCount[ axis ] = int( ceil( extent / genParms.cellSize ) );
+		if( lattice.cellCount[ axis ] < 1 )
+			lattice.cellCount[ axis ] = 1;
+		lattice.origin[ axis ] = boxMin[ axis ];
+		lattice.cellDelta[ axis ] = extent / double( lattice.cellCount[ axis ] );
+		lattice.blockCount[ axis ] = ( lattice.cellCount[ axis ] + lattice.blockSize - 1 ) / lattice.blockSize;
+	}
+
+	blockArraySize = lattice.blockCount[0] * lattice.blockCount[1] * lattice.blockCount[2];
+	blockArray = new Block[ blockArraySize ];
+
+	int blockIndex = 0;
+	int blockCoord[3];
+	for( blockCoord[0] = 0; blockCoord[0] < lattice.blockCount[0]; blockCoord[0]++ )
+	{
+		for( blockCoord[1] = 0; blockCoord[1] < lattice.blockCount[1]; blockCoord[1]++ )
+		{
+			for( blockCoord[2] = 0; blockCoord[2] < lattice.blockCount[2]; blockCoord[2]++ )
+			{
+				Block* block = &blockArray[ blockIndex++ ];
+				for( int axis = 0; axis < 3; axis++ )
+				{
+					block->cellOrigin[ axis ] = blockCoord[ axis ] * lattice.blockSize;
+					block->cellCount[ axis ] = lattice.cellCount[ axis ] - block->cellOrigin[ axis ];
+					if( block->cellCount[ axis ] > lattice.blockSize )
+						block->cellCount[ axis ] = lattice.blockSize;
+				}
+			}
+		}
+	}
+
+	ParallelInterface::Task** taskArray = new ParallelInterface::Task*[ blockArraySize ];
+
+	VertexTask* vertexTaskArray = new VertexTask[ blockArraySize ];
+	for( blockIndex = 0; blockIndex < blockArraySize; blockIndex++ )
+	{
+		VertexTask* vertexTask = &vertexTaskArray[ blockIndex ];
+		vertexTask->surface = &surface;
+		vertexTask->lattice = &lattice;
+		vertexTask->block = &blockArray[ blockIndex ];
+		taskArray[ blockIndex ] = vertexTask;
+	}
+
+	ParallelInterface::Execute( parallelInterface, taskArray, blockArraySize );
+	delete[] vertexTaskArray;
+
+	// Lay the vertices of the blocks out one after another so that faces can refer to them.
+	for( blockIndex = 0; blockIndex < blockArraySize; blockIndex++ )
+	{
+		Block* block = &blockArray[ blockIndex ];
+		block->vertexOffset = vertexCount;
+		vertexCount += block->vertexCount;
+	}
+
+	FaceTask* faceTaskArray = new FaceTask[ blockArraySize ];
+	for( blockIndex = 0; blockIndex < blockArraySize; blockIndex++ )
+	{
+		FaceTask* faceTask = &faceTaskArray[ blockIndex ];
+		faceTask->latticeMesh = this;
+		faceTask->block = &blockArray[ blockIndex ];
+		taskArray[ blockIndex ] = faceTask;
+	}
+
+	ParallelInterface::Execute( parallelInterface, taskArray, blockArraySize );
+	delete[] faceTaskArray;
+	delete[] taskArray;
+
+	// However the tasks were executed, the mesh is the same as if we had gone block by block.
+	for( blockIndex = 0; blockIndex < blockArraySize; blockIndex++ )
+		triangleCount += blockArray[ blockIndex ].triangleCount;
+
+	if( vertexCount > 0 )
+	{
+		vertexArray = new Vector[ vertexCount ];
+		normalArray = new Vector[ vertexCount ];
+	}
+
+	if( triangleCount > 0 )
+		indexArray = new int[ triangleCount * 3 ];
+
+	int triangleOffset = 0;
+	for( blockIndex = 0; blockIndex < blockArraySize; blockIndex++ )
+	{
+		Block* block = &blockArray[ blockIndex ];
+
+		for( int index = 0; index < block->vertexCount; index++ )
+		{
+			Copy( vertexArray[ block->vertexOffset + index ], block->vertexArray[ index ] );
+			Copy( normalArray[ block->vertexOffset + index ], block->normalArray[ index ] );
+		}
+
+		for( int index = 0; index < block->triangleCount * 3; index++ )
+			indexArray[ triangleOffset * 3 + index ] = block->indexArray[ index ];
+		triangleOffset += block->triangleCount;
+	}
+
+	// The blocks are only needed while generating.
+	delete[] blockArray;
+	blockArray = 0;
+	blockArraySize = 0;
+
+	return true;
+}
+
+// LatticeMesh.cpp
\ No newline at end of file
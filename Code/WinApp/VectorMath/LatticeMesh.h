@@ -0,0 +1,152 @@
+// LatticeMesh.h
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#pragma once
+
+#include "Surface.h"
+#include "IndexedMesh.h"
+#include "ParallelInterface.h"
+
+namespace VectorMath
+{
+	//=============================================================================
+	// This is the lattice approach suggested in the surface mesh header.  Space
+	// in the given box is cut into a lattice of cells, and every cell the surface
+	// passes through gets a vertex near the surface.  Every lattice edge the surface
+	// crosses is then surrounded by four such cells, whose vertices make a quad.
+	// This is the surface-nets flavor of dual contouring.  Unlike the advancing
+	// front, it can't fail to close up a surface, and it finds every component of
+	// the surface bigger than a cell without the need for seeds.
+	//
+	// The lattice is grouped into blocks of cells that are processed independently
+	// of one another.  A block that the surface doesn't pass through keeps nothing,
+	// so memory is only spent near the surface.
+	class LatticeMesh : public IndexedMesh
+	{
+	public:
+
+		LatticeMesh( void );
+		virtual ~LatticeMesh( void );
+
+		//=============================================================================
+		class GenerationParameters
+		{
+		public:
+
+			GenerationParameters( void );
+			virtual ~GenerationParameters( void );
+
+			// The lattice fills this box, and so the generated surface fits inside it.
+			Aabb aabb;
+
+			// This is roughly the width of a cell.  The cells are stretched a bit
+			// so that a whole number of them fit along each side of the box.
+			double cellSize;
+
+			// This is how many cells wide a block is.  It is the unit of work
+			// handed to the parallel interface.
+			int blockSize;
+		};
+
+		// Generate the mesh of the given surface, throwing out any previously generated mesh.
+		bool Generate( const Surface& surface, const GenerationParameters& genParms, ParallelInterface* parallelInterface = 0 );
+
+		virtual void WipeClean( void ) override;
+
+	private:
+
+		//=============================================================================
+		class Lattice
+		{
+		public:
+
+			// These are indexed by axis.
+			double origin[3];
+			double cellDelta[3];
+			int cellCount[3];
+			int blockSize;
+			int blockCount[3];
+		};
+
+		//=============================================================================
+		class Block
+		{
+		public:
+
+			Block( void );
+			virtual ~Block( void );
+
+			void WipeClean( void );
+
+			int LatticePointOffset( int i, int j, int k ) const;
+			int CellOffset( int i, int j, int k ) const;
+
+			// These are in cells, relative to the lattice.
+			int cellOrigin[3];
+			int cellCount[3];
+
+			// We keep the value of the surface at every lattice point of the block's cells,
+			// but only if the surface actually passes through the block.
+			double* valueArray;
+
+			// This maps each cell to the index of its vertex in the block, or -1 if it has none.
+			int* vertexIndexArray;
+
+			Vector* vertexArray;
+			Vector* normalArray;
+			int vertexCount;
+			int vertexOffset;
+
+			int* indexArray;
+			int triangleCount;
+		};
+
+		//=============================================================================
+		// Evaluate the surface at the lattice points of a block and place the vertices of its cells.
+		class VertexTask : public ParallelInterface::Task
+		{
+		public:
+
+			VertexTask( void );
+			virtual ~VertexTask( void );
+
+			virtual void Execute( void ) override;
+
+			const Surface* surface;
+			const Lattice* lattice;
+			Block* block;
+		};
+
+		//=============================================================================
+		// Make the quads around the lattice edges crossed by the surface in a block.
+		// These need the vertices of neighboring blocks, so they run after all vertex tasks.
+		class FaceTask : public ParallelInterface::Task
+		{
+		public:
+
+			FaceTask( void );
+			virtual ~FaceTask( void );
+
+			virtual void Execute( void ) override;
+
+			const LatticeMesh* latticeMesh;
+			Block* block;
+		};
+
+		int FindVertex( int i, int j, int k ) const;
+
+		Lattice lattice;
+		Block* blockArray;
+		int blockArraySize;
+	};
+}
+
+// LatticeMesh.h
\ No newline at end of file
@@ -0,0 +1,48 @@
+// ParallelInterface.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "ParallelInterface.h"
+
+using namespace VectorMath;
+
+//=============================================================================
+ParallelInterface::ParallelInterface( void )
+{
+}
+
+//=============================================================================
+/*virtual*/ ParallelInterface::~ParallelInterface( void )
+{
+}
+
+//=============================================================================
+ParallelInterface::Task::Task( void )
+{
+}
+
+//=============================================================================
+/*virtual*/ ParallelInterface::Task::~Task( void )
+{
+}
+
+//=============================================================================
+/*static*/ void ParallelInterface::Execute( ParallelInterface* parallelInterface, Task** taskArray, int taskCount )
+{
+	if( parallelInterface )
+		parallelInterface->ExecuteTasks( taskArray, taskCount );
+	else
+	{
+		for( int taskIndex = 0; taskIndex < taskCount; taskIndex++ )
+			taskArray[ taskIndex ]->Execute();
+	}
+}
+
+// ParallelInterface.cpp
\ No newline at end of file
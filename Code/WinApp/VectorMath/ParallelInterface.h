@@ -0,0 +1,51 @@
+// ParallelInterface.h
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#pragma once
+
+namespace VectorMath
+{
+	//=============================================================================
+	// Some algorithms in this vector math library break
+	// their work up into tasks that don't depend on one
+	// another.  This interface is how they get those tasks
+	// executed on however many threads the user has for
+	// them.  Without it, they just execute the tasks
+	// themselves, one after another.
+	class ParallelInterface
+	{
+	public:
+
+		ParallelInterface( void );
+		virtual ~ParallelInterface( void );
+
+		//=============================================================================
+		class Task
+		{
+		public:
+
+			Task( void );
+			virtual ~Task( void );
+
+			virtual void Execute( void ) = 0;
+		};
+
+		// This must not return until every given task has been executed,
+		// but they may be executed in any order and on any thread.
+		virtual void ExecuteTasks( Task** taskArray, int taskCount ) = 0;
+
+		// Algorithms given no parallel interface go through here too, in
+		// which case the tasks are executed in order on the calling thread.
+		static void Execute( ParallelInterface* parallelInterface, Task** taskArray, int taskCount );
+	};
+}
+
+// ParallelInterface.h
\ No newline at end of file
@@ -0,0 +1,273 @@
+// PointCloud.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "PointCloud.h"
+#include <math.h>
+
+using namespace VectorMath;
+
+//=============================================================================
+PointCloud::PointCloud( void )
+{
+	pointArray = 0;
+	normalArray = 0;
+	pointCount = 0;
+}
+
+//=============================================================================
+/*virtual*/ PointCloud::~PointCloud( void )
+{
+	WipeClean();
+}
+
+//=============================================================================
+void PointCloud::WipeClean( void )
+{
+	delete[] pointArray;
+	delete[] normalArray;
+	pointArray = 0;
+	normalArray = 0;
+	pointCount = 0;
+	convergenceStats = Surface::ConvergenceStats();
+}
+
+//=============================================================================
+int PointCloud::PointCount( void ) const
+{
+	return pointCount;
+}
+
+//=============================================================================
+const Vector* PointCloud::PointArray( void ) const
+{
+	return pointArray;
+}
+
+//=============================================================================
+const Vector* PointCloud::NormalArray( void ) const
+{
+	return normalArray;
+}
+
+//=============================================================================
+void PointCloud::GetConvergenceStats( Surface::ConvergenceStats& stats ) const
+{
+	stats = convergenceStats;
+}
+
+//=============================================================================
+PointCloud::GenerationParameters::GenerationParameters( void )
+{
+	MakeDefaultAabb( aabb );
+
+	strataCount = 32;
+	minimumDistance = 0.05;
+	randomSeed = 1;
+	useNewtonSteps = true;
+}
+
+//=============================================================================
+/*virtual*/ PointCloud::GenerationParameters::~GenerationParameters( void )
+{
+}
+
+//=============================================================================
+PointCloud::SampleTask::SampleTask( void )
+{
+	surface = 0;
+	genParms = 0;
+	layer = 0;
+	pointArray = 0;
+	normalArray = 0;
+	pointCount = 0;
+}
+
+//=============================================================================
+/*virtual*/ PointCloud::SampleTask::~SampleTask( void )
+{
+	delete[] pointArray;
+	delete[] normalArray;
+}
+
+//=============================================================================
+// Each layer has its own random numbers, so it doesn't matter which thread gets it.
+/*virtual*/ void PointCloud::SampleTask::Execute( void )
+{
+	int strataCount = genParms->strataCount;
+	int seedCount = strataCount * strataCount;
+	const Aabb& aabb = genParms->aabb;
+
+	Vector strataSize;
+	Sub( strataSize, aabb.max, aabb.min );
+	Scale( strataSize, strataSize, 1.0 / double( strataCount ) );
+
+	unsigned int state = genParms->randomSeed * 2654435761u + unsigned( layer + 1 ) * 40503u;
+
+	pointArray = new Vector[ seedCount ];
+	normalArray = new Vector[ seedCount ];
+	bool* converged = new bool[ seedCount ];
+
+	for( int j = 0; j < strataCount; j++ )
+	{
+		for( int i = 0; i < strataCount; i++ )
+		{
+			Vector* point = &pointArray[ j * strataCount + i ];
+			point->x = aabb.min.x + ( double( i ) + RandomNumber( state ) ) * strataSize.x;
+			point->y = aabb.min.y + ( double( j ) + RandomNumber( state ) ) * strataSize.y;
+			point->z = aabb.min.z + ( double( layer ) + RandomNumber( state ) ) * strataSize.z;
+		}
+	}
+
+	double epsilon = 1e-7;
+	surface->ConvergePointsToSurfaceInPlane( 0, pointArray, converged, seedCount, epsilon, genParms->useNewtonSteps, convergenceStats );
+
+	pointCount = 0;
+	for( int index = 0; index < seedCount; index++ )
+		if( converged[ index ] && Aabb::IS_OUTSIDE_BOX != AabbSide( aabb, pointArray[ index ] ) )
+			Copy( pointArray[ pointCount++ ], pointArray[ index ] );
+
+	// The normals are only for lighting, so where the gradient vanishes, any normal will do.
+	double* values = new double[ pointCount ];
+	surface->EvaluateBatch( pointArray, pointCount, values, normalArray );
+	for( int index = 0; index < pointCount; index++ )
+	{
+		Vector* normal = &normalArray[ index ];
+		if( Dot( *normal, *normal ) > 0.0 )
+			Normalize( *normal, *normal );
+		else
+			Set( *normal, 0.0, 0.0, 1.0 );
+	}
+
+	delete[] values;
+	delete[] converged;
+}
+
+//=============================================================================
+// This is a xorshift generator, giving a number in [0,1).
+/*static*/ double PointCloud::RandomNumber( unsigned int& state )
+{
+	if( state == 0 )
+		state = 1;
+
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return double( state ) / 4294967296.0;
+}
+
+//=============================================================================
+bool PointCloud::Generate( const Surface& surface, const GenerationParameters& genParms, ParallelInterface* parallelInterface /*= 0*/ )
+{
+	WipeClean();
+
+	if( !IsValidAabb( genParms.aabb ) || genParms.strataCount < 1 || genParms.minimumDistance < 0.0 )
+		return false;
+
+	int layerCount = genParms.strataCount;
+	SampleTask* sampleTaskArray = new SampleTask[ layerCount ];
+	ParallelInterface::Task** taskArray = new ParallelInterface::Task*[ layerCount ];
+
+	int layer;
+	for( layer = 0; layer < layerCount; layer++ )
+	{
+		SampleTask* sampleTask = &sampleTaskArray[ layer ];
+		sampleTask->surface = &surface;
+		sampleTask->genParms = &genParms;
+		sampleTask->layer = layer;
+		taskArray[ layer ] = sampleTask;
+	}
+
+	ParallelInterface::Execute( parallelInterface, taskArray, layerCount );
+
+	int totalCount = 0;
+	for( layer = 0; layer < layerCount; layer++ )
+		totalCount += sampleTaskArray[ layer ].pointCount;
+
+	pointArray = new Vector[ totalCount ];
+	normalArray = new Vector[ totalCount ];
+
+	// Gather the samples up in the order of the layers, so the result doesn't depend on the threads.
+	for( layer = 0; layer < layerCount; layer++ )
+	{
+		const SampleTask* sampleTask = &sampleTaskArray[ layer ];
+		for( int index = 0; index < sampleTask->pointCount; index++ )
+		{
+			Copy( pointArray[ pointCount ], sampleTask->pointArray[ index ] );
+			Copy( normalArray[ pointCount ], sampleTask->normalArray[ index ] );
+			pointCount++;
+		}
+
+		convergenceStats.Accumulate( sampleTask->convergenceStats );
+	}
+
+	delete[] sampleTaskArray;
+	delete[] taskArray;
+
+	if( genParms.minimumDistance > 0.0 )
+		RemoveCrowdedPoints( genParms.minimumDistance );
+
+	return true;
+}
+
+//=============================================================================
+// The samples kept so far are filed in a spatial hash whose cells are as wide as the
+// minimum distance, so any sample too close to a new one is in one of the 27 cells
+// around it.  The kept samples are packed down to the front of the arrays as we go.
+void PointCloud::RemoveCrowdedPoints( double minimumDistance )
+{
+	int bucketCount = 2 * pointCount + 1;
+	int* bucketArray = new int[ bucketCount ];
+	int* nextArray = new int[ pointCount ];
+	for( int bucket = 0; bucket < bucketCount; bucket++ )
+		bucketArray[ bucket ] = -1;
+
+	double squareDistance = minimumDistance * minimumDistance;
+	int keptCount = 0;
+
+	for( int index = 0; index < pointCount; index++ )
+	{
+		const Vector& point = pointArray[ index ];
+		int cell[3];
+		CalculateGridCell( point, minimumDistance, cell );
+
+		bool crowded = false;
+		for( int offset = 0; offset < 27 && !crowded; offset++ )
+		{
+			int neighborCell[3] = { cell[0] + offset % 3 - 1, cell[1] + ( offset / 3 ) % 3 - 1, cell[2] + offset / 9 - 1 };
+			int bucket = CalculateGridBucket( neighborCell, bucketCount );
+
+			// Different cells can share a bucket, but that only costs us a few extra distance checks.
+			for( int keptIndex = bucketArray[ bucket ]; keptIndex >= 0 && !crowded; keptIndex = nextArray[ keptIndex ] )
+			{
+				Vector delta;
+				Sub( delta, pointArray[ keptIndex ], point );
+				if( Dot( delta, delta ) < squareDistance )
+					crowded = true;
+			}
+		}
+
+		if( crowded )
+			continue;
+
+		Copy( pointArray[ keptCount ], point );
+		Copy( normalArray[ keptCount ], normalArray[ index ] );
+		int bucket = CalculateGridBucket( cell, bucketCount );
+		nextArray[ keptCount ] = bucketArray[ bucket ];
+		bucketArray[ bucket ] = keptCount++;
+	}
+
+	pointCount = keptCount;
+
+	delete[] bucketArray;
+	delete[] nextArray;
+}
+
+// PointCloud.cpp
\ No newline at end of file
@@ -0,0 +1,101 @@
+// PointCloud.h
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#pragma once
+
+#include "Surface.h"
+#include "ParallelInterface.h"
+
+namespace VectorMath
+{
+	//=============================================================================
+	// A point cloud is a dense sampling of a surface.  The box is cut into a lattice
+	// of strata, a seed is thrown at random into each one, and every seed is converged
+	// to the surface.  Each layer of strata is one task.  Seeds tend to converge to the
+	// same parts of the surface, so samples too close to one already kept are thrown out,
+	// which leaves the rest spread out more evenly than the seeds themselves.
+	class PointCloud
+	{
+	public:
+
+		PointCloud( void );
+		virtual ~PointCloud( void );
+
+		//=============================================================================
+		class GenerationParameters
+		{
+		public:
+
+			GenerationParameters( void );
+			virtual ~GenerationParameters( void );
+
+			// Seeds are thrown into this box, and only the samples that land in it are kept.
+			Aabb aabb;
+
+			// The box is cut into this many strata along each axis.
+			int strataCount;
+
+			// No two samples kept are closer together than this.
+			double minimumDistance;
+
+			// The same seed always gives the same cloud, no matter how many threads made it.
+			unsigned int randomSeed;
+
+			// This says whether the seeds are converged to the surface with Newton steps.
+			bool useNewtonSteps;
+		};
+
+		// Sample the given surface, throwing out any previous samples.
+		bool Generate( const Surface& surface, const GenerationParameters& genParms, ParallelInterface* parallelInterface = 0 );
+
+		// Copy out the work it took to converge the seeds during the last generation.
+		void GetConvergenceStats( Surface::ConvergenceStats& stats ) const;
+
+		void WipeClean( void );
+
+		int PointCount( void ) const;
+		const Vector* PointArray( void ) const;
+		const Vector* NormalArray( void ) const;
+
+	private:
+
+		//=============================================================================
+		class SampleTask : public ParallelInterface::Task
+		{
+		public:
+
+			SampleTask( void );
+			virtual ~SampleTask( void );
+
+			virtual void Execute( void ) override;
+
+			const Surface* surface;
+			const GenerationParameters* genParms;
+			int layer;
+			Vector* pointArray;
+			Vector* normalArray;
+			int pointCount;
+			Surface::ConvergenceStats convergenceStats;
+		};
+
+		static double RandomNumber( unsigned int& state );
+
+		void RemoveCrowdedPoints( double minimumDistance );
+
+		Vector* pointArray;
+		Vector* normalArray;
+		int pointCount;
+
+		Surface::ConvergenceStats convergenceStats;
+	};
+}
+
+// PointCloud.h
\ No newline at end of file
@@ -0,0 +1,886 @@
+// QuadricMesh.cpp
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#include "QuadricMesh.h"
+#include <math.h>
+
+using namespace VectorMath;
+
+//=============================================================================
+QuadricMesh::QuadricMesh( void )
+{
+	vertexCapacity = 0;
+	indexCapacity = 0;
+}
+
+//=============================================================================
+/*virtual*/ QuadricMesh::~QuadricMesh( void )
+{
+}
+
+//=============================================================================
+/*virtual*/ void QuadricMesh::WipeClean( void )
+{
+	IndexedMesh::WipeClean();
+
+	vertexCapacity = 0;
+	indexCapacity = 0;
+}
+
+//=============================================================================
+QuadricMesh::GenerationParameters::GenerationParameters( void )
+{
+	MakeDefaultAabb( aabb );
+
+	segmentCount = 48;
+}
+
+//=============================================================================
+/*virtual*/ QuadricMesh::GenerationParameters::~GenerationParameters( void )
+{
+}
+
+//=============================================================================
+/*static*/ const char* QuadricMesh::TypeName( Type type )
+{
+	switch( type )
+	{
+		case DEGENERATE_QUADRIC:			return "degenerate quadric";
+		case NO_REAL_POINTS:				return "quadric with no real points";
+		case ELLIPSOID:						return "ellipsoid";
+		case HYPERBOLOID_OF_ONE_SHEET:		return "hyperboloid of one sheet";
+		case HYPERBOLOID_OF_TWO_SHEETS:		return "hyperboloid of two sheets";
+		case ELLIPTIC_CONE:					return "elliptic cone";
+		case ELLIPTIC_PARABOLOID:			return "elliptic paraboloid";
+		case HYPERBOLIC_PARABOLOID:			return "hyperbolic paraboloid";
+		case ELLIPTIC_CYLINDER:				return "elliptic cylinder";
+		case HYPERBOLIC_CYLINDER:			return "hyperbolic cylinder";
+		case PARABOLIC_CYLINDER:			return "parabolic cylinder";
+		case INTERSECTING_PLANES:			return "pair of intersecting planes";
+		case PARALLEL_PLANES:				return "pair of parallel planes";
+		case SINGLE_PLANE:					return "plane";
+	}
+
+	return "?";
+}
+
+//=============================================================================
+// This is the cyclic Jacobi method.  Each rotation zeros one off-diagonal
+// entry, and a few sweeps over all of them leave the matrix diagonal.  The
+// eigenvectors are the columns of the accumulated rotation.
+static void DiagonalizeSymmetricMatrix( double matrix[3][3], double* eigenvalue, Vector* eigenvector )
+{
+	double rotation[3][3] = { { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 } };
+
+	for( int sweep = 0; sweep < 50; sweep++ )
+	{
+		if( matrix[0][1] == 0.0 && matrix[0][2] == 0.0 && matrix[1][2] == 0.0 )
+			break;
+
+		for( int p = 0; p < 2; p++ )
+		{
+			for( int q = p + 1; q < 3; q++ )
+			{
+				if( matrix[p][q] == 0.0 )
+					continue;
+
+				double theta = ( matrix[q][q] - matrix[p][p] ) / ( 2.0 * matrix[p][q] );
+				double tangent = 0.0;
+				if( fabs( theta ) > 1e150 )
+					tangent = 0.5 / theta;
+				else
+				{
+					tangent = 1.0 / ( fabs( theta ) + sqrt( theta * theta + 1.0 ) );
+					if( theta < 0.0 )
+						tangent = -tangent;
+				}
+
+				double cosine = 1.0 / sqrt( tangent * tangent + 1.0 );
+				double sine = tangent * cosine;
+
+				for( int k = 0; k < 3; k++ )
+				{
+					double kp = matrix[k][p];
+					double kq = matrix[k][q];
+					matrix[k][p] = cosine * kp - sine * kq;
+					matrix[k][q] = sine * kp + cosine * kq;
+				}
+
+				for( int k = 0; k < 3; k++ )
+				{
+					double pk = matrix[p][k];
+					double qk = matrix[q][k];
+					matrix[p][k] = cosine * pk - sine * qk;
+					matrix[q][k] = sine * pk + cosine * qk;
+				}
+
+				for( int k = 0; k < 3; k++ )
+				{
+					double kp = rotation[k][p];
+					double kq = rotation[k][q];
+					rotation[k][p] = cosine * kp - sine * kq;
+					rotation[k][q] = sine * kp + cosine * kq;
+				}
+
+				matrix[p][q] = 0.0;
+				matrix[q][p] = 0.0;
+			}
+		}
+	}
+
+	for( int index = 0; index < 3; index++ )
+	{
+		eigenvalue[ index ] = matrix[ index ][ index ];
+		Set( eigenvector[ index ], rotation[0][ index ], rotation[1][ index ], rotation[2][ index ] );
+	}
+}
+
+//=============================================================================
+static void MakeFrame( CoordFrame& frame, const Vector& xAxis, const Vector& yAxis, const Vector& zAxis )
+{
+	Copy( frame.xAxis, xAxis );
+	Copy( frame.yAxis, yAxis );
+	Copy( frame.zAxis, zAxis );
+}
+
+//=============================================================================
+// In the frame of the eigenvectors of its quadratic part, the quadric has no cross
+// terms.  Completing the square along each axis with a non-zero eigenvalue moves
+// the origin to the center of the quadric along that axis, after which we can read
+// off what it is.  The scale of a quadric's coefficients is arbitrary, so things are
+// considered zero relative to the size of whatever they were computed from.
+/*static*/ void QuadricMesh::Classify( const Quadric& quadric, Classification& classification )
+{
+	classification.type = DEGENERATE_QUADRIC;
+	Zero( classification.origin );
+	Identity( classification.frame );
+	classification.scale[0] = 1.0;
+	classification.scale[1] = 1.0;
+	classification.scale[2] = 1.0;
+
+	double tolerance = 1e-9;
+
+	double matrix[3][3] =
+	{
+		{ quadric.A, quadric.D / 2.0, quadric.E / 2.0 },
+		{ quadric.D / 2.0, quadric.B, quadric.F / 2.0 },
+		{ quadric.E / 2.0, quadric.F / 2.0, quadric.C },
+	};
+
+	double quadraticMagnitude = 0.0;
+	for( int row = 0; row < 3; row++ )
+		for( int column = 0; column < 3; column++ )
+			if( fabs( matrix[ row ][ column ] ) > quadraticMagnitude )
+				quadraticMagnitude = fabs( matrix[ row ][ column ] );
+
+	double eigenvalue[3];
+	Vector eigenvector[3];
+	DiagonalizeSymmetricMatrix( matrix, eigenvalue, eigenvector );
+
+	Vector linear;
+	Set( linear, quadric.G, quadric.H, quadric.I );
+	double linearMagnitude = Length( linear );
+
+	int nonZeroAxis[3], nonZeroCount = 0;
+	int zeroAxis[3], zeroCount = 0;
+	double linearPart[3];
+	double constant = quadric.J;
+	double constantMagnitude = fabs( quadric.J );
+	Vector origin;
+	Zero( origin );
+
+	for( int axis = 0; axis < 3; axis++ )
+	{
+		linearPart[ axis ] = Dot( eigenvector[ axis ], linear );
+		if( fabs( eigenvalue[ axis ] ) <= tolerance * quadraticMagnitude )
+			zeroAxis[ zeroCount++ ] = axis;
+		else
+		{
+			// Complete the square.
+			nonZeroAxis[ nonZeroCount++ ] = axis;
+			AddScale( origin, origin, eigenvector[ axis ], -linearPart[ axis ] / ( 2.0 * eigenvalue[ axis ] ) );
+			double squareConstant = linearPart[ axis ] * linearPart[ axis ] / ( 4.0 * eigenvalue[ axis ] );
+			constant -= squareConstant;
+			constantMagnitude += fabs( squareConstant );
+		}
+	}
+
+	// Now, with u along each axis from the origin, the quadric is sum( eigenvalue u^2 ) over
+	// the non-zero axes, plus sum( linearPart u ) over the zero axes, plus the constant.
+	bool constantIsZero = fabs( constant ) <= tolerance * constantMagnitude;
+	Copy( classification.origin, origin );
+
+	if( nonZeroCount == 3 )
+	{
+		if( constantIsZero )
+		{
+			// The odd axis out, in sign, is the axis of a cone, if there is an odd one out.
+			int positiveCount = 0;
+			for( int axis = 0; axis < 3; axis++ )
+				if( eigenvalue[ axis ] > 0.0 )
+					positiveCount++;
+			if( positiveCount == 0 || positiveCount == 3 )
+				return;
+
+			int coneAxis = 0;
+			for( int axis = 0; axis < 3; axis++ )
+				if( ( eigenvalue[ axis ] > 0.0 ) == ( positiveCount == 1 ) )
+					coneAxis = axis;
+
+			int uAxis = ( coneAxis + 1 ) % 3;
+			int vAxis = ( coneAxis + 2 ) % 3;
+			classification.type = ELLIPTIC_CONE;
+			MakeFrame( classification.frame, eigenvector[ uAxis ], eigenvector[ vAxis ], eigenvector[ coneAxis ] );
+			classification.scale[0] = 1.0 / sqrt( fabs( eigenvalue[ uAxis ] ) );
+			classification.scale[1] = 1.0 / sqrt( fabs( eigenvalue[ vAxis ] ) );
+			classification.scale[2] = 1.0 / sqrt( fabs( eigenvalue[ coneAxis ] ) );
+			return;
+		}
+
+		// Dividing through by minus the constant, the right-hand side becomes one.
+		double coefficient[3];
+		int positiveCount = 0;
+		for( int axis = 0; axis < 3; axis++ )
+		{
+			coefficient[ axis ] = -eigenvalue[ axis ] / constant;
+			if( coefficient[ axis ] > 0.0 )
+				positiveCount++;
+		}
+
+		if( positiveCount == 0 )
+		{
+			classification.type = NO_REAL_POINTS;
+			return;
+		}
+
+		// The axis of a hyperboloid is the one whose sign differs from the other two.
+		int wAxis = 2;
+		if( positiveCount == 1 || positiveCount == 2 )
+			for( int axis = 0; axis < 3; axis++ )
+				if( ( coefficient[ axis ] > 0.0 ) == ( positiveCount == 1 ) )
+					wAxis = axis;
+
+		int uAxis = ( wAxis + 1 ) % 3;
+		int vAxis = ( wAxis + 2 ) % 3;
+		if( positiveCount == 3 )
+			classification.type = ELLIPSOID;
+		else if( positiveCount == 2 )
+			classification.type = HYPERBOLOID_OF_ONE_SHEET;
+		else
+			classification.type = HYPERBOLOID_OF_TWO_SHEETS;
+		MakeFrame( classification.frame, eigenvector[ uAxis ], eigenvector[ vAxis ], eigenvector[ wAxis ] );
+		classification.scale[0] = 1.0 / sqrt( fabs( coefficient[ uAxis ] ) );
+		classification.scale[1] = 1.0 / sqrt( fabs( coefficient[ vAxis ] ) );
+		classification.scale[2] = 1.0 / sqrt( fabs( coefficient[ wAxis ] ) );
+		return;
+	}
+
+	if( nonZeroCount == 2 )
+	{
+		int uAxis = nonZeroAxis[0];
+		int vAxis = nonZeroAxis[1];
+		int wAxis = zeroAxis[0];
+
+		if( fabs( linearPart[ wAxis ] ) > tolerance * linearMagnitude )
+		{
+			// Moving the origin along the remaining linear term absorbs the constant.
+			AddScale( classification.origin, classification.origin, eigenvector[ wAxis ], -constant / linearPart[ wAxis ] );
+			classification.type = ( eigenvalue[ uAxis ] > 0.0 ) == ( eigenvalue[ vAxis ] > 0.0 ) ? ELLIPTIC_PARABOLOID : HYPERBOLIC_PARABOLOID;
+			MakeFrame( classification.frame, eigenvector[ uAxis ], eigenvector[ vAxis ], eigenvector[ wAxis ] );
+			classification.scale[0] = -eigenvalue[ uAxis ] / linearPart[ wAxis ];
+			classification.scale[1] = -eigenvalue[ vAxis ] / linearPart[ wAxis ];
+			return;
+		}
+
+		// What's left is a conic, extruded along the remaining axis.
+		if( constantIsZero )
+		{
+			if( ( eigenvalue[ uAxis ] > 0.0 ) == ( eigenvalue[ vAxis ] > 0.0 ) )
+				return;
+
+			if( eigenvalue[ uAxis ] < 0.0 )
+			{
+				uAxis = nonZeroAxis[1];
+				vAxis = nonZeroAxis[0];
+			}
+
+			classification.type = INTERSECTING_PLANES;
+			MakeFrame( classification.frame, eigenvector[ uAxis ], eigenvector[ vAxis ], eigenvector[ wAxis ] );
+			classification.scale[0] = 1.0 / sqrt( fabs( eigenvalue[ uAxis ] ) );
+			classification.scale[1] = 1.0 / sqrt( fabs( eigenvalue[ vAxis ] ) );
+			return;
+		}
+
+		double uCoefficient = -eigenvalue[ uAxis ] / constant;
+		double vCoefficient = -eigenvalue[ vAxis ] / constant;
+		if( uCoefficient < 0.0 && vCoefficient < 0.0 )
+		{
+			classification.type = NO_REAL_POINTS;
+			return;
+		}
+
+		if( uCoefficient < 0.0 )
+		{
+			uAxis = nonZeroAxis[1];
+			vAxis = nonZeroAxis[0];
+			double swap = uCoefficient;
+			uCoefficient = vCoefficient;
+			vCoefficient = swap;
+		}
+
+		classification.type = vCoefficient > 0.0 ? ELLIPTIC_CYLINDER : HYPERBOLIC_CYLINDER;
+		MakeFrame( classification.frame, eigenvector[ uAxis ], eigenvector[ vAxis ], eigenvector[ wAxis ] );
+		classification.scale[0] = 1.0 / sqrt( fabs( uCoefficient ) );
+		classification.scale[1] = 1.0 / sqrt( fabs( vCoefficient ) );
+		return;
+	}
+
+	if( nonZeroCount == 1 )
+	{
+		int uAxis = nonZeroAxis[0];
+
+		Vector residual;
+		Scale( residual, eigenvector[ zeroAxis[0] ], linearPart[ zeroAxis[0] ] );
+		AddScale( residual, residual, eigenvector[ zeroAxis[1] ], linearPart[ zeroAxis[1] ] );
+		double residualLength = Length( residual );
+
+		if( residualLength > tolerance * linearMagnitude )
+		{
+			// The linear terms combine into one along a single direction perpendicular to the parabola's axis.
+			Vector vAxis, wAxis;
+			Scale( vAxis, residual, 1.0 / residualLength );
+			Cross( wAxis, eigenvector[ uAxis ], vAxis );
+			AddScale( classification.origin, classification.origin, vAxis, -constant / residualLength );
+			classification.type = PARABOLIC_CYLINDER;
+			MakeFrame( classification.frame, eigenvector[ uAxis ], vAxis, wAxis );
+			classification.scale[0] = -eigenvalue[ uAxis ] / residualLength;
+			return;
+		}
+
+		MakeFrame( classification.frame, eigenvector[ uAxis ], eigenvector[ zeroAxis[0] ], eigenvector[ zeroAxis[1] ] );
+
+		if( constantIsZero )
+		{
+			classification.type = SINGLE_PLANE;
+			return;
+		}
+
+		double squareDistance = -constant / eigenvalue[ uAxis ];
+		if( squareDistance < 0.0 )
+		{
+			classification.type = NO_REAL_POINTS;
+			return;
+		}
+
+		classification.type = PARALLEL_PLANES;
+		classification.scale[0] = sqrt( squareDistance );
+		return;
+	}
+
+	// With no quadratic part, we're left with a plane, or nothing at all.
+	if( linearMagnitude > 0.0 )
+	{
+		Vector uAxis, vAxis, wAxis;
+		Scale( uAxis, linear, 1.0 / linearMagnitude );
+		Orthogonal( vAxis, uAxis );
+		Normalize( vAxis, vAxis );
+		Cross( wAxis, uAxis, vAxis );
+		Scale( classification.origin, uAxis, -quadric.J / linearMagnitude );
+		classification.type = SINGLE_PLANE;
+		MakeFrame( classification.frame, uAxis, vAxis, wAxis );
+	}
+	else if( quadric.J != 0.0 )
+		classification.type = NO_REAL_POINTS;
+}
+
+//=============================================================================
+/*static*/ void QuadricMesh::MapParameters( const Classification& classification, int sheet, double s, double t, Vector& point )
+{
+	double a = classification.scale[0];
+	double b = classification.scale[1];
+	double c = classification.scale[2];
+	double sign = sheet ? -1.0 : 1.0;
+
+	// The parameterizations that use sqrt( 1 + t^2 ) are the hyperbolic ones with t in place
+	// of sinh, so that the points are spread evenly along the axis rather than bunched up at the waist.
+	Vector canonicalPoint;
+	switch( classification.type )
+	{
+		case ELLIPSOID:					Set( canonicalPoint, a * cos( s ) * sin( t ), b * sin( s ) * sin( t ), c * cos( t ) ); break;
+		case HYPERBOLOID_OF_ONE_SHEET:	Set( canonicalPoint, a * sqrt( 1.0 + t * t ) * cos( s ), b * sqrt( 1.0 + t * t ) * sin( s ), c * t ); break;
+		case HYPERBOLOID_OF_TWO_SHEETS:	Set( canonicalPoint, a * t * cos( s ), b * t * sin( s ), sign * c * sqrt( 1.0 + t * t ) ); break;
+		case ELLIPTIC_CONE:				Set( canonicalPoint, a * t * cos( s ), b * t * sin( s ), c * t ); break;
+		case ELLIPTIC_PARABOLOID:
+		case HYPERBOLIC_PARABOLOID:		Set( canonicalPoint, s, t, a * s * s + b * t * t ); break;
+		case ELLIPTIC_CYLINDER:			Set( canonicalPoint, a * cos( s ), b * sin( s ), t ); break;
+		case HYPERBOLIC_CYLINDER:		Set( canonicalPoint, sign * a * sqrt( 1.0 + s * s ), b * s, t ); break;
+		case PARABOLIC_CYLINDER:		Set( canonicalPoint, s, a * s * s, t ); break;
+		case INTERSECTING_PLANES:		Set( canonicalPoint, s * a / sqrt( a * a + b * b ), sign * s * b / sqrt( a * a + b * b ), t ); break;
+		case PARALLEL_PLANES:			Set( canonicalPoint, sign * a, s, t ); break;
+		case SINGLE_PLANE:				Set( canonicalPoint, 0.0, s, t ); break;
+		default:						Zero( canonicalPoint ); break;
+	}
+
+	Transform( point, classification.frame, canonicalPoint );
+	Add( point, point, classification.origin );
+}
+
+//=============================================================================
+/*static*/ bool QuadricMesh::CalcSheetNormal( const Classification& classification, int sheet, Vector& normal )
+{
+	double a = classification.scale[0];
+	double b = classification.scale[1];
+	double sign = sheet ? -1.0 : 1.0;
+
+	Vector canonicalNormal;
+	switch( classification.type )
+	{
+		case INTERSECTING_PLANES:		Set( canonicalNormal, -sign * b / sqrt( a * a + b * b ), a / sqrt( a * a + b * b ), 0.0 ); break;
+		case PARALLEL_PLANES:			Set( canonicalNormal, sign, 0.0, 0.0 ); break;
+		case SINGLE_PLANE:				Set( canonicalNormal, 1.0, 0.0, 0.0 ); break;
+		default:						return false;
+	}
+
+	Transform( normal, classification.frame, canonicalNormal );
+	return true;
+}
+
+//=============================================================================
+static double ClampedMin( double value, double min )
+{
+	return value < min ? min : value;
+}
+
+//=============================================================================
+static double ClampedMax( double value, double max )
+{
+	return value > max ? max : value;
+}
+
+//=============================================================================
+// The parameter ranges are chosen so that each patch covers all of its part of the
+// surface inside the sphere about the box, and then the patches are clipped to the box.
+bool QuadricMesh::Generate( const Quadric& quadric, const Classification& classification, const GenerationParameters& genParms )
+{
+	WipeClean();
+
+	if( classification.type == DEGENERATE_QUADRIC || genParms.segmentCount < 1 )
+		return false;
+
+	Vector boxCenter, boxDelta;
+	CalcCenter( genParms.aabb, boxCenter );
+	Sub( boxDelta, genParms.aabb.max, genParms.aabb.min );
+	double radius = 0.5 * Length( boxDelta );
+
+	// This is the center of the box in the canonical coordinates of the quadric.
+	Vector offset;
+	Sub( offset, boxCenter, classification.origin );
+	double center[3];
+	center[0] = Dot( offset, classification.frame.xAxis );
+	center[1] = Dot( offset, classification.frame.yAxis );
+	center[2] = Dot( offset, classification.frame.zAxis );
+
+	const double* scale = classification.scale;
+	double extent = 0.0;
+
+	switch( classification.type )
+	{
+		case ELLIPSOID:
+		{
+			GeneratePatch( quadric, classification, genParms, 0, 0.0, 2.0 * PI, 0.0, PI );
+			break;
+		}
+		case HYPERBOLOID_OF_ONE_SHEET:
+		case ELLIPTIC_CONE:
+		{
+			extent = ( fabs( center[2] ) + radius ) / scale[2];
+			GeneratePatch( quadric, classification, genParms, 0, 0.0, 2.0 * PI, -extent, extent );
+			break;
+		}
+		case HYPERBOLOID_OF_TWO_SHEETS:
+		{
+			extent = ( sqrt( center[0] * center[0] + center[1] * center[1] ) + radius ) / ( scale[0] < scale[1] ? scale[0] : scale[1] );
+			for( int sheet = 0; sheet < 2; sheet++ )
+				GeneratePatch( quadric, classification, genParms, sheet, 0.0, 2.0 * PI, 0.0, extent );
+			break;
+		}
+		case ELLIPTIC_PARABOLOID:
+		{
+			// Neither term can be bigger than w, which keeps us from wasting most of the patch outside the box.
+			double uExtent = sqrt( ( fabs( center[2] ) + radius ) / fabs( scale[0] ) );
+			double vExtent = sqrt( ( fabs( center[2] ) + radius ) / fabs( scale[1] ) );
+			GeneratePatch( quadric, classification, genParms, 0,
+								ClampedMin( center[0] - radius, -uExtent ), ClampedMax( center[0] + radius, uExtent ),
+								ClampedMin( center[1] - radius, -vExtent ), ClampedMax( center[1] + radius, vExtent ) );
+			break;
+		}
+		case HYPERBOLIC_PARABOLOID:
+		{
+			GeneratePatch( quadric, classification, genParms, 0, center[0] - radius, center[0] + radius, center[1] - radius, center[1] + radius );
+			break;
+		}
+		case ELLIPTIC_CYLINDER:
+		{
+			GeneratePatch( quadric, classification, genParms, 0, 0.0, 2.0 * PI, center[2] - radius, center[2] + radius );
+			break;
+		}
+		case HYPERBOLIC_CYLINDER:
+		{
+			extent = ( fabs( center[1] ) + radius ) / scale[1];
+			for( int sheet = 0; sheet < 2; sheet++ )
+				GeneratePatch( quadric, classification, genParms, sheet, -extent, extent, center[2] - radius, center[2] + radius );
+			break;
+		}
+		case PARABOLIC_CYLINDER:
+		{
+			double uExtent = sqrt( ( fabs( center[1] ) + radius ) / fabs( scale[0] ) );
+			GeneratePatch( quadric, classification, genParms, 0,
+								ClampedMin( center[0] - radius, -uExtent ), ClampedMax( center[0] + radius, uExtent ),
+								center[2] - radius, center[2] + radius );
+			break;
+		}
+		case INTERSECTING_PLANES:
+		{
+			// Each plane is parameterized by distance along the line in which it meets the uv-plane.
+			double length = sqrt( scale[0] * scale[0] + scale[1] * scale[1] );
+			for( int sheet = 0; sheet < 2; sheet++ )
+			{
+				double sign = sheet ? -1.0 : 1.0;
+				double along = ( center[0] * scale[0] + sign * center[1] * scale[1] ) / length;
+				GeneratePatch( quadric, classification, genParms, sheet, along - radius, along + radius, center[2] - radius, center[2] + radius );
+			}
+			break;
+		}
+		case PARALLEL_PLANES:
+		{
+			for( int sheet = 0; sheet < 2; sheet++ )
+				GeneratePatch( quadric, classification, genParms, sheet, center[1] - radius, center[1] + radius, center[2] - radius, center[2] + radius );
+			break;
+		}
+		case SINGLE_PLANE:
+		{
+			GeneratePatch( quadric, classification, genParms, 0, center[1] - radius, center[1] + radius, center[2] - radius, center[2] + radius );
+			break;
+		}
+		default:
+		{
+			// There's nothing to see here.
+			break;
+		}
+	}
+
+	RemoveUnusedVertices();
+
+	return true;
+}
+
+//=============================================================================
+// The normals are the gradients of the quadric, which give the triangles their facing.
+// Where the gradient vanishes, at the apex of a cone, for example, the normal is instead
+// the average of the normals of the triangles around the vertex.
+void QuadricMesh::GeneratePatch( const Quadric& quadric, const Classification& classification, const GenerationParameters& genParms, int sheet, double sMin, double sMax, double tMin, double tMax )
+{
+	int segmentCount = genParms.segmentCount;
+	int rowSize = segmentCount + 1;
+	int patchVertexCount = rowSize * rowSize;
+	int firstVertex = vertexCount;
+
+	double* gradientLength = new double[ patchVertexCount ];
+	double maxGradientLength = 0.0;
+
+	// The gradient changes direction across the line where two planes meet, so
+	// the normal of each plane is taken from the plane itself.
+	Vector sheetNormal;
+	bool flatSheet = CalcSheetNormal( classification, sheet, sheetNormal );
+
+	for( int j = 0; j <= segmentCount; j++ )
+	{
+		double t = tMin + ( tMax - tMin ) * double( j ) / double( segmentCount );
+		for( int i = 0; i <= segmentCount; i++ )
+		{
+			double s = sMin + ( sMax - sMin ) * double( i ) / double( segmentCount );
+
+			Vector point, gradient;
+			MapParameters( classification, sheet, s, t, point );
+			if( flatSheet )
+				Copy( gradient, sheetNormal );
+			else
+				quadric.EvaluateGradientAt( point, gradient );
+
+			int index = j * rowSize + i;
+			gradientLength[ index ] = Length( gradient );
+			if( gradientLength[ index ] > maxGradientLength )
+				maxGradientLength = gradientLength[ index ];
+
+			AddVertex( point, gradient );
+		}
+	}
+
+	double gradientTolerance = 1e-6 * maxGradientLength;
+	for( int index = 0; index < patchVertexCount; index++ )
+	{
+		Vector* normal = &normalArray[ firstVertex + index ];
+		if( gradientLength[ index ] > gradientTolerance )
+			Scale( *normal, *normal, 1.0 / gradientLength[ index ] );
+		else
+			Zero( *normal );
+	}
+
+	int* patchIndexArray = new int[ segmentCount * segmentCount * 6 ];
+	int patchTriangleCount = 0;
+
+	for( int j = 0; j < segmentCount; j++ )
+	{
+		for( int i = 0; i < segmentCount; i++ )
+		{
+			int corner00 = firstVertex + j * rowSize + i;
+			int corner10 = corner00 + 1;
+			int corner01 = corner00 + rowSize;
+			int corner11 = corner01 + 1;
+			int quadIndex[6] = { corner00, corner10, corner11, corner00, corner11, corner01 };
+
+			for( int half = 0; half < 2; half++ )
+			{
+				int* index = &patchIndexArray[ patchTriangleCount * 3 ];
+				index[0] = quadIndex[ half * 3 + 0 ];
+				index[1] = quadIndex[ half * 3 + 1 ];
+				index[2] = quadIndex[ half * 3 + 2 ];
+
+				// Triangles collapse to nothing at the poles of the parameterizations.
+				Triangle triangle;
+				MakeTriangle( triangle, vertexArray[ index[0] ], vertexArray[ index[1] ], vertexArray[ index[2] ] );
+				Vector faceNormal;
+				CalcNormal( triangle, faceNormal );
+				if( Dot( faceNormal, faceNormal ) == 0.0 )
+					continue;
+
+				Vector normalSum;
+				Add( normalSum, normalArray[ index[0] ], normalArray[ index[1] ] );
+				Add( normalSum, normalSum, normalArray[ index[2] ] );
+				if( Dot( faceNormal, normalSum ) < 0.0 )
+				{
+					int swap = index[1];
+					index[1] = index[2];
+					index[2] = swap;
+				}
+
+				patchTriangleCount++;
+			}
+		}
+	}
+
+	for( int triangleIndex = 0; triangleIndex < patchTriangleCount; triangleIndex++ )
+	{
+		const int* index = &patchIndexArray[ triangleIndex * 3 ];
+		Triangle triangle;
+		MakeTriangle( triangle, vertexArray[ index[0] ], vertexArray[ index[1] ], vertexArray[ index[2] ] );
+		Vector faceNormal;
+		CalcNormal( triangle, faceNormal, true );
+
+		for( int corner = 0; corner < 3; corner++ )
+			if( gradientLength[ index[ corner ] - firstVertex ] <= gradientTolerance )
+				Add( normalArray[ index[ corner ] ], normalArray[ index[ corner ] ], faceNormal );
+	}
+
+	for( int index = 0; index < patchVertexCount; index++ )
+	{
+		Vector* normal = &normalArray[ firstVertex + index ];
+		if( gradientLength[ index ] <= gradientTolerance && Dot( *normal, *normal ) > 0.0 )
+			Normalize( *normal, *normal );
+	}
+
+	// Triangles in the box are kept as they are, and the rest are clipped to it.
+	for( int triangleIndex = 0; triangleIndex < patchTriangleCount; triangleIndex++ )
+	{
+		const int* index = &patchIndexArray[ triangleIndex * 3 ];
+
+		int outsideCount = 0;
+		for( int corner = 0; corner < 3; corner++ )
+			if( Aabb::IS_OUTSIDE_BOX == AabbSide( genParms.aabb, vertexArray[ index[ corner ] ] ) )
+				outsideCount++;
+
+		if( outsideCount == 0 )
+			AddTriangle( index[0], index[1], index[2] );
+		else
+		{
+			Triangle triangle;
+			TriangleNormals triangleNormals;
+			MakeTriangle( triangle, vertexArray[ index[0] ], vertexArray[ index[1] ], vertexArray[ index[2] ] );
+			MakeTriangleNormals( triangleNormals, normalArray[ index[0] ], normalArray[ index[1] ], normalArray[ index[2] ] );
+			ClipTriangle( triangle, triangleNormals, genParms.aabb );
+		}
+	}
+
+	delete[] patchIndexArray;
+	delete[] gradientLength;
+}
+
+//=============================================================================
+// The triangle is split against each side of the box in turn, keeping what's inside.
+// A piece is never split into more than two pieces inside a side, so six sides make
+// no more than 64 pieces.
+void QuadricMesh::ClipTriangle( const Triangle& triangle, const TriangleNormals& triangleNormals, const Aabb& aabb )
+{
+	Triangle pieceArray[2][ MAX_CLIP_PIECES ];
+	TriangleNormals pieceNormalsArray[2][ MAX_CLIP_PIECES ];
+	int pieceCount[2] = { 1, 0 };
+	int current = 0;
+
+	CopyTriangle( pieceArray[0][0], triangle );
+	CopyTriangleNormals( pieceNormalsArray[0][0], triangleNormals );
+
+	for( int side = 0; side < 6 && pieceCount[ current ] > 0; side++ )
+	{
+		// The normal of each side's plane points out of the box.
+		Vector normal;
+		Zero( normal );
+		double sign = ( side & 1 ) ? -1.0 : 1.0;
+		switch( side / 2 )
+		{
+			case 0: normal.x = sign; break;
+			case 1: normal.y = sign; break;
+			case 2: normal.z = sign; break;
+		}
+
+		Plane plane;
+		MakePlane( plane, ( side & 1 ) ? aabb.min : aabb.max, normal );
+
+		int next = 1 - current;
+		pieceCount[ next ] = 0;
+
+		for( int pieceIndex = 0; pieceIndex < pieceCount[ current ]; pieceIndex++ )
+		{
+			const Triangle& piece = pieceArray[ current ][ pieceIndex ];
+			const TriangleNormals& pieceNormals = pieceNormalsArray[ current ][ pieceIndex ];
+
+			SideCountData sideCountData;
+			SideCount( piece, plane, sideCountData, 1e-7 );
+
+			if( sideCountData.countOnFront == 0 )
+			{
+				CopyTriangle( pieceArray[ next ][ pieceCount[ next ] ], piece );
+				CopyTriangleNormals( pieceNormalsArray[ next ][ pieceCount[ next ]++ ], pieceNormals );
+				continue;
+			}
+
+			if( sideCountData.countOnBack == 0 )
+				continue;
+
+			Triangle splitArray[3];
+			TriangleNormals splitNormalsArray[3];
+			Plane::Side sideArray[3];
+			int splitCount = 0;
+			if( !SplitTriangle( piece, &pieceNormals, plane, sideCountData, splitArray, splitNormalsArray, sideArray, splitCount ) )
+				continue;
+
+			for( int splitIndex = 0; splitIndex < splitCount; splitIndex++ )
+			{
+				if( sideArray[ splitIndex ] != Plane::SIDE_BACK || pieceCount[ next ] == MAX_CLIP_PIECES )
+					continue;
+
+				CopyTriangle( pieceArray[ next ][ pieceCount[ next ] ], splitArray[ splitIndex ] );
+				CopyTriangleNormals( pieceNormalsArray[ next ][ pieceCount[ next ]++ ], splitNormalsArray[ splitIndex ] );
+			}
+		}
+
+		current = next;
+	}
+
+	for( int pieceIndex = 0; pieceIndex < pieceCount[ current ]; pieceIndex++ )
+	{
+		const Triangle& piece = pieceArray[ current ][ pieceIndex ];
+		const TriangleNormals& pieceNormals = pieceNormalsArray[ current ][ pieceIndex ];
+
+		int index0 = AddVertex( piece.vertex[0], pieceNormals.normal[0] );
+		int index1 = AddVertex( piece.vertex[1], pieceNormals.normal[1] );
+		int index2 = AddVertex( piece.vertex[2], pieceNormals.normal[2] );
+		AddTriangle( index0, index1, index2 );
+	}
+}
+
+//=============================================================================
+// Patches run well outside the box, so many of their vertices end up in no triangle.
+void QuadricMesh::RemoveUnusedVertices( void )
+{
+	int* remapArray = new int[ vertexCount ];
+	for( int index = 0; index < vertexCount; index++ )
+		remapArray[ index ] = -1;
+
+	for( int index = 0; index < triangleCount * 3; index++ )
+		remapArray[ indexArray[ index ] ] = 0;
+
+	int usedCount = 0;
+	for( int index = 0; index < vertexCount; index++ )
+	{
+		if( remapArray[ index ] < 0 )
+			continue;
+
+		Copy( vertexArray[ usedCount ], vertexArray[ index ] );
+		Copy( normalArray[ usedCount ], normalArray[ index ] );
+		remapArray[ index ] = usedCount++;
+	}
+
+	for( int index = 0; index < triangleCount * 3; index++ )
+		indexArray[ index ] = remapArray[ indexArray[ index ] ];
+
+	vertexCount = usedCount;
+	delete[] remapArray;
+}
+
+//=============================================================================
+int QuadricMesh::AddVertex( const Vector& vertex, const Vector& normal )
+{
+	if( vertexCount == vertexCapacity )
+	{
+		vertexCapacity = vertexCapacity > 0 ? vertexCapacity * 2 : 1024;
+
+		Vector* newVertexArray = new Vector[ vertexCapacity ];
+		Vector* newNormalArray = new Vector[ vertexCapacity ];
+		for( int index = 0; index < vertexCount; index++ )
+		{
+			Copy( newVertexArray[ index ], vertexArray[ index ] );
+			Copy( newNormalArray[ index ], normalArray[ index ] );
+		}
+
+		delete[] vertexArray;
+		delete[] normalArray;
+		vertexArray = newVertexArray;
+		normalArray = newNormalArray;
+	}
+
+	Copy( vertexArray[ vertexCount ], vertex );
+	Copy( normalArray[ vertexCount ], normal );
+	return vertexCount++;
+}
+
+//=============================================================================
+void QuadricMesh::AddTriangle( int index0, int index1, int index2 )
+{
+	if( triangleCount * 3 == indexCapacity )
+	{
+		indexCapacity = indexCapacity > 0 ? indexCapacity * 2 : 3072;
+
+		int* newIndexArray = new int[ indexCapacity ];
+		for( int index = 0; index < triangleCount * 3; index++ )
+			newIndexArray[ index ] = indexArray[ index ];
+
+		delete[] indexArray;
+		indexArray = newIndexArray;
+	}
+
+	int* index = &indexArray[ triangleCount * 3 ];
+	index[0] = index0;
+	index[1] = index1;
+	index[2] = index2;
+	triangleCount++;
+}
+
+// QuadricMesh.cpp
\ No newline at end of file
@@ -0,0 +1,104 @@
+// QuadricMesh.h
+
+/*
+ * Copyright (C) 2013-2014 Spencer T. Parkin
+ *
+ * This software has been released under the MIT License.
+ * See the "License.txt" file in the project root directory
+ * for more information about this license.
+ *
+ */
+
+#pragma once
+
+#include "IndexedMesh.h"
+
+namespace VectorMath
+{
+	//=============================================================================
+	// Every quadric is, after a rotation and translation, one of a handful of
+	// canonical surfaces, each of which has a simple parameterization.  So instead
+	// of searching for a quadric's surface, we can classify it and then tessellate
+	// its canonical form directly.
+	class QuadricMesh : public IndexedMesh
+	{
+	public:
+
+		QuadricMesh( void );
+		virtual ~QuadricMesh( void );
+
+		// In the canonical form of each of these, u, v and w are the coordinates
+		// along the axes of the classification's frame, from its origin, and a, b
+		// and c are its three scales.
+		enum Type
+		{
+			DEGENERATE_QUADRIC,				// A point, a line, or all of space.
+			NO_REAL_POINTS,					// u^2/a^2 + v^2/b^2 + w^2/c^2 = -1, for example.
+			ELLIPSOID,						// u^2/a^2 + v^2/b^2 + w^2/c^2 = 1
+			HYPERBOLOID_OF_ONE_SHEET,		// u^2/a^2 + v^2/b^2 - w^2/c^2 = 1
+			HYPERBOLOID_OF_TWO_SHEETS,		// -u^2/a^2 - v^2/b^2 + w^2/c^2 = 1
+			ELLIPTIC_CONE,					// u^2/a^2 + v^2/b^2 - w^2/c^2 = 0
+			ELLIPTIC_PARABOLOID,			// w = a u^2 + b v^2, where a and b have the same sign.
+			HYPERBOLIC_PARABOLOID,			// w = a u^2 + b v^2, where a and b have opposite signs.
+			ELLIPTIC_CYLINDER,				// u^2/a^2 + v^2/b^2 = 1
+			HYPERBOLIC_CYLINDER,			// u^2/a^2 - v^2/b^2 = 1
+			PARABOLIC_CYLINDER,				// v = a u^2
+			INTERSECTING_PLANES,			// u^2/a^2 - v^2/b^2 = 0
+			PARALLEL_PLANES,				// u^2 = a^2
+			SINGLE_PLANE,					// u = 0
+		};
+
+		//=============================================================================
+		class Classification
+		{
+		public:
+
+			Type type;
+			Vector origin;
+			CoordFrame frame;
+			double scale[3];
+		};
+
+		//=============================================================================
+		class GenerationParameters
+		{
+		public:
+
+			GenerationParameters( void );
+			virtual ~GenerationParameters( void );
+
+			// The mesh is clipped to this box.
+			Aabb aabb;
+
+			// Each parametric patch is cut into this many pieces along each of its parameters.
+			int segmentCount;
+		};
+
+		static void Classify( const Quadric& quadric, Classification& classification );
+		static const char* TypeName( Type type );
+
+		// Generate the mesh of the given quadric, throwing out any previously generated mesh.
+		// Degenerate quadrics have no parameterization, and for them we fail.
+		bool Generate( const Quadric& quadric, const Classification& classification, const GenerationParameters& genParms );
+
+		virtual void WipeClean( void ) override;
+
+	private:
+
+		enum { MAX_CLIP_PIECES = 64 };
+
+		void GeneratePatch( const Quadric& quadric, const Classification& classification, const GenerationParameters& genParms, int sheet, double sMin, double sMax, double tMin, double tMax );
+		static void MapParameters( const Classification& classification, int sheet, double s, double t, Vector& point );
+		static bool CalcSheetNormal( const Classification& classification, int sheet, Vector& normal );
+		void RemoveUnusedVertices( void );
+		void ClipTriangle( const Triangle& triangle, const TriangleNormals& triangleNormals, const Aabb& aabb );
+
+		int AddVertex( const Vector& vertex, const Vector& normal );
+		void AddTriangle( int index0, int index1, int index2 );
+
+		int vertexCapacity;
+		int indexCapacity;
+	};
+}
+
+// QuadricMesh.h
\ No newline at end of file
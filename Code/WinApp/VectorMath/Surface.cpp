@@ -39,48 +39,194 @@ VectorMath::Surface::Point::Point( const VectorMath::Vector& point )
 VectorMath::Surface::Trace::Trace( void )
 {
 	looped = false;
+	gridBucketArray = 0;
 }
 
 //=============================================================================
 /*virtual*/ VectorMath::Surface::Trace::~Trace( void )
 {
 	pointList.RemoveAll( true );
+
+	if( gridBucketArray )
+	{
+		for( int bucket = 0; bucket < GRID_BUCKET_COUNT; bucket++ )
+		{
+			GridEntry* nextEntry = 0;
+			for( GridEntry* entry = gridBucketArray[ bucket ]; entry; entry = nextEntry )
+			{
+				nextEntry = entry->next;
+				delete entry;
+			}
+		}
+
+		delete[] gridBucketArray;
+	}
 }
 
 //=============================================================================
-bool VectorMath::Surface::Trace::IsPointOnTrace( const Vector& givenPoint, double epsilon ) const
+// Tracing steps are a fraction of this, so a feature rarely touches more than a few cells,
+// and queries, whose epsilons are much smaller still, rarely look at more than one.
+static const double traceGridCellSize = 0.5;
+
+//=============================================================================
+void VectorMath::Surface::Trace::AppendPoint( const Vector& point )
+{
+	Point* newPoint = new Point( point );
+	pointList.InsertRightOf( pointList.RightMost(), newPoint );
+
+	// The new point completes a segment and a curve ending at it.
+	FileFeature( newPoint, 1 );
+	const Point* previousPoint = ( const Point* )newPoint->Left();
+	if( previousPoint )
+	{
+		FileFeature( previousPoint, 2 );
+		if( previousPoint->Left() )
+			FileFeature( ( const Point* )previousPoint->Left(), 3 );
+	}
+}
+
+//=============================================================================
+void VectorMath::Surface::Trace::PrependPoint( const Vector& point )
 {
-	for( const Point* point = ( const Point* )pointList.LeftMost(); point; point = ( const Point* )point->Right() )
+	Point* newPoint = new Point( point );
+	pointList.InsertLeftOf( pointList.LeftMost(), newPoint );
+
+	// The new point starts a segment and a curve.
+	FileFeature( newPoint, 1 );
+	const Point* nextPoint = ( const Point* )newPoint->Right();
+	if( nextPoint )
+	{
+		FileFeature( newPoint, 2 );
+		if( nextPoint->Right() )
+			FileFeature( newPoint, 3 );
+	}
+}
+
+//=============================================================================
+void VectorMath::Surface::Trace::FileFeature( const Point* point, int pointCount )
+{
+	if( !gridBucketArray )
+	{
+		gridBucketArray = new GridEntry*[ GRID_BUCKET_COUNT ];
+		for( int bucket = 0; bucket < GRID_BUCKET_COUNT; bucket++ )
+			gridBucketArray[ bucket ] = 0;
+	}
+
+	// The curve through three points is a quadratic Bezier curve whose middle control point
+	// is 2p1 - (p0 + p2)/2.  It stays inside the hull of its control points, so we box those.
+	Vector boxPoint[4];
+	int boxPointCount = 0;
+	const Point* featurePoint = point;
+	for( int index = 0; index < pointCount; index++ )
+	{
+		Copy( boxPoint[ boxPointCount++ ], featurePoint->point );
+		featurePoint = ( const Point* )featurePoint->Right();
+	}
+	if( pointCount == 3 )
+		LinearCombo( boxPoint[ boxPointCount++ ], 2.0, boxPoint[1], -0.5, boxPoint[0], -0.5, boxPoint[2] );
+
+	int minCell[3], maxCell[3];
+	CalculateGridCell( boxPoint[0], traceGridCellSize, minCell );
+	CalculateGridCell( boxPoint[0], traceGridCellSize, maxCell );
+	for( int index = 1; index < boxPointCount; index++ )
+	{
+		int cell[3];
+		CalculateGridCell( boxPoint[ index ], traceGridCellSize, cell );
+		for( int axis = 0; axis < 3; axis++ )
+		{
+			if( cell[ axis ] < minCell[ axis ] )
+				minCell[ axis ] = cell[ axis ];
+			if( cell[ axis ] > maxCell[ axis ] )
+				maxCell[ axis ] = cell[ axis ];
+		}
+	}
+
+	int cell[3];
+	for( cell[0] = minCell[0]; cell[0] <= maxCell[0]; cell[0]++ )
+	{
+		for( cell[1] = minCell[1]; cell[1] <= maxCell[1]; cell[1]++ )
+		{
+			for( cell[2] = minCell[2]; cell[2] <= maxCell[2]; cell[2]++ )
+			{
+				GridEntry* entry = new GridEntry();
+				entry->cell[0] = cell[0];
+				entry->cell[1] = cell[1];
+				entry->cell[2] = cell[2];
+				entry->point = point;
+				entry->pointCount = pointCount;
+
+				int bucket = CalculateGridBucket( cell, GRID_BUCKET_COUNT );
+				entry->next = gridBucketArray[ bucket ];
+				gridBucketArray[ bucket ] = entry;
+			}
+		}
+	}
+}
+
+//=============================================================================
+bool VectorMath::Surface::Trace::IsPointNearFeature( const Vector& givenPoint, double epsilon, const Point* point, int pointCount ) const
+{
+	// Is the given point within the given distance of this point?
+	if( pointCount == 1 )
 	{
-		// Is the given point within the given distance of this point?
 		Vector delta;
 		Sub( delta, point->point, givenPoint );
 		double dist = Length( delta );
-		if( dist <= epsilon )
-			return true;
+		return dist <= epsilon;
+	}
+
+	// Is the given point within the given distance of the line-segment between this point and the next point?
+	const Point* nextPoint = ( const Point* )point->Right();
+	if( pointCount == 2 )
+	{
+		LinearSpline linearSpline;
+		Copy( linearSpline.controlPoint[0], point->point );
+		Copy( linearSpline.controlPoint[1], nextPoint->point );
+		double dist = linearSpline.ShortestDistanceToSpline( givenPoint );
+		return dist != -1.0 && dist <= epsilon;
+	}
+
+	// How about testing the point against a curve going through this and the next two points?
+	const Point* nextNextPoint = ( const Point* )nextPoint->Right();
+	QuadraticSpline quadraticSpline;
+	Copy( quadraticSpline.controlPoint[0], point->point );
+	Copy( quadraticSpline.controlPoint[1], nextPoint->point );
+	Copy( quadraticSpline.controlPoint[2], nextNextPoint->point );
+	double dist = quadraticSpline.ShortestDistanceToSpline( givenPoint );
+	return dist != -1.0 && dist <= epsilon;
+}
 
-		// Is the given point within the given distance of the line-segment between this point and the next point?
-		const Point* nextPoint = ( const Point* )point->Right();
-		if( nextPoint )
+//=============================================================================
+// Anything within the given distance of the given point is filed under a cell that the
+// box of that size about the point touches, so those are the only cells we need to search.
+bool VectorMath::Surface::Trace::IsPointOnTrace( const Vector& givenPoint, double epsilon ) const
+{
+	if( !gridBucketArray )
+		return false;
+
+	Vector delta, corner;
+	Set( delta, epsilon, epsilon, epsilon );
+	int minCell[3], maxCell[3];
+	Sub( corner, givenPoint, delta );
+	CalculateGridCell( corner, traceGridCellSize, minCell );
+	Add( corner, givenPoint, delta );
+	CalculateGridCell( corner, traceGridCellSize, maxCell );
+
+	int cell[3];
+	for( cell[0] = minCell[0]; cell[0] <= maxCell[0]; cell[0]++ )
+	{
+		for( cell[1] = minCell[1]; cell[1] <= maxCell[1]; cell[1]++ )
 		{
-			LinearSpline linearSpline;
-			Copy( linearSpline.controlPoint[0], point->point );
-			Copy( linearSpline.controlPoint[1], nextPoint->point );
-			dist = linearSpline.ShortestDistanceToSpline( givenPoint );
-			if( dist != -1.0 && dist <= epsilon )
-				return true;
-
-			// How about testing the point against a curve going through this and the next two points?
-			const Point* nextNextPoint = ( const Point* )nextPoint->Right();
-			if( nextNextPoint )
+			for( cell[2] = minCell[2]; cell[2] <= maxCell[2]; cell[2]++ )
 			{
-				QuadraticSpline quadraticSpline;
-				Copy( quadraticSpline.controlPoint[0], point->point );
-				Copy( quadraticSpline.controlPoint[1], nextPoint->point );
-				Copy( quadraticSpline.controlPoint[2], nextNextPoint->point );
-				dist = quadraticSpline.ShortestDistanceToSpline( givenPoint );
-				if( dist != -1.0 && dist <= epsilon )
-					return true;
+				for( const GridEntry* entry = gridBucketArray[ CalculateGridBucket( cell, GRID_BUCKET_COUNT ) ]; entry; entry = entry->next )
+				{
+					if( entry->cell[0] != cell[0] || entry->cell[1] != cell[1] || entry->cell[2] != cell[2] )
+						continue;
+
+					if( IsPointNearFeature( givenPoint, epsilon, entry->point, entry->pointCount ) )
+						return true;
+				}
 			}
 		}
 	}
@@ -88,21 +234,76 @@ bool VectorMath::Surface::Trace::IsPointOnTrace( const Vector& givenPoint, doubl
 	return false;
 }
 
+//=============================================================================
+VectorMath::Surface::TraceTask::TraceTask( void )
+{
+	surface = 0;
+	traceParameters = 0;
+	index = 0;
+}
+
+//=============================================================================
+/*virtual*/ VectorMath::Surface::TraceTask::~TraceTask( void )
+{
+	traceList.RemoveAll( true );
+}
+
+//=============================================================================
+/*virtual*/ void VectorMath::Surface::TraceTask::Execute( void )
+{
+	Plane tracePlane;
+	Vector tracePlaneCenter;
+	surface->CalculateTracePlane( *traceParameters, index, tracePlane, tracePlaneCenter );
+	surface->CalculateTracesInPlane( tracePlane, tracePlaneCenter, traceParameters->extent, traceList, traceParameters->useNewtonSteps, convergenceStats );
+}
+
 //=============================================================================
 // Here the user can expect that we'll just append to their given list.
-void VectorMath::Surface::GenerateTracesAlongAxis( const TraceParameters& traceParameters, Utilities::List& traceList ) const
+void VectorMath::Surface::GenerateTracesAlongAxis( const TraceParameters& traceParameters, Utilities::List& traceList, ParallelInterface* parallelInterface /*= 0*/, ConvergenceStats* convergenceStats /*= 0*/ ) const
+{
+	GenerateTracesAlongAxes( &traceParameters, 1, traceList, parallelInterface, convergenceStats );
+}
+
+//=============================================================================
+// The algorithm is very straight forward.  Go generate all the traces in
+// all the planes we want along each of the given axes.
+void VectorMath::Surface::GenerateTracesAlongAxes( const TraceParameters* traceParametersArray, int axisCount, Utilities::List& traceList, ParallelInterface* parallelInterface /*= 0*/, ConvergenceStats* convergenceStats /*= 0*/ ) const
 {
-	// The algorithm is very straight forward.  Go generate all the traces in
-	// all the planes we want along the given axis.
-	Utilities::List traceListInPlane;
-	for( int index = 0; index < traceParameters.planeCount; index++ )
+	int taskCount = 0;
+	for( int axis = 0; axis < axisCount; axis++ )
+		taskCount += traceParametersArray[ axis ].planeCount;
+	if( taskCount <= 0 )
+		return;
+
+	TraceTask* traceTaskArray = new TraceTask[ taskCount ];
+	ParallelInterface::Task** taskArray = new ParallelInterface::Task*[ taskCount ];
+
+	int taskIndex = 0;
+	for( int axis = 0; axis < axisCount; axis++ )
+	{
+		for( int index = 0; index < traceParametersArray[ axis ].planeCount; index++ )
+		{
+			TraceTask* traceTask = &traceTaskArray[ taskIndex ];
+			traceTask->surface = this;
+			traceTask->traceParameters = &traceParametersArray[ axis ];
+			traceTask->index = index;
+			taskArray[ taskIndex++ ] = traceTask;
+		}
+	}
+
+	ParallelInterface::Execute( parallelInterface, taskArray, taskCount );
+
+	// However the tasks were executed, the result is the same as if we had gone plane by plane.
+	for( taskIndex = 0; taskIndex < taskCount; taskIndex++ )
 	{
-		Plane tracePlane;
-		Vector tracePlaneCenter;
-		CalculateTracePlane( traceParameters, index, tracePlane, tracePlaneCenter );
-		CalculateTracesInPlane( tracePlane, tracePlaneCenter, traceParameters.extent, traceListInPlane );
-		traceListInPlane.EmptyIntoOnRight( traceList );
+		TraceTask* traceTask = &traceTaskArray[ taskIndex ];
+		traceTask->traceList.EmptyIntoOnRight( traceList );
+		if( convergenceStats )
+			convergenceStats->Accumulate( traceTask->convergenceStats );
 	}
+
+	delete[] taskArray;
+	delete[] traceTaskArray;
 }
 
 //=============================================================================
@@ -118,9 +319,22 @@ void VectorMath::Surface::CalculateTracePlane( const TraceParameters& traceParam
 	MakePlane( plane, planeCenter, traceParameters.axis );
 }
 
+//=============================================================================
+// Seeds for the traces in a plane are found in squares this many halvings smaller than the plane's.
+static const int traceSeedDepth = 5;
+
+//=============================================================================
+static bool IsPointOnTraces( const Utilities::List& traceList, const VectorMath::Vector& point, double epsilon )
+{
+	for( const VectorMath::Surface::Trace* trace = ( const VectorMath::Surface::Trace* )traceList.LeftMost(); trace; trace = ( const VectorMath::Surface::Trace* )trace->Right() )
+		if( trace->IsPointOnTrace( point, epsilon ) )
+			return true;
+	return false;
+}
+
 //=============================================================================
 // We assume here that the given center is on the given plane.
-void VectorMath::Surface::CalculateTracesInPlane( const Plane& plane, const Vector& center, double extent, Utilities::List& traceList ) const
+void VectorMath::Surface::CalculateTracesInPlane( const Plane& plane, const Vector& center, double extent, Utilities::List& traceList, bool useNewtonSteps, ConvergenceStats& stats ) const
 {
 	double epsilon = 1e-8;
 
@@ -141,51 +355,83 @@ void VectorMath::Surface::CalculateTracesInPlane( const Plane& plane, const Vect
 	Orthogonal( coordFrame.xAxis, plane.normal );
 	Cross( coordFrame.yAxis, plane.normal, coordFrame.xAxis );
 
-	// The number of possible trace curves in a plane is determined by the degree of
-	// the polynomial equation of the curve.  Also, knowing which seed points to use
-	// is not being done here by any scientific method.  I'm hoping that a circular
-	// spread will help us to likely find all local extrema we need to find.
-	double seedRadius = extent;
-	int seedCount = 4;
-	for( int index = 0; index < seedCount; index++ )
+	// Seed the traces from a quadtree over the square of the plane in the box, which throws out
+	// every square the surface can't pass through.  Knowing which seed points to use for a surface
+	// that can't bound itself is not being done here by any scientific method.  I'm hoping that a
+	// circular spread will help us to likely find all local extrema we need to find.
+	Utilities::List seedList;
+	Interval range;
+	if( EvaluateRange( aabb, range ) )
+		FindSeedsInSquare( coordFrame, center, extent, traceSeedDepth, seedList );
+	else
 	{
-		// Calculate the seed point we're going to try this time around.
-		double angle = 2.0 * PI * double( index ) / double( seedCount );
-		Vector seed;
-		Set( seed, seedRadius * cos( angle ), seedRadius * sin( angle ), 0.0 );
-		Transform( &seed, coordFrame, center, &seed, 1 );
+		enum { SEED_COUNT = 4 };
+		for( int index = 0; index < SEED_COUNT; index++ )
+		{
+			double angle = 2.0 * PI * double( index ) / double( SEED_COUNT );
+			Vector planarSeed, seed;
+			Set( planarSeed, extent * cos( angle ), extent * sin( angle ), 0.0 );
+			Transform( &seed, coordFrame, center, &planarSeed, 1 );
+			seedList.InsertRightOf( seedList.RightMost(), new Point( seed ) );
+		}
+	}
 
-		// Does it converge to the surface?  If not, the seed point
+	// Where a seed converges to doesn't depend on the traces, so all of them are converged
+	// together up front, which lets the surface be evaluated in batches.  A square crossed by
+	// a trace can still hold another curve of the trace, so no seed is passed over until we
+	// know where it converged.
+	int seedCount = seedList.Count();
+	Vector* seedArray = new Vector[ seedCount ];
+	bool* converged = new bool[ seedCount ];
+
+	int index = 0;
+	for( const Point* seedPoint = ( const Point* )seedList.LeftMost(); seedPoint; seedPoint = ( const Point* )seedPoint->Right() )
+		Copy( seedArray[ index++ ], seedPoint->point );
+
+	ConvergePointsToSurfaceInPlane( &plane, seedArray, converged, seedCount, epsilon, useNewtonSteps, stats );
+
+	for( index = 0; index < seedCount; index++ )
+	{
+		// Did the seed converge to the surface?  If not, the seed point
 		// fails us, and we should go to the next seed point.
-		if( !ConvergePointToSurfaceInPlane( &plane, seed, epsilon ) )
+		if( !converged[ index ] )
+			continue;
+
+		const Vector& seed = seedArray[ index ];
+
+		// A seed can converge to a part of the surface outside the box, which we don't trace.
+		if( Aabb::IS_OUTSIDE_BOX == AabbSide( aabb, seed ) )
 			continue;
 
 		// Is the point already on a trace that we have previously calculated?
 		// If so, then we have already done the trace work and should continue
-		// on to the next seed point.
-		Trace* trace = 0;
-		for( trace = ( Trace* )traceList.LeftMost(); trace; trace = ( Trace* )trace->Right() )
-			if( trace->IsPointOnTrace( seed, 5e-3 ) )
-				break;
-		if( trace )
+		// on to the next seed point.  A trace cuts across the bends of the curve
+		// between its points, and with so many seeds, plenty of them converge
+		// between two points of a trace, so we can't be too strict about this.
+		if( IsPointOnTraces( traceList, seed, 0.05 ) )
 			continue;
 
 		// Calculate a new trace and add it to the list.
-		trace = CalculateTraceInPlane( plane, seed, aabb );
+		Trace* trace = CalculateTraceInPlane( plane, seed, aabb, traceList, useNewtonSteps, stats );
 		traceList.InsertRightOf( traceList.RightMost(), trace );
 	}
+
+	delete[] seedArray;
+	delete[] converged;
+
+	seedList.RemoveAll( true );
 }
 
 //=============================================================================
-VectorMath::Surface::Trace* VectorMath::Surface::CalculateTraceInPlane( const Plane& plane, const Vector& seed, const Aabb& aabb ) const
+VectorMath::Surface::Trace* VectorMath::Surface::CalculateTraceInPlane( const Plane& plane, const Vector& seed, const Aabb& aabb, const Utilities::List& traceList, bool useNewtonSteps, ConvergenceStats& stats ) const
 {
 	double epsilon = 1e-8;
-	int tracePointLimit = 100;
+	int tracePointLimit = 1000;
 	
 	// The initial seed must converge to a point on the surface.
 	Vector point;
 	Copy( point, seed );
-	if( !ConvergePointToSurfaceInPlane( &plane, point, epsilon ) )
+	if( !ConvergePointToSurfaceInPlane( &plane, point, epsilon, useNewtonSteps, stats ) )
 		return 0;
 
 	// We have a point on the surface, so our trace will be non-empty.
@@ -207,9 +453,9 @@ VectorMath::Surface::Trace* VectorMath::Surface::CalculateTraceInPlane( const Pl
 			// Add the traced point to the list.  Keep the order of the list
 			// such that it can be used to draw a poly-line of the trace.
 			if( direction == 0 )
-				trace->pointList.InsertRightOf( trace->pointList.RightMost(), new Point( point ) );
+				trace->AppendPoint( point );
 			else
-				trace->pointList.InsertLeftOf( trace->pointList.LeftMost(), new Point( point ) );
+				trace->PrependPoint( point );
 
 			// We shouldn't need this limit for our algorithm to always correctly terminate,
 			// but the limit is put in place here to prevent us from creating too many lines
@@ -218,7 +464,7 @@ VectorMath::Surface::Trace* VectorMath::Surface::CalculateTraceInPlane( const Pl
 				break;
 
 			// Attempt to trace the surface in the desired direction.
-			stepMade = StepTraceInPlane( plane, direction, point, traceDelta, epsilon );
+			stepMade = StepTraceInPlane( plane, direction, point, traceDelta, epsilon, useNewtonSteps, stats );
 
 			// After each successful step, check to see if we have come full circle.
 			if( stepMade )
@@ -228,7 +474,7 @@ VectorMath::Surface::Trace* VectorMath::Surface::CalculateTraceInPlane( const Pl
 				// This must be smaller than our step delta or we'll falsely
 				// detect a loop and not generate a curve at all.
 				double loopDetectEps = 0.008;
-				if( trace->IsPointOnTrace( point, 0.008 ) )
+				if( trace->IsPointOnTrace( point, loopDetectEps ) )
 				{
 					// Indicate that the caller should consider the trace a line-loop
 					// in the case that the trace is more than one point.  If it is
@@ -237,6 +483,19 @@ VectorMath::Surface::Trace* VectorMath::Surface::CalculateTraceInPlane( const Pl
 						trace->looped = true;
 					break;
 				}
+
+				// If we run into a trace we already have, then the curve has already been traced
+				// from here on in this direction.  This happens when that trace stopped short, or
+				// where curves of the trace cross at a singular point of the surface.  Join up
+				// with it and go the other way.
+				if( IsPointOnTraces( traceList, point, loopDetectEps ) )
+				{
+					if( direction == 0 )
+						trace->AppendPoint( point );
+					else
+						trace->PrependPoint( point );
+					stepMade = false;
+				}
 			}
 		}
 
@@ -249,10 +508,10 @@ VectorMath::Surface::Trace* VectorMath::Surface::CalculateTraceInPlane( const Pl
 			{
 				// Reset to our original position on the surface.
 				Copy( point, seed );
-				ConvergePointToSurfaceInPlane( &plane, point, epsilon );
+				ConvergePointToSurfaceInPlane( &plane, point, epsilon, useNewtonSteps, stats );
 
 				// Take the initial step now, because we have already considered the initial point on the surface.
-				if( !StepTraceInPlane( plane, direction, point, traceDelta, epsilon ) )
+				if( !StepTraceInPlane( plane, direction, point, traceDelta, epsilon, useNewtonSteps, stats ) )
 					break;
 			}
 		}
@@ -263,7 +522,7 @@ VectorMath::Surface::Trace* VectorMath::Surface::CalculateTraceInPlane( const Pl
 }
 
 //=============================================================================
-bool VectorMath::Surface::StepTraceInPlane( const Plane& plane, int direction, Vector& point, double traceDelta, double epsilon ) const
+bool VectorMath::Surface::StepTraceInPlane( const Plane& plane, int direction, Vector& point, double traceDelta, double epsilon, bool useNewtonSteps, ConvergenceStats& stats ) const
 {
 	// Calculate the direction of the translation vector along which we'll move the point in the given plane.
 	Vector gradient, delta;
@@ -289,74 +548,211 @@ bool VectorMath::Surface::StepTraceInPlane( const Plane& plane, int direction, V
 
 	// Our step now succeeds if the translated point converges back onto the
 	// surface, hopefully in a new position on the surface in the desired direction.
-	return ConvergePointToSurfaceInPlane( &plane, point, epsilon );
+	return ConvergePointToSurfaceInPlane( &plane, point, epsilon, useNewtonSteps, stats );
 }
 
 //=============================================================================
-bool VectorMath::Surface::ConvergePointToSurfaceInPlane( const Plane* plane, Vector& point, double epsilon ) const
+VectorMath::Surface::ConvergenceStats::ConvergenceStats( void )
 {
-	// This must be small, but bigger than epsilons used to detect trace loops.
-	double deltaLength = 0.1;
+	convergedCount = 0;
+	failedCount = 0;
+	iterationCount = 0;
+	evaluationCount = 0;
+	fallbackCount = 0;
+}
+
+//=============================================================================
+void VectorMath::Surface::ConvergenceStats::Accumulate( const ConvergenceStats& stats )
+{
+	convergedCount += stats.convergedCount;
+	failedCount += stats.failedCount;
+	iterationCount += stats.iterationCount;
+	evaluationCount += stats.evaluationCount;
+	fallbackCount += stats.fallbackCount;
+}
+
+//=============================================================================
+bool VectorMath::Surface::ConvergePointToSurfaceInPlane( const Plane* plane, Vector& point, double epsilon, bool useNewtonSteps, ConvergenceStats& stats ) const
+{
+	bool converged = false;
+	ConvergeBatchToSurfaceInPlane( plane, &point, &converged, 1, epsilon, useNewtonSteps, stats );
+	return converged;
+}
+
+//=============================================================================
+void VectorMath::Surface::ConvergePointsToSurfaceInPlane( const Plane* plane, Vector* points, bool* converged, int count, double epsilon, bool useNewtonSteps, ConvergenceStats& stats ) const
+{
+	for( int index = 0; index < count; index += CONVERGENCE_BATCH_SIZE )
+	{
+		int batchSize = count - index;
+		if( batchSize > CONVERGENCE_BATCH_SIZE )
+			batchSize = CONVERGENCE_BATCH_SIZE;
+		ConvergeBatchToSurfaceInPlane( plane, &points[ index ], &converged[ index ], batchSize, epsilon, useNewtonSteps, stats );
+	}
+}
+
+//=============================================================================
+// Each point first tries Newton steps, moving by -f g / |g|^2, where g is the gradient
+// projected into the plane, so that to first order f is zero after the move.  Near a
+// root this converges very quickly, but it isn't safe far away from one or where the
+// gradient vanishes, so the moment a Newton step fails to make |f| smaller, the point
+// falls back to walking a fixed distance down the gradient for the rest of the way.
+//
+// The active list holds the indices of the points that have yet to either converge or fail.
+// It is compacted as points drop out, so every evaluation is of contiguous points.
+void VectorMath::Surface::ConvergeBatchToSurfaceInPlane( const Plane* plane, Vector* points, bool* converged, int count, double epsilon, bool useNewtonSteps, ConvergenceStats& stats ) const
+{
+	int active[ CONVERGENCE_BATCH_SIZE ];
+	double deltaLength[ CONVERGENCE_BATCH_SIZE ];
+	bool newton[ CONVERGENCE_BATCH_SIZE ];
+	Vector activePoints[ CONVERGENCE_BATCH_SIZE ], gradients[ CONVERGENCE_BATCH_SIZE ], movedPoints[ CONVERGENCE_BATCH_SIZE ];
+	double values[ CONVERGENCE_BATCH_SIZE ], movedValues[ CONVERGENCE_BATCH_SIZE ];
+
+	// A Newton step is never allowed to take us further than this.
+	double maxNewtonStep = 1.0;
+
+	int activeCount = count;
+	for( int index = 0; index < count; index++ )
+	{
+		active[ index ] = index;
+		converged[ index ] = false;
+		newton[ index ] = useNewtonSteps;
+
+		// This must be small, but bigger than epsilons used to detect trace loops.
+		deltaLength[ index ] = 0.1;
+	}
+
+	// These are tallied for the points that converge.
+	int iterationCount = 0;
+	int evaluationCount = 0;
+	int fallbackCount = 0;
 
 	// Is there a way to prove or disprove that this algorithm converges?
 	int maxIters = 200; //1000;
-	for( int count = 0; count < maxIters; count++ )
+	int iteration;
+	for( iteration = 0; iteration < maxIters && activeCount > 0; iteration++ )
 	{
-		// Project the point down onto the plane.
+		// Project the points down onto the plane.
 		// This is mainly to account for accumulated round-off error.
-		if( plane )
-			ProjectPointOntoPlane( *plane, point, point );
-
-		// Is the point approximately on the surface?
-		double value = EvaluateAt( point );
-		if( fabs( value ) <= epsilon )
-			return true;
+		for( int j = 0; j < activeCount; j++ )
+		{
+			Vector& point = points[ active[j] ];
+			if( plane )
+				ProjectPointOntoPlane( *plane, point, point );
+			Copy( activePoints[j], point );
+		}
 
-		// No, we need to move the point.
-		// In what direction should we move?
-		Vector gradient, delta;
-		EvaluateGradientAt( point, gradient );
-		if( plane )
-			ProjectVectorOntoPlane( *plane, delta, gradient );
-		else
-			Copy( delta, gradient );
-		Normalize( delta, delta );
-		Scale( delta, delta, deltaLength );
-
-		// Move in that direction.
-		Vector movedPoint;
-		bool isValuePositive = value > 0.0;
-		if( isValuePositive )
-			Sub( movedPoint, point, delta );
-		else
-			Add( movedPoint, point, delta );
+		EvaluateBatch( activePoints, activeCount, values, gradients );
 
-		// Did we over-shoot our target?
-		double movedValue = EvaluateAt( movedPoint );
-		bool isMovedValuePositive = movedValue > 0.0;
-		if( isMovedValuePositive != isValuePositive )
+		int movedCount = 0;
+		for( int j = 0; j < activeCount; j++ )
 		{
-			// Yes, reject the move and half our move amount.
-			deltaLength /= 2.0;
+			int index = active[j];
+
+			// Is the point approximately on the surface?
+			double value = values[j];
+			if( fabs( value ) <= epsilon )
+			{
+				converged[ index ] = true;
+				iterationCount += iteration + 1;
+				evaluationCount += 2 * iteration + 1;
+				if( useNewtonSteps && !newton[ index ] )
+					fallbackCount++;
+				continue;
+			}
+
+			// No, we need to move the point.
+			// In what direction should we move?
+			Vector delta;
+			if( plane )
+				ProjectVectorOntoPlane( *plane, delta, gradients[j] );
+			else
+				Copy( delta, gradients[j] );
+
+			double squareLength = Dot( delta, delta );
+			if( newton[ index ] && squareLength > epsilon * epsilon )
+			{
+				Scale( delta, delta, -value / squareLength );
+				double length = sqrt( Dot( delta, delta ) );
+				if( length > maxNewtonStep )
+					Scale( delta, delta, maxNewtonStep / length );
+				Add( movedPoints[ movedCount ], activePoints[j], delta );
+			}
+			else
+			{
+				newton[ index ] = false;
+
+				Normalize( delta, delta );
+				Scale( delta, delta, deltaLength[ index ] );
+
+				// Move in that direction.
+				if( value > 0.0 )
+					Sub( movedPoints[ movedCount ], activePoints[j], delta );
+				else
+					Add( movedPoints[ movedCount ], activePoints[j], delta );
+			}
+
+			values[ movedCount ] = value;
+			active[ movedCount++ ] = index;
 		}
-		else
+
+		EvaluateBatch( movedPoints, movedCount, movedValues, 0 );
+
+		activeCount = 0;
+		for( int j = 0; j < movedCount; j++ )
 		{
-			// No, accept the move.
-			Copy( point, movedPoint );
+			int index = active[j];
 
-			// As a sanity check, did the value improve?
-			if( fabs( movedValue ) >= fabs( value ) )
+			if( newton[ index ] )
 			{
-				// The value will not improve in the case that
-				// that there is no trace in the given plane.
-				return false;
+				// Going to the other side of the surface is fine here, so long as we get closer to it.
+				// If we didn't, this point won't be taking any more Newton steps.
+				if( fabs( movedValues[j] ) < fabs( values[j] ) )
+					Copy( points[ index ], movedPoints[j] );
+				else
+					newton[ index ] = false;
 			}
+			else
+			{
+				// Did we over-shoot our target?
+				bool isValuePositive = values[j] > 0.0;
+				bool isMovedValuePositive = movedValues[j] > 0.0;
+				if( isMovedValuePositive != isValuePositive )
+				{
+					// Yes, reject the move and half our move amount.
+					deltaLength[ index ] /= 2.0;
+				}
+				else
+				{
+					// No, accept the move.
+					Copy( points[ index ], movedPoints[j] );
+
+					// As a sanity check, did the value improve?
+					if( fabs( movedValues[j] ) >= fabs( values[j] ) )
+					{
+						// The value will not improve in the case that
+						// that there is no trace in the given plane.
+						continue;
+					}
+				}
+			}
+
+			active[ activeCount++ ] = index;
 		}
 	}
 
 	// Failure occures if our algorithm fails to converge the point
 	// onto the surface in the alotted number of iterations.
-	return false;
+	for( int index = 0; index < count; index++ )
+	{
+		if( converged[ index ] )
+			stats.convergedCount++;
+		else
+			stats.failedCount++;
+	}
+	stats.iterationCount += iterationCount;
+	stats.evaluationCount += evaluationCount;
+	stats.fallbackCount += fallbackCount;
 }
 
 //=============================================================================
@@ -367,6 +763,96 @@ bool VectorMath::Surface::ConvergePointToSurfaceInPlane( const Plane* plane, Vec
 	gradient.z = EvaluatePartialZ( point );
 }
 
+//=============================================================================
+/*virtual*/ void VectorMath::Surface::EvaluateBatch( const Vector* points, int count, double* values, Vector* gradients ) const
+{
+	for( int index = 0; index < count; index++ )
+	{
+		values[ index ] = EvaluateAt( points[ index ] );
+		if( gradients )
+			EvaluateGradientAt( points[ index ], gradients[ index ] );
+	}
+}
+
+//=============================================================================
+/*virtual*/ bool VectorMath::Surface::EvaluateRange( const Aabb& aabb, Interval& range ) const
+{
+	return false;
+}
+
+//=============================================================================
+bool VectorMath::Surface::FindSeeds( const Aabb& aabb, int depth, Utilities::List& seedList ) const
+{
+	Interval range;
+	if( !EvaluateRange( aabb, range ) )
+		return false;
+
+	FindSeedsInBox( aabb, depth, seedList );
+	return true;
+}
+
+//=============================================================================
+// Bounds found by interval arithmetic are generally wider than the true range,
+// so a cell we keep might not hold any of the surface, but a cell we throw out
+// certainly doesn't.  The bounds get tighter as the cells get smaller.
+void VectorMath::Surface::FindSeedsInBox( const Aabb& aabb, int depth, Utilities::List& seedList ) const
+{
+	Interval range;
+	if( !EvaluateRange( aabb, range ) || !IntervalContains( range, 0.0 ) )
+		return;
+
+	Vector center;
+	CalcCenter( aabb, center );
+
+	Aabb aabbArray[8];
+	int aabbCount = 0;
+	if( depth > 0 )
+		aabbCount = AabbSplit( aabb, center, aabbArray );
+
+	if( aabbCount == 0 )
+		seedList.InsertRightOf( seedList.RightMost(), new Point( center ) );
+	else
+	{
+		for( int index = 0; index < aabbCount; index++ )
+			FindSeedsInBox( aabbArray[ index ], depth - 1, seedList );
+	}
+}
+
+//=============================================================================
+// This is the planar version of the octree.  Each square is given by its center and the
+// distance from there to its sides along the x and y axes of the given frame.  The box
+// of the square's corners holds the square, so it can be used to bound the function there.
+void VectorMath::Surface::FindSeedsInSquare( const CoordFrame& coordFrame, const Vector& center, double radius, int depth, Utilities::List& seedList ) const
+{
+	Aabb aabb;
+	MakeZeroAabb( aabb, center );
+	for( int corner = 0; corner < 4; corner++ )
+	{
+		Vector cornerPoint;
+		AddScale( cornerPoint, center, coordFrame.xAxis, ( corner & 1 ) ? radius : -radius );
+		AddScale( cornerPoint, cornerPoint, coordFrame.yAxis, ( corner & 2 ) ? radius : -radius );
+		ExpandAabb( aabb, cornerPoint );
+	}
+
+	Interval range;
+	if( !EvaluateRange( aabb, range ) || !IntervalContains( range, 0.0 ) )
+		return;
+
+	if( depth == 0 )
+	{
+		seedList.InsertRightOf( seedList.RightMost(), new Point( center ) );
+		return;
+	}
+
+	for( int quadrant = 0; quadrant < 4; quadrant++ )
+	{
+		Vector quadrantCenter;
+		AddScale( quadrantCenter, center, coordFrame.xAxis, ( quadrant & 1 ) ? radius / 2.0 : -radius / 2.0 );
+		AddScale( quadrantCenter, quadrantCenter, coordFrame.yAxis, ( quadrant & 2 ) ? radius / 2.0 : -radius / 2.0 );
+		FindSeedsInSquare( coordFrame, quadrantCenter, radius / 2.0, depth - 1, seedList );
+	}
+}
+
 //=============================================================================
 VectorMath::Quadric::Quadric( void )
 {
@@ -418,6 +904,92 @@ VectorMath::Quadric::Quadric( void )
 	return 2.0*C*z + E*x + F*y + I;
 }
 
+//=============================================================================
+/*virtual*/ void VectorMath::Quadric::EvaluateBatch( const Vector* points, int count, double* values, Vector* gradients ) const
+{
+	int index = 0;
+
+#ifdef VECTORMATH_SSE2
+	// Each pass evaluates two points, one in each lane.
+	__m128d a = _mm_set1_pd( A ), b = _mm_set1_pd( B ), c = _mm_set1_pd( C );
+	__m128d d = _mm_set1_pd( D ), e = _mm_set1_pd( E ), f = _mm_set1_pd( F );
+	__m128d g = _mm_set1_pd( G ), h = _mm_set1_pd( H ), i = _mm_set1_pd( I ), j = _mm_set1_pd( J );
+	__m128d two = _mm_set1_pd( 2.0 );
+
+	for( ; index + 1 < count; index += 2 )
+	{
+		const Vector* point = &points[ index ];
+		__m128d x = _mm_set_pd( point[1].x, point[0].x );
+		__m128d y = _mm_set_pd( point[1].y, point[0].y );
+		__m128d z = _mm_set_pd( point[1].z, point[0].z );
+
+		// f(x,y,z) = x(Ax + Dy + Ez + G) + y(By + Fz + H) + z(Cz + I) + J
+		__m128d value = _mm_add_pd( _mm_mul_pd( a, x ), _mm_add_pd( _mm_mul_pd( d, y ), _mm_add_pd( _mm_mul_pd( e, z ), g ) ) );
+		value = _mm_mul_pd( x, value );
+		value = _mm_add_pd( value, _mm_mul_pd( y, _mm_add_pd( _mm_mul_pd( b, y ), _mm_add_pd( _mm_mul_pd( f, z ), h ) ) ) );
+		value = _mm_add_pd( value, _mm_mul_pd( z, _mm_add_pd( _mm_mul_pd( c, z ), i ) ) );
+		value = _mm_add_pd( value, j );
+		_mm_storeu_pd( &values[ index ], value );
+
+		if( gradients )
+		{
+			__m128d partialX = _mm_add_pd( _mm_mul_pd( _mm_mul_pd( two, a ), x ), _mm_add_pd( _mm_mul_pd( d, y ), _mm_add_pd( _mm_mul_pd( e, z ), g ) ) );
+			__m128d partialY = _mm_add_pd( _mm_mul_pd( _mm_mul_pd( two, b ), y ), _mm_add_pd( _mm_mul_pd( d, x ), _mm_add_pd( _mm_mul_pd( f, z ), h ) ) );
+			__m128d partialZ = _mm_add_pd( _mm_mul_pd( _mm_mul_pd( two, c ), z ), _mm_add_pd( _mm_mul_pd( e, x ), _mm_add_pd( _mm_mul_pd( f, y ), i ) ) );
+
+			Vector* gradient = &gradients[ index ];
+			_mm_storel_pd( &gradient[0].x, partialX );
+			_mm_storeh_pd( &gradient[1].x, partialX );
+			_mm_storel_pd( &gradient[0].y, partialY );
+			_mm_storeh_pd( &gradient[1].y, partialY );
+			_mm_storel_pd( &gradient[0].z, partialZ );
+			_mm_storeh_pd( &gradient[1].z, partialZ );
+		}
+	}
+#endif
+
+	for( ; index < count; index++ )
+	{
+		const Vector& point = points[ index ];
+		values[ index ] = Quadric::EvaluateAt( point );
+		if( gradients )
+		{
+			gradients[ index ].x = Quadric::EvaluatePartialX( point );
+			gradients[ index ].y = Quadric::EvaluatePartialY( point );
+			gradients[ index ].z = Quadric::EvaluatePartialZ( point );
+		}
+	}
+}
+
+//=============================================================================
+/*virtual*/ bool VectorMath::Quadric::EvaluateRange( const Aabb& aabb, Interval& range ) const
+{
+	Interval x, y, z;
+	MakeInterval( x, aabb.min.x, aabb.max.x );
+	MakeInterval( y, aabb.min.y, aabb.max.y );
+	MakeInterval( z, aabb.min.z, aabb.max.z );
+
+	Interval xx, yy, zz, xy, xz, yz;
+	SquareInterval( xx, x );
+	SquareInterval( yy, y );
+	SquareInterval( zz, z );
+	MultiplyInterval( xy, x, y );
+	MultiplyInterval( xz, x, z );
+	MultiplyInterval( yz, y, z );
+
+	MakeInterval( range, J );
+	AddScaleInterval( range, range, xx, A );
+	AddScaleInterval( range, range, yy, B );
+	AddScaleInterval( range, range, zz, C );
+	AddScaleInterval( range, range, xy, D );
+	AddScaleInterval( range, range, xz, E );
+	AddScaleInterval( range, range, yz, F );
+	AddScaleInterval( range, range, x, G );
+	AddScaleInterval( range, range, y, H );
+	AddScaleInterval( range, range, z, I );
+	return true;
+}
+
 //=============================================================================
 VectorMath::ConformalQuartic::ConformalQuartic( void )
 {
@@ -585,4 +1157,167 @@ VectorMath::ConformalQuartic::ConformalQuartic( void )
 	return value;
 }
 
+//=============================================================================
+// Collecting terms, the quartic is f = r2( h r2 + a . p - k ) + q(p) + l . p + m, where p = <x,y,z>,
+// r2 = p . p, and q is a quadratic form.  Its gradient is then ( 4h r2 + 2( a . p - k ) ) p + r2 a + grad q + l.
+struct ConformalQuarticTerms
+{
+	ConformalQuarticTerms( const VectorMath::ConformalQuartic& quartic )
+	{
+		h = -0.25 * quartic.c0;
+		ax = 0.5 * ( quartic.c1 + quartic.c5 );
+		ay = 0.5 * ( quartic.c2 + quartic.c10 );
+		az = 0.5 * ( quartic.c3 + quartic.c15 );
+		k = 0.5 * ( quartic.c4 + quartic.c20 );
+		qxx = -quartic.c6;
+		qyy = -quartic.c12;
+		qzz = -quartic.c18;
+		qxy = -( quartic.c7 + quartic.c11 );
+		qxz = -( quartic.c8 + quartic.c16 );
+		qyz = -( quartic.c13 + quartic.c17 );
+		lx = quartic.c9 + quartic.c21;
+		ly = quartic.c14 + quartic.c22;
+		lz = quartic.c19 + quartic.c23;
+		m = -quartic.c24;
+	}
+
+	double h, ax, ay, az, k;
+	double qxx, qyy, qzz, qxy, qxz, qyz;
+	double lx, ly, lz, m;
+};
+
+//=============================================================================
+/*virtual*/ void VectorMath::ConformalQuartic::EvaluateBatch( const Vector* points, int count, double* values, Vector* gradients ) const
+{
+	ConformalQuarticTerms terms( *this );
+	int index = 0;
+
+#ifdef VECTORMATH_SSE2
+	// Each pass evaluates two points, one in each lane.
+	__m128d h = _mm_set1_pd( terms.h ), k = _mm_set1_pd( terms.k );
+	__m128d ax = _mm_set1_pd( terms.ax ), ay = _mm_set1_pd( terms.ay ), az = _mm_set1_pd( terms.az );
+	__m128d qxx = _mm_set1_pd( terms.qxx ), qyy = _mm_set1_pd( terms.qyy ), qzz = _mm_set1_pd( terms.qzz );
+	__m128d qxy = _mm_set1_pd( terms.qxy ), qxz = _mm_set1_pd( terms.qxz ), qyz = _mm_set1_pd( terms.qyz );
+	__m128d lx = _mm_set1_pd( terms.lx ), ly = _mm_set1_pd( terms.ly ), lz = _mm_set1_pd( terms.lz ), m = _mm_set1_pd( terms.m );
+	__m128d two = _mm_set1_pd( 2.0 ), four = _mm_set1_pd( 4.0 );
+
+	for( ; index + 1 < count; index += 2 )
+	{
+		const Vector* point = &points[ index ];
+		__m128d x = _mm_set_pd( point[1].x, point[0].x );
+		__m128d y = _mm_set_pd( point[1].y, point[0].y );
+		__m128d z = _mm_set_pd( point[1].z, point[0].z );
+
+		__m128d r2 = _mm_add_pd( _mm_mul_pd( x, x ), _mm_add_pd( _mm_mul_pd( y, y ), _mm_mul_pd( z, z ) ) );
+		__m128d inner = _mm_sub_pd( _mm_add_pd( _mm_mul_pd( ax, x ), _mm_add_pd( _mm_mul_pd( ay, y ), _mm_mul_pd( az, z ) ) ), k );
+
+		// These are q(p) = x( qxx x + qxy y + qxz z ) + y( qyy y + qyz z ) + z( qzz z ) and l . p + m.
+		__m128d quadratic = _mm_mul_pd( x, _mm_add_pd( _mm_mul_pd( qxx, x ), _mm_add_pd( _mm_mul_pd( qxy, y ), _mm_mul_pd( qxz, z ) ) ) );
+		quadratic = _mm_add_pd( quadratic, _mm_mul_pd( y, _mm_add_pd( _mm_mul_pd( qyy, y ), _mm_mul_pd( qyz, z ) ) ) );
+		quadratic = _mm_add_pd( quadratic, _mm_mul_pd( z, _mm_mul_pd( qzz, z ) ) );
+		__m128d linear = _mm_add_pd( _mm_add_pd( _mm_mul_pd( lx, x ), _mm_add_pd( _mm_mul_pd( ly, y ), _mm_mul_pd( lz, z ) ) ), m );
+
+		__m128d value = _mm_mul_pd( r2, _mm_add_pd( _mm_mul_pd( h, r2 ), inner ) );
+		value = _mm_add_pd( value, _mm_add_pd( quadratic, linear ) );
+		_mm_storeu_pd( &values[ index ], value );
+
+		if( gradients )
+		{
+			__m128d s = _mm_add_pd( _mm_mul_pd( _mm_mul_pd( four, h ), r2 ), _mm_mul_pd( two, inner ) );
+
+			__m128d partialX = _mm_add_pd( _mm_mul_pd( s, x ), _mm_mul_pd( r2, ax ) );
+			partialX = _mm_add_pd( partialX, _mm_add_pd( _mm_mul_pd( _mm_mul_pd( two, qxx ), x ), _mm_add_pd( _mm_mul_pd( qxy, y ), _mm_mul_pd( qxz, z ) ) ) );
+			partialX = _mm_add_pd( partialX, lx );
+
+			__m128d partialY = _mm_add_pd( _mm_mul_pd( s, y ), _mm_mul_pd( r2, ay ) );
+			partialY = _mm_add_pd( partialY, _mm_add_pd( _mm_mul_pd( _mm_mul_pd( two, qyy ), y ), _mm_add_pd( _mm_mul_pd( qxy, x ), _mm_mul_pd( qyz, z ) ) ) );
+			partialY = _mm_add_pd( partialY, ly );
+
+			__m128d partialZ = _mm_add_pd( _mm_mul_pd( s, z ), _mm_mul_pd( r2, az ) );
+			partialZ = _mm_add_pd( partialZ, _mm_add_pd( _mm_mul_pd( _mm_mul_pd( two, qzz ), z ), _mm_add_pd( _mm_mul_pd( qxz, x ), _mm_mul_pd( qyz, y ) ) ) );
+			partialZ = _mm_add_pd( partialZ, lz );
+
+			Vector* gradient = &gradients[ index ];
+			_mm_storel_pd( &gradient[0].x, partialX );
+			_mm_storeh_pd( &gradient[1].x, partialX );
+			_mm_storel_pd( &gradient[0].y, partialY );
+			_mm_storeh_pd( &gradient[1].y, partialY );
+			_mm_storel_pd( &gradient[0].z, partialZ );
+			_mm_storeh_pd( &gradient[1].z, partialZ );
+		}
+	}
+#endif
+
+	// This is the same arithmetic as above, one point at a time.
+	for( ; index < count; index++ )
+	{
+		double x = points[ index ].x;
+		double y = points[ index ].y;
+		double z = points[ index ].z;
+
+		double r2 = x*x + y*y + z*z;
+		double inner = terms.ax*x + terms.ay*y + terms.az*z - terms.k;
+		double quadratic = x*( terms.qxx*x + terms.qxy*y + terms.qxz*z ) + y*( terms.qyy*y + terms.qyz*z ) + z*( terms.qzz*z );
+		double linear = terms.lx*x + terms.ly*y + terms.lz*z + terms.m;
+
+		values[ index ] = r2*( terms.h*r2 + inner ) + ( quadratic + linear );
+
+		if( gradients )
+		{
+			double s = 4.0*terms.h*r2 + 2.0*inner;
+			gradients[ index ].x = s*x + r2*terms.ax + ( 2.0*terms.qxx*x + ( terms.qxy*y + terms.qxz*z ) ) + terms.lx;
+			gradients[ index ].y = s*y + r2*terms.ay + ( 2.0*terms.qyy*y + ( terms.qxy*x + terms.qyz*z ) ) + terms.ly;
+			gradients[ index ].z = s*z + r2*terms.az + ( 2.0*terms.qzz*z + ( terms.qxz*x + terms.qyz*y ) ) + terms.lz;
+		}
+	}
+}
+
+//=============================================================================
+// Collecting terms as the batch evaluation does, the quartic is h r^4 + ( a . p - k ) r^2 plus a
+// quadric, where r^2 = x^2 + y^2 + z^2.  Bounding r^2 once keeps the bounds from growing wider
+// than they would if we bounded each of the many terms it expands into by itself.
+/*virtual*/ bool VectorMath::ConformalQuartic::EvaluateRange( const Aabb& aabb, Interval& range ) const
+{
+	ConformalQuarticTerms terms( *this );
+
+	Interval x, y, z;
+	MakeInterval( x, aabb.min.x, aabb.max.x );
+	MakeInterval( y, aabb.min.y, aabb.max.y );
+	MakeInterval( z, aabb.min.z, aabb.max.z );
+
+	Interval xx, yy, zz, xy, xz, yz;
+	SquareInterval( xx, x );
+	SquareInterval( yy, y );
+	SquareInterval( zz, z );
+	MultiplyInterval( xy, x, y );
+	MultiplyInterval( xz, x, z );
+	MultiplyInterval( yz, y, z );
+
+	Interval r2, r4;
+	AddInterval( r2, xx, yy );
+	AddInterval( r2, r2, zz );
+	SquareInterval( r4, r2 );
+
+	Interval cubic;
+	MakeInterval( cubic, -terms.k );
+	AddScaleInterval( cubic, cubic, x, terms.ax );
+	AddScaleInterval( cubic, cubic, y, terms.ay );
+	AddScaleInterval( cubic, cubic, z, terms.az );
+	MultiplyInterval( cubic, cubic, r2 );
+
+	MakeInterval( range, terms.m );
+	AddScaleInterval( range, range, r4, terms.h );
+	AddInterval( range, range, cubic );
+	AddScaleInterval( range, range, xx, terms.qxx );
+	AddScaleInterval( range, range, yy, terms.qyy );
+	AddScaleInterval( range, range, zz, terms.qzz );
+	AddScaleInterval( range, range, xy, terms.qxy );
+	AddScaleInterval( range, range, xz, terms.qxz );
+	AddScaleInterval( range, range, yz, terms.qyz );
+	AddScaleInterval( range, range, x, terms.lx );
+	AddScaleInterval( range, range, y, terms.ly );
+	AddScaleInterval( range, range, z, terms.lz );
+	return true;
+}
+
 // Surface.cpp
\ No newline at end of file
@@ -14,7 +14,9 @@
 #include "Vector.h"
 #include "Plane.h"
 #include "AxisAlignedBoundingBox.h"
+#include "Interval.h"
 #include "CoordFrame.h"
+#include "ParallelInterface.h"
 #include "Calculator/CalcLib.h"
 
 namespace VectorMath
@@ -49,8 +51,54 @@ namespace VectorMath
 
 			bool IsPointOnTrace( const Vector& givenPoint, double epsilon ) const;
 
+			// Points must only ever be added at the ends of the trace, and only through these.
+			void AppendPoint( const Vector& point );
+			void PrependPoint( const Vector& point );
+
 			Utilities::List pointList;
 			bool looped;
+
+		private:
+
+			// A feature of the trace is a point, the segment from it to the next point, or the curve
+			// through it and the next two points.  Each is filed under every cell of a uniform grid
+			// touched by its bounding box, so that a query only has to look near the given point.
+			// Features never change once made, because points are only added at the ends.
+			class GridEntry
+			{
+			public:
+				int cell[3];
+				const Point* point;
+				int pointCount;
+				GridEntry* next;
+			};
+
+			enum { GRID_BUCKET_COUNT = 256 };
+
+			void FileFeature( const Point* point, int pointCount );
+			bool IsPointNearFeature( const Vector& givenPoint, double epsilon, const Point* point, int pointCount ) const;
+
+			GridEntry** gridBucketArray;
+		};
+
+		// Every point we converge to the surface is tallied in stats kept by whoever asked for
+		// it, so that no two threads ever tally in the same place.
+		struct ConvergenceStats
+		{
+			ConvergenceStats( void );
+
+			void Accumulate( const ConvergenceStats& stats );
+
+			int convergedCount;
+			int failedCount;
+
+			// These only count towards points that converged.  An evaluation is of
+			// the function at one point, and half of them include the gradient.
+			int iterationCount;
+			int evaluationCount;
+
+			// This is how many converged points had to give up on Newton's method.
+			int fallbackCount;
 		};
 
 		struct TraceParameters
@@ -60,9 +108,17 @@ namespace VectorMath
 			double range;
 			double extent;
 			int planeCount;
+
+			// This says whether the points of the traces are converged with Newton steps.
+			bool useNewtonSteps;
 		};
 
-		void GenerateTracesAlongAxis( const TraceParameters& traceParameters, Utilities::List& traceList ) const;
+		// The traces in every plane are calculated independently of those in any other plane, so
+		// given a parallel interface, the planes are handed out to it as tasks.  Either way, the
+		// traces are appended to the given list in order of axis, then plane, and the work it took
+		// to converge points is added to the given stats, if any.
+		void GenerateTracesAlongAxis( const TraceParameters& traceParameters, Utilities::List& traceList, ParallelInterface* parallelInterface = 0, ConvergenceStats* convergenceStats = 0 ) const;
+		void GenerateTracesAlongAxes( const TraceParameters* traceParametersArray, int axisCount, Utilities::List& traceList, ParallelInterface* parallelInterface = 0, ConvergenceStats* convergenceStats = 0 ) const;
 		
 		// Derived classes implement this interface.
 		virtual double EvaluateAt( const VectorMath::Vector& point ) const = 0;
@@ -71,14 +127,60 @@ namespace VectorMath
 		virtual double EvaluatePartialZ( const VectorMath::Vector& point ) const = 0;
 		virtual void EvaluateGradientAt( const VectorMath::Vector& point, VectorMath::Vector& gradient ) const;
 
-		bool ConvergePointToSurfaceInPlane( const Plane* plane, Vector& point, double epsilon ) const;
+		// Evaluate the function at each of the given points, and its gradient there too, if gradients
+		// are wanted.  By default, this just goes through the interface above one point at a time.
+		virtual void EvaluateBatch( const Vector* points, int count, double* values, Vector* gradients ) const;
+
+		// Bound the values the function takes on over the given box.  A surface that can't do
+		// this returns false, and then nothing can be said about where its zero set is.
+		virtual bool EvaluateRange( const Aabb& aabb, Interval& range ) const;
+
+		// Subdivide the given box as an octree the given number of times, throwing out every cell
+		// over which the function can't vanish.  Every component of the surface in the box passes
+		// through one of the cells that remain, and their centers are appended to the given list
+		// as points.  This fails if the surface can't bound itself.
+		bool FindSeeds( const Aabb& aabb, int depth, Utilities::List& seedList ) const;
+
+		// Without Newton steps, every point walks down the gradient the whole way.  The work it
+		// takes is added to the given stats.
+		bool ConvergePointToSurfaceInPlane( const Plane* plane, Vector& point, double epsilon, bool useNewtonSteps, ConvergenceStats& stats ) const;
+
+		// Each point goes the way it would have gone above, but all points still converging
+		// are stepped together so that the surface is evaluated in batches.
+		void ConvergePointsToSurfaceInPlane( const Plane* plane, Vector* points, bool* converged, int count, double epsilon, bool useNewtonSteps, ConvergenceStats& stats ) const;
 
 	private:
 
+		//=============================================================================
+		// Each of these calculates the traces in one plane.  Tallies of convergence are
+		// kept per task, and are only added up once all the tasks are done.
+		class TraceTask : public ParallelInterface::Task
+		{
+		public:
+
+			TraceTask( void );
+			virtual ~TraceTask( void );
+
+			virtual void Execute( void ) override;
+
+			const Surface* surface;
+			const TraceParameters* traceParameters;
+			int index;
+			Utilities::List traceList;
+			ConvergenceStats convergenceStats;
+		};
+
+		enum { CONVERGENCE_BATCH_SIZE = 64 };
+
+		void ConvergeBatchToSurfaceInPlane( const Plane* plane, Vector* points, bool* converged, int count, double epsilon, bool useNewtonSteps, ConvergenceStats& stats ) const;
+
+		void FindSeedsInBox( const Aabb& aabb, int depth, Utilities::List& seedList ) const;
+		void FindSeedsInSquare( const CoordFrame& coordFrame, const Vector& center, double radius, int depth, Utilities::List& seedList ) const;
+
 		void CalculateTracePlane( const TraceParameters& traceParameters, int index, Plane& plane, Vector& planeCenter ) const;
-		void CalculateTracesInPlane( const Plane& plane, const Vector& center, double extent, Utilities::List& traceList ) const;
-		Trace* CalculateTraceInPlane( const Plane& plane, const Vector& seed, const Aabb& aabb ) const;
-		bool StepTraceInPlane( const Plane& plane, int direction, Vector& point, double traceDelta, double epsilon ) const;
+		void CalculateTracesInPlane( const Plane& plane, const Vector& center, double extent, Utilities::List& traceList, bool useNewtonSteps, ConvergenceStats& stats ) const;
+		Trace* CalculateTraceInPlane( const Plane& plane, const Vector& seed, const Aabb& aabb, const Utilities::List& traceList, bool useNewtonSteps, ConvergenceStats& stats ) const;
+		bool StepTraceInPlane( const Plane& plane, int direction, Vector& point, double traceDelta, double epsilon, bool useNewtonSteps, ConvergenceStats& stats ) const;
 	};
 
 	class Quadric : public Surface
@@ -92,6 +194,8 @@ namespace VectorMath
 		virtual double EvaluatePartialX( const VectorMath::Vector& point ) const;
 		virtual double EvaluatePartialY( const VectorMath::Vector& point ) const;
 		virtual double EvaluatePartialZ( const VectorMath::Vector& point ) const;
+		virtual void EvaluateBatch( const Vector* points, int count, double* values, Vector* gradients ) const;
+		virtual bool EvaluateRange( const Aabb& aabb, Interval& range ) const;
 
 		// A quadric is the set of solutions in <x,y,z>
 		// to the following equation.
@@ -112,6 +216,8 @@ namespace VectorMath
 		virtual double EvaluatePartialX( const VectorMath::Vector& point ) const;
 		virtual double EvaluatePartialY( const VectorMath::Vector& point ) const;
 		virtual double EvaluatePartialZ( const VectorMath::Vector& point ) const;
+		virtual void EvaluateBatch( const Vector* points, int count, double* values, Vector* gradients ) const;
+		virtual bool EvaluateRange( const Aabb& aabb, Interval& range ) const;
 
 		double c0, c1, c2, c3, c4;
 		double c5, c6, c7, c8, c9;
@@ -30,10 +30,7 @@ SurfaceMesh::SurfaceMesh( void )
 SurfaceMesh::GenerationParameters::GenerationParameters( void )
 {
 	// The generated surface will fit inside this box.
-	Vector center, delta;
-	Zero( center );
-	Set( delta, 10.0, 10.0, 10.0 );
-	MakeAabb( aabb, center, delta );
+	MakeDefaultAabb( aabb );
 
 	// Let's try this tolerance.
 	epsilon = 1e-7;
@@ -44,6 +41,11 @@ SurfaceMesh::GenerationParameters::GenerationParameters( void )
 	// This probably needs to be fine tuned for the situation at hand.
 	walkDistance = 0.5;
 
+	// By default, we don't adapt the walk distance to the curvature of the surface.
+	chordTolerance = 0.0;
+	minWalkDistance = 0.1;
+	maxWalkDistance = 1.5;
+
 	// Our algorithm is actually not correct, because I have run into a case where,
 	// under all constraints and logic programmed, we encounter an edge that does
 	// not connect up to the right existing vertex.
@@ -52,6 +54,9 @@ SurfaceMesh::GenerationParameters::GenerationParameters( void )
 	// This should be kept fairly small.  We're trying to account for curvature of the surface here.
 	deviationAngle = PI / 4.0;
 
+	// Seeds are found in cells a 32nd the width of the box.
+	seedDepth = 5;
+
 	// In theory, this means we can generate a mesh for a surface having up to
 	// four path connected components.
 	Set( seedList[0], -10.0, -10.0, -10.0 );
@@ -59,6 +64,8 @@ SurfaceMesh::GenerationParameters::GenerationParameters( void )
 	Set( seedList[2], 0.0, 0.0, 0.0 );
 	Set( seedList[3], 0.0, 0.0, 0.0 );
 	seedListSize = 1;
+
+	useNewtonSteps = true;
 }
 
 //=============================================================================
@@ -72,6 +79,9 @@ SurfaceMesh::Vertex::Vertex( const Vector& point )
 	Copy( this->point, point );
 	visitationKey = 0;
 	Set( normal, 1.0, 0.0, 0.0 );
+	reach = 0.0;
+	tangentOffset = 0.0;
+	nextInBucket = 0;
 }
 
 //=============================================================================
@@ -136,6 +146,7 @@ SurfaceMesh::Edge::Edge( Vertex* vertex0, Vertex* vertex1, Triangle* triangle )
 	vertex[1] = vertex1;
 
 	this->triangle = triangle;
+	nextInBucket = 0;
 }
 
 //=============================================================================
@@ -147,6 +158,12 @@ SurfaceMesh::Edge::Edge( Vertex* vertex0, Vertex* vertex1, Triangle* triangle )
 SurfaceMesh::PathConnectedComponent::PathConnectedComponent( void )
 {
 	visitationKey = 0;
+	edgeBucketArray = 0;
+	edgeBucketCount = 0;
+	edgeCount = 0;
+	vertexBucketArray = 0;
+	vertexBucketCount = 0;
+	vertexCellSize = 0.0;
 }
 
 //=============================================================================
@@ -162,6 +179,17 @@ void SurfaceMesh::PathConnectedComponent::WipeClean( void )
 	triangleList.RemoveAll( true );
 	edgeQueue.RemoveAll( true );
 	processedEdges.RemoveAll( true );
+	convergenceStats = Surface::ConvergenceStats();
+
+	delete[] edgeBucketArray;
+	edgeBucketArray = 0;
+	edgeBucketCount = 0;
+	edgeCount = 0;
+
+	delete[] vertexBucketArray;
+	vertexBucketArray = 0;
+	vertexBucketCount = 0;
+	vertexCellSize = 0.0;
 }
 
 //=============================================================================
@@ -208,6 +236,9 @@ bool SurfaceMesh::PathConnectedComponent::Generate( const Surface& surface, cons
 	// Lastly, go calculate the vertex normals so that we can get smooth shading.
 	CalculateVertexNormals();
 
+	// File the vertices so that we can quickly tell what this component covers.
+	FileVertices();
+
 	// Return success.
 	return true;
 }
@@ -258,9 +289,9 @@ bool SurfaceMesh::PathConnectedComponent::GenerateInitialTriangle( const Surface
 	AddScale( triangleVertices.vertex[2], surfacePoint, vec, genParms.walkDistance );
 
 	// Now make sure that the triangle vertices are on the surface.
-	if( !surface.ConvergePointToSurfaceInPlane( 0, triangleVertices.vertex[1], genParms.epsilon ) )
-		return false;
-	if( !surface.ConvergePointToSurfaceInPlane( 0, triangleVertices.vertex[2], genParms.epsilon ) )
+	bool converged[2];
+	surface.ConvergePointsToSurfaceInPlane( 0, &triangleVertices.vertex[1], converged, 2, genParms.epsilon, genParms.useNewtonSteps, convergenceStats );
+	if( !( converged[0] && converged[1] ) )
 		return false;
 
 	// Make sure that we're starting in bounds.
@@ -284,12 +315,9 @@ bool SurfaceMesh::PathConnectedComponent::GenerateInitialTriangle( const Surface
 	triangleList.InsertRightOf( triangleList.RightMost(), triangle );
 
 	// Add the triangle edges.
-	Edge* edge0 = new Edge( vertex0, vertex1, triangle );
-	Edge* edge1 = new Edge( vertex1, vertex2, triangle );
-	Edge* edge2 = new Edge( vertex2, vertex0, triangle );
-	edgeQueue.InsertRightOf( edgeQueue.RightMost(), edge0 );
-	edgeQueue.InsertRightOf( edgeQueue.RightMost(), edge1 );
-	edgeQueue.InsertRightOf( edgeQueue.RightMost(), edge2 );
+	AddPendingEdge( vertex0, vertex1, triangle );
+	AddPendingEdge( vertex1, vertex2, triangle );
+	AddPendingEdge( vertex2, vertex0, triangle );
 
 	// We're finished.
 	return true;
@@ -307,6 +335,59 @@ void SurfaceMesh::PathConnectedComponent::AddPendingEdge( Vertex* vertex0, Verte
 {
 	Edge* edge = new Edge( vertex0, vertex1, triangle );
 	edgeQueue.InsertRightOf( edgeQueue.RightMost(), edge );
+	FileEdge( edge );
+}
+
+//=============================================================================
+// Edges are never removed from a component until it is wiped clean, so the
+// buckets only ever have to grow.  When they do, every edge is refiled.
+void SurfaceMesh::PathConnectedComponent::FileEdge( Edge* edge )
+{
+	if( edgeCount >= edgeBucketCount )
+	{
+		Edge** oldBucketArray = edgeBucketArray;
+		int oldBucketCount = edgeBucketCount;
+
+		edgeBucketCount = oldBucketCount > 0 ? 2 * oldBucketCount : MIN_EDGE_BUCKET_COUNT;
+		edgeBucketArray = new Edge*[ edgeBucketCount ];
+		for( int bucket = 0; bucket < edgeBucketCount; bucket++ )
+			edgeBucketArray[ bucket ] = 0;
+
+		for( int oldBucket = 0; oldBucket < oldBucketCount; oldBucket++ )
+		{
+			Edge* nextEdge = 0;
+			for( Edge* oldEdge = oldBucketArray[ oldBucket ]; oldEdge; oldEdge = nextEdge )
+			{
+				nextEdge = oldEdge->nextInBucket;
+				int bucket = CalculateEdgeBucket( oldEdge->vertex[0], oldEdge->vertex[1], edgeBucketCount );
+				oldEdge->nextInBucket = edgeBucketArray[ bucket ];
+				edgeBucketArray[ bucket ] = oldEdge;
+			}
+		}
+
+		delete[] oldBucketArray;
+	}
+
+	int bucket = CalculateEdgeBucket( edge->vertex[0], edge->vertex[1], edgeBucketCount );
+	edge->nextInBucket = edgeBucketArray[ bucket ];
+	edgeBucketArray[ bucket ] = edge;
+	edgeCount++;
+}
+
+//=============================================================================
+// The vertices are ordered by address first so that both directions of an edge hash the same.
+// Their addresses are hashed as if they were the coordinates of a cell.
+/*static*/ int SurfaceMesh::PathConnectedComponent::CalculateEdgeBucket( const Vertex* vertex0, const Vertex* vertex1, int bucketCount )
+{
+	if( vertex1 < vertex0 )
+	{
+		const Vertex* vertex = vertex0;
+		vertex0 = vertex1;
+		vertex1 = vertex;
+	}
+
+	int cell[3] = { int( size_t( vertex0 ) >> 4 ), int( size_t( vertex1 ) >> 4 ), 0 };
+	return CalculateGridBucket( cell, bucketCount );
 }
 
 //=============================================================================
@@ -342,8 +423,9 @@ bool SurfaceMesh::PathConnectedComponent::GenerateNewTriangle( const Surface& su
 
 	// Do our best to find an existing vertex to connect our edge with.
 	Plane edgePlane;
+	double walkDistance = genParms.walkDistance;
 	Vertex* ccwVertex = 0, *cwVertex = 0;
-	Vertex* newVertex = FindVertexForEdge( processEdge, ccwVertex, cwVertex, edgePlane, genParms );
+	Vertex* newVertex = FindVertexForEdge( surface, processEdge, ccwVertex, cwVertex, edgePlane, walkDistance, genParms );
 
 	// If these weren't found, then something is wrong.
 	if( !( ccwVertex && cwVertex ) )
@@ -358,8 +440,8 @@ bool SurfaceMesh::PathConnectedComponent::GenerateNewTriangle( const Surface& su
 		bool pointIsAcceptable = false;
 		for( double scale = 1.0; scale > 0.1 && !pointIsAcceptable; scale *= 0.5 )
 		{
-			AddScale( point, edgeMidpoint, edgePlane.normal, genParms.walkDistance * scale );
-			if( !surface.ConvergePointToSurfaceInPlane( 0, point, genParms.epsilon ) )
+			AddScale( point, edgeMidpoint, edgePlane.normal, walkDistance * scale );
+			if( !surface.ConvergePointToSurfaceInPlane( 0, point, genParms.epsilon, genParms.useNewtonSteps, convergenceStats ) )
 				return false;
 			pointIsAcceptable = FrontierPointIsAcceptable( point, processEdge->triangle, genParms );
 		}
@@ -442,7 +524,7 @@ bool SurfaceMesh::PathConnectedComponent::FrontierPointIsAcceptable( const Vecto
 }
 
 //=============================================================================
-SurfaceMesh::Vertex* SurfaceMesh::PathConnectedComponent::FindVertexForEdge( Edge* processEdge, Vertex*& ccwVertex, Vertex*& cwVertex, Plane& edgePlane, const GenerationParameters& genParms )
+SurfaceMesh::Vertex* SurfaceMesh::PathConnectedComponent::FindVertexForEdge( const Surface& surface, Edge* processEdge, Vertex*& ccwVertex, Vertex*& cwVertex, Plane& edgePlane, double& walkDistance, const GenerationParameters& genParms )
 {
 	// We first try to find an existing vertex as the CW or CCW vertex WRT this edge.
 	Vertex* foundVertex = 0;
@@ -451,6 +533,7 @@ SurfaceMesh::Vertex* SurfaceMesh::PathConnectedComponent::FindVertexForEdge( Edg
 	if( !( ccwVertex && cwVertex ) )
 		return 0;
 	processEdge->MakeEdgePlane( edgePlane );
+	walkDistance = CalculateWalkDistance( surface, processEdge, edgePlane, genParms );
 	if( Plane::SIDE_FRONT == PlaneSide( edgePlane, ccwVertex->point, genParms.epsilon ) &&
 		CalculateInteriorAngle( processEdge->vertex[0], processEdge->vertex[1], ccwVertex ) < genParms.frontierAngle )
 	{
@@ -502,13 +585,86 @@ SurfaceMesh::Vertex* SurfaceMesh::PathConnectedComponent::FindVertexForEdge( Edg
 			}
 		}
 
-		if( likelyVertex && minimumDistance <= genParms.walkDistance * 1.1 )
+		if( likelyVertex && minimumDistance <= walkDistance * 1.1 )
 			foundVertex = likelyVertex;
 	}
 
 	return foundVertex;
 }
 
+//=============================================================================
+// A chord of length h across a curve of curvature k strays about k h^2 / 8 from the
+// curve, which tells us how far we can walk for the given tolerance.  The curvature
+// along the edge comes from how much the normal turns between its vertices, and the
+// curvature across it, from how much the normal turns between the edge and a probe
+// one walk distance out.  We're as careful as the more curved of the two.  Steps are
+// also kept short enough that the triangles they make don't turn more than half the
+// deviation angle, and they don't change too abruptly from the length of the edge.
+/*static*/ double SurfaceMesh::PathConnectedComponent::CalculateWalkDistance( const Surface& surface, const Edge* processEdge, const Plane& edgePlane, const GenerationParameters& genParms )
+{
+	if( genParms.chordTolerance <= 0.0 )
+		return genParms.walkDistance;
+
+	Vector edgeVector;
+	Sub( edgeVector, processEdge->vertex[1]->point, processEdge->vertex[0]->point );
+	double edgeLength = Length( edgeVector );
+
+	Vector probePoint[3];
+	Copy( probePoint[0], processEdge->vertex[0]->point );
+	Copy( probePoint[1], processEdge->vertex[1]->point );
+	Lerp( probePoint[2], probePoint[0], probePoint[1], 0.5 );
+	AddScale( probePoint[2], probePoint[2], edgePlane.normal, genParms.walkDistance );
+
+	double value[3];
+	Vector normal[3];
+	surface.EvaluateBatch( probePoint, 3, value, normal );
+	for( int index = 0; index < 3; index++ )
+	{
+		if( Dot( normal[ index ], normal[ index ] ) == 0.0 )
+			return genParms.minWalkDistance;
+		Normalize( normal[ index ], normal[ index ] );
+	}
+
+	double curvature = 0.0;
+	if( edgeLength > 0.0 )
+		curvature = AngleBetween( normal[0], normal[1] ) / edgeLength;
+
+	Vector edgeNormal, normalChange;
+	Add( edgeNormal, normal[0], normal[1] );
+	Normalize( edgeNormal, edgeNormal );
+	Sub( normalChange, normal[2], edgeNormal );
+	double crossCurvature = fabs( Dot( normalChange, edgePlane.normal ) ) / genParms.walkDistance;
+	if( crossCurvature > curvature )
+		curvature = crossCurvature;
+
+	double walkDistance = genParms.maxWalkDistance;
+	if( curvature > 0.0 )
+	{
+		double chordDistance = sqrt( 8.0 * genParms.chordTolerance / curvature );
+		if( chordDistance < walkDistance )
+			walkDistance = chordDistance;
+
+		double angleDistance = 0.5 * genParms.deviationAngle / curvature;
+		if( angleDistance < walkDistance )
+			walkDistance = angleDistance;
+	}
+
+	if( edgeLength > 0.0 )
+	{
+		if( walkDistance > 1.5 * edgeLength )
+			walkDistance = 1.5 * edgeLength;
+		else if( walkDistance < 0.5 * edgeLength )
+			walkDistance = 0.5 * edgeLength;
+	}
+
+	if( walkDistance < genParms.minWalkDistance )
+		walkDistance = genParms.minWalkDistance;
+	else if( walkDistance > genParms.maxWalkDistance )
+		walkDistance = genParms.maxWalkDistance;
+
+	return walkDistance;
+}
+
 //=============================================================================
 /*static*/ double SurfaceMesh::PathConnectedComponent::CalculateInteriorAngle( Vertex* vertex0, Vertex* vertex1, Vertex* vertex2 )
 {
@@ -541,14 +697,15 @@ void SurfaceMesh::Triangle::PatchAdjacencies( void )
 }
 
 //=============================================================================
-// Here we search both the process pending edge list and the processed edges list.
+// Here we find the edge whether it is still pending or has already been processed.
 SurfaceMesh::Edge* SurfaceMesh::PathConnectedComponent::FindEdge( Vertex* vertex0, Vertex* vertex1 )
 {
+	if( !edgeBucketArray )
+		return 0;
+
 	Edge* foundEdge = 0;
-	for( Edge* edge = ( Edge* )edgeQueue.LeftMost(); edge && !foundEdge; edge = ( Edge* )edge->Right() )
-		if( ( edge->vertex[0] == vertex0 && edge->vertex[1] == vertex1 ) || ( edge->vertex[0] == vertex1 && edge->vertex[1] == vertex0 ) )
-			foundEdge = edge;
-	for( Edge* edge = ( Edge* )processedEdges.LeftMost(); edge && !foundEdge; edge = ( Edge* )edge->Right() )
+	int bucket = CalculateEdgeBucket( vertex0, vertex1, edgeBucketCount );
+	for( Edge* edge = edgeBucketArray[ bucket ]; edge && !foundEdge; edge = edge->nextInBucket )
 		if( ( edge->vertex[0] == vertex0 && edge->vertex[1] == vertex1 ) || ( edge->vertex[0] == vertex1 && edge->vertex[1] == vertex0 ) )
 			foundEdge = edge;
 	return foundEdge;
@@ -644,9 +801,124 @@ bool SurfaceMesh::IsPointOnSurface( const Vector& point, double epsilon ) const
 }
 
 //=============================================================================
+// The triangles at a vertex reach no farther from it than its longest edge, so a point
+// of the surface the component covers is within that of its closest vertex, and no farther
+// from the plane tangent to the component there than the surface bends away from it over
+// that distance.  Off the edge of the mesh, the same holds of points within about a step
+// of the vertices on its periphery.  A nearby sheet of another component is farther off.
 bool SurfaceMesh::PathConnectedComponent::IsPointOnSurface( const Vector& point, double epsilon ) const
 {
-	return false;
+	if( !vertexBucketArray )
+		return false;
+
+	// A closest vertex any farther than the cells are wide can't reach the point.
+	double searchRadius = epsilon > vertexCellSize ? epsilon : vertexCellSize;
+	Vector delta, corner;
+	Set( delta, searchRadius, searchRadius, searchRadius );
+	int minCell[3], maxCell[3];
+	Sub( corner, point, delta );
+	CalculateGridCell( corner, vertexCellSize, minCell );
+	Add( corner, point, delta );
+	CalculateGridCell( corner, vertexCellSize, maxCell );
+
+	const Vertex* closestVertex = 0;
+	double closestSquareDistance = searchRadius * searchRadius;
+
+	int cell[3];
+	for( cell[0] = minCell[0]; cell[0] <= maxCell[0]; cell[0]++ )
+	{
+		for( cell[1] = minCell[1]; cell[1] <= maxCell[1]; cell[1]++ )
+		{
+			for( cell[2] = minCell[2]; cell[2] <= maxCell[2]; cell[2]++ )
+			{
+				// Different cells can share a bucket, but that only costs us a few extra distance checks.
+				int bucket = CalculateGridBucket( cell, vertexBucketCount );
+				for( const Vertex* vertex = vertexBucketArray[ bucket ]; vertex; vertex = vertex->nextInBucket )
+				{
+					Sub( delta, point, vertex->point );
+					double squareDistance = Dot( delta, delta );
+					if( squareDistance <= closestSquareDistance )
+					{
+						closestSquareDistance = squareDistance;
+						closestVertex = vertex;
+					}
+				}
+			}
+		}
+	}
+
+	if( !closestVertex )
+		return false;
+
+	if( closestSquareDistance <= epsilon * epsilon )
+		return true;
+
+	if( closestSquareDistance > closestVertex->reach * closestVertex->reach )
+		return false;
+
+	Sub( delta, point, closestVertex->point );
+	return fabs( Dot( delta, closestVertex->normal ) ) <= epsilon + closestVertex->tangentOffset;
+}
+
+//=============================================================================
+void SurfaceMesh::PathConnectedComponent::FileVertices( void )
+{
+	delete[] vertexBucketArray;
+	vertexBucketArray = 0;
+	vertexBucketCount = 0;
+	vertexCellSize = 0.0;
+
+	for( Vertex* vertex = ( Vertex* )vertexList.LeftMost(); vertex; vertex = ( Vertex* )vertex->Right() )
+	{
+		vertex->reach = 0.0;
+		vertex->tangentOffset = 0.0;
+	}
+
+	for( const Triangle* triangle = ( const Triangle* )triangleList.LeftMost(); triangle; triangle = ( const Triangle* )triangle->Right() )
+	{
+		for( int index = 0; index < 3; index++ )
+		{
+			Vertex* vertex0 = triangle->vertex[ index ];
+			Vertex* vertex1 = triangle->vertex[ ( index + 1 ) % 3 ];
+			Vector edgeVector;
+			Sub( edgeVector, vertex1->point, vertex0->point );
+			double edgeLength = Length( edgeVector );
+			if( edgeLength > vertex0->reach )
+				vertex0->reach = edgeLength;
+			if( edgeLength > vertex1->reach )
+				vertex1->reach = edgeLength;
+			if( edgeLength > vertexCellSize )
+				vertexCellSize = edgeLength;
+
+			// The normal of a vertex with only one or two triangles can lie along the plane of
+			// its edges, so each edge is measured against the tangent planes at both its ends.
+			double tangentOffset = fabs( Dot( edgeVector, vertex0->normal ) );
+			double otherTangentOffset = fabs( Dot( edgeVector, vertex1->normal ) );
+			if( otherTangentOffset > tangentOffset )
+				tangentOffset = otherTangentOffset;
+			if( tangentOffset > vertex0->tangentOffset )
+				vertex0->tangentOffset = tangentOffset;
+			if( tangentOffset > vertex1->tangentOffset )
+				vertex1->tangentOffset = tangentOffset;
+		}
+	}
+
+	if( vertexCellSize <= 0.0 )
+		return;
+
+	vertexBucketCount = 2 * vertexList.Count() + 1;
+	vertexBucketArray = new Vertex*[ vertexBucketCount ];
+	for( int bucket = 0; bucket < vertexBucketCount; bucket++ )
+		vertexBucketArray[ bucket ] = 0;
+
+	for( Vertex* vertex = ( Vertex* )vertexList.LeftMost(); vertex; vertex = ( Vertex* )vertex->Right() )
+	{
+		int cell[3];
+		CalculateGridCell( vertex->point, vertexCellSize, cell );
+		int bucket = CalculateGridBucket( cell, vertexBucketCount );
+		vertex->nextInBucket = vertexBucketArray[ bucket ];
+		vertexBucketArray[ bucket ] = vertex;
+	}
 }
 
 //=============================================================================
@@ -654,17 +926,39 @@ bool SurfaceMesh::Generate( const Surface& surface, const GenerationParameters&
 {
 	// Begin with a blank slate.
 	componentList.RemoveAll( true );
+	convergenceStats = Surface::ConvergenceStats();
+
+	Utilities::List seedList;
+	if( genParms.seedDepth <= 0 || !surface.FindSeeds( genParms.aabb, genParms.seedDepth, seedList ) )
+	{
+		for( int index = 0; index < genParms.seedListSize; index++ )
+			seedList.InsertRightOf( seedList.RightMost(), new Surface::Point( genParms.seedList[ index ] ) );
+	}
 
-	// Given each given seed a try.
-	for( int index = 0; index < genParms.seedListSize; index++ )
+	// Where a seed converges to doesn't depend on the components, so all of them are converged
+	// together up front, which lets the surface be evaluated in batches.  A cell a component
+	// passes through can still hold another component, so no seed is passed over until we
+	// know where it converged.
+	int seedCount = seedList.Count();
+	Vector* seedArray = new Vector[ seedCount ];
+	bool* converged = new bool[ seedCount ];
+
+	int index = 0;
+	for( const Surface::Point* seed = ( const Surface::Point* )seedList.LeftMost(); seed; seed = ( const Surface::Point* )seed->Right() )
+		Copy( seedArray[ index++ ], seed->point );
+
+	surface.ConvergePointsToSurfaceInPlane( 0, seedArray, converged, seedCount, genParms.epsilon, genParms.useNewtonSteps, convergenceStats );
+
+	// Given each seed a try.
+	bool success = true;
+	for( index = 0; index < seedCount && success; index++ )
 	{
-		// Try to converge this seed point to the surface.  If it does
-		// not converge, skip the point.
-		Vector surfacePoint;
-		Copy( surfacePoint, genParms.seedList[ index ] );
-		if( !surface.ConvergePointToSurfaceInPlane( 0, surfacePoint, genParms.epsilon ) )
+		// If the seed did not converge to the surface, skip the point.
+		if( !converged[ index ] )
 			continue;
 
+		const Vector& surfacePoint = seedArray[ index ];
+
 		// If the surface point found is already on an existing component,
 		// then skip the point, because we don't want to regenerate that component.
 		if( IsPointOnSurface( surfacePoint, genParms.epsilon ) )
@@ -672,11 +966,15 @@ bool SurfaceMesh::Generate( const Surface& surface, const GenerationParameters&
 
 		// Try to generate the component.  Did we succeed?
 		PathConnectedComponent* component = new PathConnectedComponent();
-		if( !component->Generate( surface, surfacePoint, genParms, progressInterface ) )
+		bool generated = component->Generate( surface, surfacePoint, genParms, progressInterface );
+		convergenceStats.Accumulate( component->convergenceStats );
+		if( !generated )
 		{
-			// No.  Delete the component and return failure.
+			// No.  If we couldn't even start the component, as happens when the seed is too
+			// close to the edge of the box, another seed may yet find it.  Otherwise, fail.
+			if( component->triangleList.Count() > 0 )
+				success = false;
 			delete component;
-			return false;
 		}
 		else
 		{
@@ -685,8 +983,18 @@ bool SurfaceMesh::Generate( const Surface& surface, const GenerationParameters&
 		}
 	}
 
-	// Return success.
-	return true;
+	delete[] seedArray;
+	delete[] converged;
+
+	seedList.RemoveAll( true );
+
+	return success;
+}
+
+//=============================================================================
+void SurfaceMesh::GetConvergenceStats( Surface::ConvergenceStats& stats ) const
+{
+	stats = convergenceStats;
 }
 
 //=============================================================================
@@ -63,11 +63,18 @@ namespace VectorMath
 			int maxIterations;
 
 			// This is how far we walk out into the tangent space of an edge
-			// or point to build upon the partially generated mesh.  It would
-			// be nice if we could do an adaptive step-size that is sensative
-			// to the amount of curvature in the surface as any given point.
+			// or point to build upon the partially generated mesh.
 			double walkDistance;
 
+			// Given a positive chord tolerance, the step we take off of an edge is
+			// sensitive to the curvature of the surface there.  It is as long as it
+			// can be without the surface straying farther than the tolerance from the
+			// triangle it makes, but within the given bounds.  Otherwise, every step
+			// is the walk distance above.
+			double chordTolerance;
+			double minWalkDistance;
+			double maxWalkDistance;
+
 			// This is the maximum angle at which two adjacent edges can be
 			// incident and we'll still connect a triangle on these edges.
 			double frontierAngle;
@@ -77,12 +84,18 @@ namespace VectorMath
 			double deviationAngle;
 
 			// We try to find all the different components of the mesh by converging
-			// different seed points to the surface of the given surface.  This is
-			// not a very smart way to do it, but until I can think of something better,
-			// this will have to do.
+			// different seed points to the surface of the given surface.  If the surface
+			// can bound itself, the seeds are found by subdividing the box this many
+			// times, and every component of the surface is found.  Otherwise, or if this
+			// is zero, we fall back on the seeds given here.
+			int seedDepth;
+
 			enum { MAX_SEEDS = 4 };
 			Vector seedList[ MAX_SEEDS ];
 			int seedListSize;
+
+			// This says whether points are converged to the surface with Newton steps.
+			bool useNewtonSteps;
 		};
 
 		//=============================================================================
@@ -101,6 +114,14 @@ namespace VectorMath
 
 			// This is used to get smooth shading of the surface.
 			Vector normal;
+
+			// This is the length of the longest edge at this vertex, and the farthest that
+			// any of its edges strays from the plane tangent to either end of it.
+			double reach;
+			double tangentOffset;
+
+			// This chains together the vertices filed under the same bucket of their component.
+			Vertex* nextInBucket;
 		};
 
 		//=============================================================================
@@ -162,6 +183,9 @@ namespace VectorMath
 			// part of the final mesh.  Edges are only used to mark the periphery
 			// of the partially generated mesh.
 			Triangle* triangle;
+
+			// This chains together the edges filed under the same bucket of their component.
+			Edge* nextInBucket;
 		};
 
 		//=============================================================================
@@ -189,18 +213,40 @@ namespace VectorMath
 			bool GenerateNewTriangle( const Surface& surface, const GenerationParameters& genParms );
 			Edge* FindEdge( Vertex* vertex0, Vertex* vertex1 );
 			static double CalculateInteriorAngle( Vertex* vertex0, Vertex* vertex1, Vertex* vertex2 );
-			Vertex* FindVertexForEdge( Edge* processEdge, Vertex*& ccwVertex, Vertex*& cwVertex, Plane& edgePlane, const GenerationParameters& genParms );
+			Vertex* FindVertexForEdge( const Surface& surface, Edge* processEdge, Vertex*& ccwVertex, Vertex*& cwVertex, Plane& edgePlane, double& walkDistance, const GenerationParameters& genParms );
+			static double CalculateWalkDistance( const Surface& surface, const Edge* processEdge, const Plane& edgePlane, const GenerationParameters& genParms );
 			void EdgeProcessed( Edge* edge );
 			bool FrontierPointIsAcceptable( const Vector& point, Triangle* triangle, const GenerationParameters& genParms );
 			bool FrontierPointIsAcceptable( const Vector& point, const Vector& normal, Triangle* triangle, const GenerationParameters& genParms );
 			void CalculateVertexNormals( void );
 			void AddPendingEdge( Vertex* vertex0, Vertex* vertex1, Triangle* triangle );
+			void FileEdge( Edge* edge );
+			static int CalculateEdgeBucket( const Vertex* vertex0, const Vertex* vertex1, int bucketCount );
+			void FileVertices( void );
 
 			Utilities::List vertexList;
 			Utilities::List triangleList;
 			Utilities::List edgeQueue;
 			Utilities::List processedEdges;
 			int visitationKey;
+
+			// This is the work it took to converge the points of the component.
+			Surface::ConvergenceStats convergenceStats;
+
+			// Every edge, pending or processed, is filed here under its pair of vertices, taken
+			// in either order, so that finding an edge doesn't mean searching both lists.  There
+			// are always at least as many buckets as edges.
+			enum { MIN_EDGE_BUCKET_COUNT = 256 };
+			Edge** edgeBucketArray;
+			int edgeBucketCount;
+			int edgeCount;
+
+			// Once the component is generated, its vertices are filed in a spatial hash whose
+			// cells are as wide as its longest edge, so that telling whether a point is on the
+			// component only means looking at the vertices around the point.
+			Vertex** vertexBucketArray;
+			int vertexBucketCount;
+			double vertexCellSize;
 		};
 
 		// Tell us if the given point is on any current component of the surface.
@@ -209,6 +255,9 @@ namespace VectorMath
 		// Generate all components of the given surface.
 		bool Generate( const Surface& surface, const GenerationParameters& genParms, ProgressInterface* progressInterface = 0 );
 
+		// Copy out the work it took to converge points during the last generation.
+		void GetConvergenceStats( Surface::ConvergenceStats& stats ) const;
+
 		// Provide what might be a convenient way to render the mesh.
 		void Render( RenderInterface& renderInterface, const Vector& color, double alpha, bool forDebug = false ) const;
 
@@ -216,6 +265,8 @@ namespace VectorMath
 
 		// Keep a list of all path-connected components of the surface.
 		Utilities::List componentList;
+
+		Surface::ConvergenceStats convergenceStats;
 	};
 }
 
@@ -297,4 +297,19 @@ void VectorMath::LinearCombo( Vector& dst, double scalar0, const Vector& src0, d
 	dst.z = scalar0 * src0.z + scalar1 * src1.z + scalar2 * src2.z;
 }
 
+//=============================================================================
+void VectorMath::CalculateGridCell( const Vector& point, double cellSize, int* cell )
+{
+	cell[0] = int( floor( point.x / cellSize ) );
+	cell[1] = int( floor( point.y / cellSize ) );
+	cell[2] = int( floor( point.z / cellSize ) );
+}
+
+//=============================================================================
+int VectorMath::CalculateGridBucket( const int* cell, int bucketCount )
+{
+	unsigned int hash = unsigned( cell[0] ) * 73856093u ^ unsigned( cell[1] ) * 19349663u ^ unsigned( cell[2] ) * 83492791u;
+	return int( hash % unsigned( bucketCount ) );
+}
+
 // Vector.cpp
\ No newline at end of file
@@ -13,6 +13,12 @@
 
 #define PI		3.1415926536
 
+// SSE2 is always there on x64, and is there on x86 when the compiler is told to use it.
+#if defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 ) || defined( __SSE2__ )
+#	define VECTORMATH_SSE2
+#	include <emmintrin.h>
+#endif
+
 // Provide basic vector math support.
 namespace VectorMath
 {
@@ -44,6 +50,10 @@ namespace VectorMath
 	void Reject( Vector& dst, const Vector& src, const Vector& unitVector );
 	void LinearCombo( Vector& dst, double scalar0, const Vector& src0, double scalar1, const Vector& src1 );
 	void LinearCombo( Vector& dst, double scalar0, const Vector& src0, double scalar1, const Vector& src1, double scalar2, const Vector& src2 );
+
+	// Points are filed in a uniform grid by the cells they fall in, and the cells in a hash by these.
+	void CalculateGridCell( const Vector& point, double cellSize, int* cell );
+	int CalculateGridBucket( const int* cell, int bucketCount );
 }
 
 // Vector.h
\ No newline at end of file
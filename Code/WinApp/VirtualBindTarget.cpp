@@ -10,10 +10,14 @@
  */
 
 #include "VirtualBindTarget.h"
+#include "FunctionRegistry.h"
 
 //=========================================================================================
 IMPLEMENT_CALCLIB_CLASS1( GAVisToolVirtualBindTarget, GAVisToolBindTarget );
 
+//=========================================================================================
+static GAVisToolFunctionRegistry::Registrar bindVirtualRegistrar( "bind_virtual", &GAVisToolVirtualBindTarget::Create, GAVisToolBindTarget::DOESNT_MATTER );
+
 //=========================================================================================
 GAVisToolVirtualBindTarget::GAVisToolVirtualBindTarget( BindType bindType ) : GAVisToolBindTarget( bindType )
 {
@@ -33,6 +37,7 @@ GAVisToolVirtualBindTarget::GAVisToolVirtualBindTarget( BindType bindType ) : GA
 //=========================================================================================
 /*virtual*/ void GAVisToolVirtualBindTarget::DecomposeFrom( const GeometricAlgebra::SumOfBlades& element )
 {
+	Modified();
 	this->element.AssignSumOfBlades( element );
 }
 
@@ -45,6 +45,7 @@
 #include <wx/stattext.h>
 #include <wx/treectrl.h>
 #include <wx/progdlg.h>
+#include <wx/thread.h>
 
 // This is cheating.
 extern "C" HINSTANCE wxGetInstance();